@@ -0,0 +1,274 @@
+/***************************************************************************************
+// Keyframe and delta frame animation player, see Animation.h
+***************************************************************************************/
+
+/***************************************************************************************
+** Function name:           TFT_eAnimation
+** Description:             Class constructor
+***************************************************************************************/
+TFT_eAnimation::TFT_eAnimation(TFT_eSPI *tft)
+{
+  _tft  = tft;
+  _spr  = nullptr;
+
+  _data = nullptr;
+  _next = nullptr;
+
+  _x = 0;
+  _y = 0;
+
+  _width  = 0;
+  _height = 0;
+  _frames = 0;
+  _frame  = 0;
+  _period = 0;
+  _lastTime = 0;
+
+  _loop    = true;
+  _running = false;
+}
+
+
+/***************************************************************************************
+** Function name:           setAnimation
+** Description:             Set the animation data, returns false if not valid
+***************************************************************************************/
+bool TFT_eAnimation::setAnimation(const uint16_t *data)
+{
+  _data    = nullptr;
+  _running = false;
+
+  if (data == nullptr || pgm_read_word(data) != ANIM_MAGIC) return false;
+
+  _width  = pgm_read_word(data + 1);
+  _height = pgm_read_word(data + 2);
+  _frames = pgm_read_word(data + 3);
+  _period = pgm_read_word(data + 4);
+
+  if (_frames == 0) return false;
+
+  _data = data;
+  restart();
+
+  return true;
+}
+
+
+/***************************************************************************************
+** Function name:           setTarget
+** Description:             Draw the animation on the TFT
+***************************************************************************************/
+void TFT_eAnimation::setTarget(TFT_eSPI *tft)
+{
+  _tft = tft;
+  _spr = nullptr;
+}
+
+
+/***************************************************************************************
+** Function name:           setTarget
+** Description:             Draw the animation in a Sprite
+***************************************************************************************/
+void TFT_eAnimation::setTarget(TFT_eSprite *spr)
+{
+  _spr = spr;
+}
+
+
+/***************************************************************************************
+** Function name:           setPosition
+** Description:             Set the top left corner position on the target
+***************************************************************************************/
+void TFT_eAnimation::setPosition(int32_t x, int32_t y)
+{
+  _x = x;
+  _y = y;
+}
+
+
+/***************************************************************************************
+** Function name:           setFramePeriod
+** Description:             Set the time between frames in milliseconds
+***************************************************************************************/
+void TFT_eAnimation::setFramePeriod(uint16_t ms)
+{
+  _period = ms;
+}
+
+
+/***************************************************************************************
+** Function name:           setLoop
+** Description:             Repeat the animation when the end is reached
+***************************************************************************************/
+void TFT_eAnimation::setLoop(bool loop)
+{
+  _loop = loop;
+}
+
+
+/***************************************************************************************
+** Function name:           start
+** Description:             Start timed playback, first frame is drawn by next update()
+***************************************************************************************/
+void TFT_eAnimation::start(void)
+{
+  if (_data == nullptr) return;
+
+  _running  = true;
+  _lastTime = millis() - _period;
+}
+
+
+/***************************************************************************************
+** Function name:           stop
+** Description:             Stop timed playback
+***************************************************************************************/
+void TFT_eAnimation::stop(void)
+{
+  _running = false;
+}
+
+
+/***************************************************************************************
+** Function name:           update
+** Description:             Draw the next frame if it is due, returns true if drawn
+***************************************************************************************/
+bool TFT_eAnimation::update(void)
+{
+  if (!_running) return false;
+
+  uint32_t now = millis();
+  if ((now - _lastTime) < _period) return false;
+
+  // Keep a fixed frame rate, but re-synchronise if more than a frame late
+  _lastTime += _period;
+  if ((now - _lastTime) >= _period) _lastTime = now;
+
+  if (!drawFrame())
+  {
+    _running = false;
+    return false;
+  }
+
+  return true;
+}
+
+
+/***************************************************************************************
+** Function name:           drawFrame
+** Description:             Draw the next frame, returns false if the animation has ended
+***************************************************************************************/
+bool TFT_eAnimation::drawFrame(void)
+{
+  if (_data == nullptr) return false;
+
+  if (_frame >= _frames)
+  {
+    if (!_loop) return false;
+    restart();
+  }
+
+  // Sprite class inherits TFT_eSPI so the fill functions are common
+  TFT_eSPI *dst = _spr ? (TFT_eSPI*)_spr : _tft;
+
+  // Pixel values are RGB565 so swap to the order the target needs
+  bool oldSwapBytes = dst->getSwapBytes();
+  dst->setSwapBytes(true);
+
+  // Hold CS low for the whole frame
+  if (!_spr) _tft->startWrite();
+
+  const uint16_t *ptr = _next;
+  uint16_t spans = pgm_read_word(ptr++);
+
+  while (spans--)
+  {
+    int32_t  y = _y + pgm_read_word(ptr++);
+    int32_t  x = _x + pgm_read_word(ptr++);
+    uint16_t n = pgm_read_word(ptr++);
+
+    if (n & ANIM_FILL_SPAN)
+    {
+      n &= ~ANIM_FILL_SPAN;
+      dst->drawFastHLine(x, y, n, pgm_read_word(ptr++));
+    }
+    else
+    {
+      if (_spr) _spr->pushImage(x, y, n, 1, ptr);
+      else      _tft->pushImage(x, y, n, 1, ptr);
+      ptr += n;
+    }
+  }
+
+  if (!_spr) _tft->endWrite();
+
+  dst->setSwapBytes(oldSwapBytes);
+
+  _next = ptr;
+  _frame++;
+
+  return true;
+}
+
+
+/***************************************************************************************
+** Function name:           restart
+** Description:             Return to the keyframe
+***************************************************************************************/
+void TFT_eAnimation::restart(void)
+{
+  if (_data == nullptr) return;
+
+  _frame = 0;
+  _next  = _data + ANIM_HEADER_SIZE;
+}
+
+
+/***************************************************************************************
+** Function name:           running
+** Description:             Returns true while timed playback is running
+***************************************************************************************/
+bool TFT_eAnimation::running(void)
+{
+  return _running;
+}
+
+
+/***************************************************************************************
+** Function name:           width
+** Description:             Return the animation width
+***************************************************************************************/
+uint16_t TFT_eAnimation::width(void)
+{
+  return _width;
+}
+
+
+/***************************************************************************************
+** Function name:           height
+** Description:             Return the animation height
+***************************************************************************************/
+uint16_t TFT_eAnimation::height(void)
+{
+  return _height;
+}
+
+
+/***************************************************************************************
+** Function name:           frames
+** Description:             Return the number of frames
+***************************************************************************************/
+uint16_t TFT_eAnimation::frames(void)
+{
+  return _frames;
+}
+
+
+/***************************************************************************************
+** Function name:           frame
+** Description:             Return the index of the next frame to be drawn
+***************************************************************************************/
+uint16_t TFT_eAnimation::frame(void)
+{
+  return _frame;
+}
@@ -0,0 +1,85 @@
+/***************************************************************************************
+// The following class plays an animation stored as a keyframe followed by delta frames.
+// Each frame holds only the horizontal spans of pixels that differ from the previous
+// frame, spans of one colour are stored as a single fill value. The frames are drawn
+// directly to the TFT or into a Sprite at a fixed frame rate.
+//
+// Animation data is an array of 16-bit words in FLASH (PROGMEM) or RAM:
+//
+//   Header:  0x4E41 ("AN"), width, height, frame count, frame period in milliseconds
+//   Frame:   span count, then for each span:
+//              y, x, n          Span position relative to the animation origin
+//              n pixel values   if bit 15 of n is 0, n is the pixel count
+//              1 fill colour    if bit 15 of n is 1, bits 14-0 are the pixel count
+//
+// Pixel values are RGB565. The first frame must set every pixel (keyframe), the
+// Tools/Create_animation script generates the array from a sequence of images.
+***************************************************************************************/
+
+#define ANIM_MAGIC       0x4E41
+#define ANIM_HEADER_SIZE 5      // Header size in 16-bit words
+#define ANIM_FILL_SPAN   0x8000 // Span count flag for a single colour span
+
+class TFT_eAnimation {
+
+ public:
+
+  explicit TFT_eAnimation(TFT_eSPI *tft);
+
+           // Set the animation data, returns false if the header is not valid
+  bool     setAnimation(const uint16_t *data);
+
+           // Draw to the TFT (default) or into a Sprite
+  void     setTarget(TFT_eSPI *tft);
+  void     setTarget(TFT_eSprite *spr);
+
+           // Position of the animation top left corner on the target
+  void     setPosition(int32_t x, int32_t y);
+
+           // Change the frame period (default is from the animation header)
+  void     setFramePeriod(uint16_t ms);
+
+           // Repeat the animation from the keyframe when the last frame has been drawn
+  void     setLoop(bool loop);
+
+           // Start or stop timed playback with update()
+  void     start(void);
+  void     stop(void);
+
+           // Call frequently from the sketch loop, draws the next frame when it is due
+           // Returns true if a frame was drawn
+  bool     update(void);
+
+           // Draw the next frame now, returns false if the animation has ended
+  bool     drawFrame(void);
+
+           // Return to the keyframe, the next frame drawn will redraw the whole area
+  void     restart(void);
+
+           // Returns true while playback is running
+  bool     running(void);
+
+           // Animation information
+  uint16_t width(void);
+  uint16_t height(void);
+  uint16_t frames(void);    // Number of frames
+  uint16_t frame(void);     // Index of the next frame to be drawn
+
+ private:
+
+  TFT_eSPI       *_tft;      // TFT target
+  TFT_eSprite    *_spr;      // Sprite target, nullptr if drawing to the TFT
+
+  const uint16_t *_data;     // Animation data
+  const uint16_t *_next;     // Data for the next frame
+
+  int32_t  _x, _y;           // Position on target
+  uint16_t _width, _height;  // Animation size
+  uint16_t _frames;          // Frame count
+  uint16_t _frame;           // Next frame index
+  uint16_t _period;          // Frame period in ms
+  uint32_t _lastTime;        // Time the last frame was due
+
+  bool     _loop;            // Repeat animation
+  bool     _running;         // Timed playback enabled
+};
@@ -0,0 +1,256 @@
+/***************************************************************************************
+// Dual core band renderer, see Band_render.h
+***************************************************************************************/
+
+/***************************************************************************************
+** Function name:           TFT_eBandRender
+** Description:             Class constructor
+***************************************************************************************/
+TFT_eBandRender::TFT_eBandRender(TFT_eSPI *tft) : _band0(tft), _band1(tft)
+{
+  _tft = tft;
+
+#if defined (ESP32)
+  _task = nullptr;
+#endif
+
+  _width   = 0;
+  _height  = 0;
+  _started = false;
+  _worker  = false;
+
+  _head    = 0;
+  _tail    = 0;
+  _sending = false;
+  _stop    = false;
+}
+
+
+/***************************************************************************************
+** Function name:           ~TFT_eBandRender
+** Description:             Class destructor
+***************************************************************************************/
+TFT_eBandRender::~TFT_eBandRender(void)
+{
+  end();
+}
+
+
+/***************************************************************************************
+** Function name:           begin
+** Description:             Create the band Sprites and start the transfer worker
+***************************************************************************************/
+bool TFT_eBandRender::begin(int16_t width, int16_t height, bool worker)
+{
+  if (_started) end();
+
+  // Internal RAM is faster to render into and can be read by DMA
+  _band0.setAttribute(PSRAM_ENABLE, false);
+  _band1.setAttribute(PSRAM_ENABLE, false);
+  _band0.setColorDepth(16);
+  _band1.setColorDepth(16);
+
+  if (_band0.createSprite(width, height) == nullptr) return false;
+  if (_band1.createSprite(width, height) == nullptr) {
+    _band0.deleteSprite();
+    return false;
+  }
+
+  _width   = width;
+  _height  = height;
+  _head    = 0;
+  _tail    = 0;
+  _sending = false;
+  _stop    = false;
+
+  _slot[0].buffer = (uint16_t*)_band0.getPointer();
+  _slot[1].buffer = (uint16_t*)_band1.getPointer();
+
+  _worker = false;
+
+#if defined (ESP32) && (portNUM_PROCESSORS > 1)
+  if (worker) {
+    // Run the transfer task on the core that is not rendering
+    BaseType_t core = xPortGetCoreID() ? 0 : 1;
+    _worker = xTaskCreatePinnedToCore(workerTask, "TFT_eBand", 4096, this, 1, &_task, core) == pdPASS;
+  }
+#elif defined (ARDUINO_ARCH_RP2040) && !defined (ARDUINO_ARCH_MBED)
+  // The sketch calls service() from loop1()
+  _worker = worker;
+#else
+  worker = worker; // Stop unused parameter warning
+#endif
+
+  _started = true;
+  return true;
+}
+
+
+/***************************************************************************************
+** Function name:           end
+** Description:             Stop the worker and delete the Sprites
+***************************************************************************************/
+void TFT_eBandRender::end(void)
+{
+  if (!_started) return;
+
+  flush();
+
+#if defined (ESP32)
+  if (_task) {
+    // The task deletes itself when it sees the stop flag
+    _stop = true;
+    xTaskNotifyGive(_task);
+    while (_task) delay(1);
+  }
+#endif
+
+  _band0.deleteSprite();
+  _band1.deleteSprite();
+
+  _worker  = false;
+  _started = false;
+}
+
+
+/***************************************************************************************
+** Function name:           getBand
+** Description:             Get the next free band Sprite
+***************************************************************************************/
+TFT_eSprite* TFT_eBandRender::getBand(int32_t x, int32_t y)
+{
+  if (!_started) return nullptr;
+
+  // Wait until the band has been sent
+  while (_head - _tail >= BAND_BUFFERS) yield();
+
+  uint8_t i = _head % BAND_BUFFERS;
+
+  _slot[i].x = x;
+  _slot[i].y = y;
+
+  return i ? &_band1 : &_band0;
+}
+
+
+/***************************************************************************************
+** Function name:           pushBand
+** Description:             Add the band to the queue
+***************************************************************************************/
+void TFT_eBandRender::pushBand(void)
+{
+  if (!_started) return;
+
+  // Band pixels and position must be visible to the other core before the index
+  __sync_synchronize();
+  _head = _head + 1;
+
+  if (!_worker) {
+    service();
+    return;
+  }
+
+#if defined (ESP32)
+  xTaskNotifyGive(_task);
+#endif
+}
+
+
+/***************************************************************************************
+** Function name:           flush
+** Description:             Wait until the queue is empty and the TFT bus is released
+***************************************************************************************/
+void TFT_eBandRender::flush(void)
+{
+  while (busy()) yield();
+}
+
+
+/***************************************************************************************
+** Function name:           busy
+** Description:             Returns true if bands are queued or being sent
+***************************************************************************************/
+bool TFT_eBandRender::busy(void)
+{
+  // _sending is set before the first band is taken and cleared after endWrite()
+  if (_tail != _head) return true;
+  __sync_synchronize();
+  return _sending;
+}
+
+
+/***************************************************************************************
+** Function name:           service
+** Description:             Send the queued bands
+***************************************************************************************/
+uint16_t TFT_eBandRender::service(void)
+{
+  if (!_started || (_tail == _head)) return 0;
+
+  uint16_t count = 0;
+
+  _sending = true;
+  __sync_synchronize();
+
+  // Hold the bus for the whole burst of bands
+  _tft->startWrite();
+
+  // Sprite pixels are already in the TFT byte order
+  bool swap = _tft->getSwapBytes();
+  _tft->setSwapBytes(false);
+
+  while (_tail != _head) {
+    uint8_t i = _tail % BAND_BUFFERS;
+
+#if defined (ESP32_DMA) || defined (RP2040_DMA) || defined (STM32_DMA)
+    if (_tft->DMA_Enabled) {
+      _tft->pushImageDMA(_slot[i].x, _slot[i].y, _width, _height, _slot[i].buffer);
+      _tft->dmaWait(); // Band can be re-used when the DMA is complete
+    }
+    else
+#endif
+    _tft->pushImage(_slot[i].x, _slot[i].y, _width, _height, _slot[i].buffer);
+
+    __sync_synchronize();
+    _tail = _tail + 1;
+    count++;
+  }
+
+  _tft->setSwapBytes(swap);
+  _tft->endWrite();
+
+  __sync_synchronize();
+  _sending = false;
+
+  return count;
+}
+
+
+/***************************************************************************************
+** Function name:           worker
+** Description:             Returns true if the bands are sent by the other core
+***************************************************************************************/
+bool TFT_eBandRender::worker(void)
+{
+  return _worker;
+}
+
+
+#if defined (ESP32)
+/***************************************************************************************
+** Function name:           workerTask
+** Description:             ESP32 task that sends the bands when notified
+***************************************************************************************/
+void TFT_eBandRender::workerTask(void *param)
+{
+  TFT_eBandRender *render = (TFT_eBandRender*)param;
+
+  while (!render->_stop) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    render->service();
+  }
+
+  render->_task = nullptr;
+  vTaskDelete(nullptr);
+}
+#endif
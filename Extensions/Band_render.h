@@ -0,0 +1,78 @@
+/***************************************************************************************
+// The following class splits rendering and transfer of a screen between the two cores
+// of an ESP32 or RP2040. The sketch renders the screen as a series of bands (e.g. 240
+// x 40 pixels) into a pair of 16 bit Sprites. Each finished band is added to a single
+// producer, single consumer queue and the other core pushes it to the TFT, with DMA
+// if initDMA() has been called. The next band is rendered while the last one is sent.
+//
+// On the ESP32 begin() creates a task on the other core to send the bands. On the
+// RP2040 the sketch calls service() from loop1(). On other processors, or if worker
+// is false, pushBand() sends the band before it returns.
+//
+// While bands are queued the transfer core owns the TFT bus: startWrite() is called
+// at the start of a burst of bands and endWrite() when the queue is empty. The sketch
+// must call flush() before it draws directly to the TFT.
+***************************************************************************************/
+
+#define BAND_BUFFERS 2 // Number of band Sprites (queue length)
+
+class TFT_eBandRender {
+
+ public:
+
+  explicit TFT_eBandRender(TFT_eSPI *tft);
+  ~TFT_eBandRender(void);
+
+           // Create the band Sprites of width x height pixels, the bands are sent by the
+           // other core if worker is true. Returns false if the Sprites cannot be created.
+  bool     begin(int16_t width, int16_t height, bool worker = true);
+
+           // Wait for queued bands to be sent, stop the worker and delete the Sprites
+  void     end(void);
+
+           // Get the next free band Sprite, this waits until the band has been sent. The
+           // band will be drawn with its top left corner at x,y on the TFT. Graphics are
+           // drawn in the band with coordinates relative to the band.
+  TFT_eSprite* getBand(int32_t x, int32_t y);
+
+           // Add the band returned by getBand() to the queue
+  void     pushBand(void);
+
+           // Wait until all queued bands have been sent and the TFT bus is released
+  void     flush(void);
+
+           // Returns true if bands are queued or being sent
+  bool     busy(void);
+
+           // Send the queued bands, called by the transfer core. Returns the number of
+           // bands sent.
+  uint16_t service(void);
+
+           // Returns true if the bands are sent by the other core
+  bool     worker(void);
+
+ private:
+
+#if defined (ESP32)
+  static void workerTask(void *param); // ESP32 transfer task
+  TaskHandle_t _task;
+#endif
+
+  TFT_eSPI    *_tft;
+  TFT_eSprite  _band0, _band1;
+
+  struct {
+    int32_t   x, y;                 // Position on the TFT
+    uint16_t *buffer;               // Band pixels
+  } _slot[BAND_BUFFERS];
+
+  int16_t  _width, _height;         // Band size
+  bool     _started;                // Sprites created
+  bool     _worker;                 // Bands are sent by the other core
+
+  // Queue indexes, only the producer writes _head and only the consumer writes _tail
+  volatile uint32_t _head;          // Bands added by pushBand()
+  volatile uint32_t _tail;          // Bands sent
+  volatile bool     _sending;       // Consumer holds the TFT bus
+  volatile bool     _stop;          // Stop the ESP32 worker task
+};
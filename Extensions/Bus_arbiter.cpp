@@ -0,0 +1,217 @@
+/***************************************************************************************
+// Shared SPI bus arbiter, see Bus_arbiter.h
+***************************************************************************************/
+
+#if defined (ESP32)
+
+/***************************************************************************************
+** Function name:           TFT_eBus
+** Description:             Class constructor
+***************************************************************************************/
+TFT_eBus::TFT_eBus(void)
+{
+  _mutex        = nullptr;
+  _owner        = nullptr;
+  _depth        = 0;
+  _waiting      = 0;
+  _basePriority = 0;
+  _boosted      = false;
+  _defer        = false;
+  _deferTFT     = nullptr;
+
+  for (uint8_t i = 0; i < BUS_DEVICES; i++) _priority[i] = 0;
+}
+
+
+/***************************************************************************************
+** Function name:           ~TFT_eBus
+** Description:             Class destructor
+***************************************************************************************/
+TFT_eBus::~TFT_eBus(void)
+{
+  end();
+}
+
+
+/***************************************************************************************
+** Function name:           begin
+** Description:             Create the bus mutex
+***************************************************************************************/
+bool TFT_eBus::begin(void)
+{
+  if (_mutex == nullptr) _mutex = xSemaphoreCreateRecursiveMutex();
+  return _mutex != nullptr;
+}
+
+
+/***************************************************************************************
+** Function name:           end
+** Description:             Delete the bus mutex
+***************************************************************************************/
+void TFT_eBus::end(void)
+{
+  if (_mutex == nullptr) return;
+
+  vSemaphoreDelete(_mutex);
+  _mutex    = nullptr;
+  _owner    = nullptr;
+  _depth    = 0;
+  _deferTFT = nullptr;
+}
+
+
+/***************************************************************************************
+** Function name:           acquire
+** Description:             Take the bus for a device
+***************************************************************************************/
+bool TFT_eBus::acquire(uint8_t device, uint32_t timeout)
+{
+  if (_mutex == nullptr) return true;
+
+  TaskHandle_t task = xTaskGetCurrentTaskHandle();
+
+  // A TFT transaction left open must be closed before the bus is used again, this
+  // may give the bus back
+  if (_owner == task && _deferTFT) _deferTFT->releaseBus();
+
+  if (_owner == task) {
+    // Nested call, the mutex keeps a count and is always available to the owner
+    xSemaphoreTakeRecursive(_mutex, 0);
+    _depth++;
+  }
+  else {
+    TickType_t ticks = (timeout == 0xFFFFFFFF) ? portMAX_DELAY : pdMS_TO_TICKS(timeout);
+    UBaseType_t priority = uxTaskPriorityGet(nullptr);
+
+    __atomic_add_fetch(&_waiting, 1, __ATOMIC_RELAXED);
+    bool taken = xSemaphoreTakeRecursive(_mutex, ticks) == pdTRUE;
+    __atomic_sub_fetch(&_waiting, 1, __ATOMIC_RELAXED);
+
+    if (!taken) return false;
+
+    _owner        = task;
+    _depth        = 1;
+    _basePriority = priority;
+    _boosted      = false;
+  }
+
+  if (device < BUS_DEVICES && _priority[device] > uxTaskPriorityGet(nullptr)) {
+    vTaskPrioritySet(nullptr, _priority[device]);
+    _boosted = true;
+  }
+
+  return true;
+}
+
+
+/***************************************************************************************
+** Function name:           release
+** Description:             Give the bus back
+***************************************************************************************/
+void TFT_eBus::release(uint8_t device)
+{
+  if (_mutex == nullptr || _owner != xTaskGetCurrentTaskHandle()) return;
+
+  device = device; // Stop unused parameter warning
+
+  if (--_depth == 0) {
+    _owner    = nullptr;
+    _deferTFT = nullptr;
+    if (_boosted) {
+      _boosted = false;
+      vTaskPrioritySet(nullptr, _basePriority);
+    }
+  }
+
+  xSemaphoreGiveRecursive(_mutex);
+}
+
+
+/***************************************************************************************
+** Function name:           setPriority
+** Description:             Set the priority ceiling of a device
+***************************************************************************************/
+void TFT_eBus::setPriority(uint8_t device, uint8_t priority)
+{
+  if (device >= BUS_DEVICES) return;
+  if (priority >= configMAX_PRIORITIES) priority = configMAX_PRIORITIES - 1;
+  _priority[device] = priority;
+}
+
+
+/***************************************************************************************
+** Function name:           setDeferredRelease
+** Description:             Keep TFT transactions open while no other task is waiting
+***************************************************************************************/
+void TFT_eBus::setDeferredRelease(bool defer)
+{
+  _defer = defer;
+}
+
+
+/***************************************************************************************
+** Function name:           owned
+** Description:             Returns true if the calling task owns the bus
+***************************************************************************************/
+bool TFT_eBus::owned(void)
+{
+  return _owner != nullptr && _owner == xTaskGetCurrentTaskHandle();
+}
+
+
+/***************************************************************************************
+** Function name:           waiting
+** Description:             Returns the number of tasks waiting for the bus
+***************************************************************************************/
+uint32_t TFT_eBus::waiting(void)
+{
+  return __atomic_load_n(&_waiting, __ATOMIC_RELAXED);
+}
+
+
+/***************************************************************************************
+** Function name:           deferRelease
+** Description:             Returns true if the TFT can keep its transaction open
+***************************************************************************************/
+// Called by the owner at the end of a TFT transaction, the bus stays acquired
+bool TFT_eBus::deferRelease(TFT_eSPI *tft)
+{
+  if (!_defer || waiting() || !owned()) return false;
+
+  _deferTFT = tft;
+  return true;
+}
+
+
+/***************************************************************************************
+** Function name:           deferred
+** Description:             Returns true if the TFT has an open transaction to close
+***************************************************************************************/
+// Only the owning task can close the transaction
+bool TFT_eBus::deferred(TFT_eSPI *tft)
+{
+  return _deferTFT == tft && owned();
+}
+
+
+/***************************************************************************************
+** Function name:           yieldDue
+** Description:             Returns true if an open TFT transaction should be closed
+***************************************************************************************/
+bool TFT_eBus::yieldDue(TFT_eSPI *tft)
+{
+  if (_deferTFT != tft) return false;
+  return (waiting() || !_defer) && owned();
+}
+
+
+/***************************************************************************************
+** Function name:           clearDeferred
+** Description:             Called by the TFT when it closes the open transaction
+***************************************************************************************/
+void TFT_eBus::clearDeferred(void)
+{
+  _deferTFT = nullptr;
+}
+
+#endif
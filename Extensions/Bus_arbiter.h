@@ -0,0 +1,99 @@
+/***************************************************************************************
+// The following class arbitrates a SPI bus that is shared by the TFT, the touch
+// controller and other devices such as an SD card, when the devices are used by more
+// than one FreeRTOS task (ESP32 only).
+//
+// A task takes the bus with acquire() and gives it back with release(). The bus is
+// guarded by a recursive FreeRTOS mutex, so the owning task can nest calls and a batch
+// of transfers can be grouped in one acquire()/release() pair without re-locking. The
+// mutex gives priority inheritance, a device can also be given a priority ceiling so
+// the task holding the bus for that device runs at least at that priority.
+//
+// A TFT attached with tft.setBus(&bus) acquires the bus when it starts a transaction
+// and releases it when the transaction ends. The touch functions do the same. Wrap
+// SD card access in acquire(BUS_SD) and release(BUS_SD).
+//
+// With setDeferredRelease(true) the TFT keeps its transaction open at the end of a
+// graphics call if no other task is waiting for the bus, so a task making many calls
+// does not re-lock the bus for each one. The transaction is closed by the next call to
+// the TFT when another task is waiting, by acquire() for any device from the same task
+// or by tft.releaseBus(). Call tft.releaseBus() before the task blocks for a long time.
+// With deferred release ALL users of the bus must use acquire() and release().
+***************************************************************************************/
+
+// Device numbers
+#define BUS_TFT     0
+#define BUS_TOUCH   1
+#define BUS_SD      2
+#define BUS_USER    3 // First device number free for sketch use
+#define BUS_DEVICES 8
+
+#if defined (ESP32)
+
+class TFT_eBus {
+
+ public:
+
+  TFT_eBus(void);
+  ~TFT_eBus(void);
+
+           // Create the mutex, returns false if it cannot be created
+  bool     begin(void);
+
+           // Delete the mutex, the bus must not be in use
+  void     end(void);
+
+           // Take the bus for a device, waits up to timeout ms. Returns false if the bus
+           // was not free before the timeout. Calls can be nested by the owning task.
+  bool     acquire(uint8_t device, uint32_t timeout = 0xFFFFFFFF);
+
+           // Give the bus back, must be called once for each successful acquire()
+  void     release(uint8_t device);
+
+           // Set the FreeRTOS priority ceiling of a device, 0 = none
+  void     setPriority(uint8_t device, uint8_t priority);
+
+           // Keep TFT transactions open while no other task is waiting, see above
+  void     setDeferredRelease(bool defer);
+
+           // Returns true if the calling task owns the bus
+  bool     owned(void);
+
+           // Returns the number of tasks waiting for the bus
+  uint32_t waiting(void);
+
+           // Used by TFT_eSPI to manage a deferred release
+  bool     deferRelease(TFT_eSPI *tft);   // true if tft may keep its transaction open
+  bool     deferred(TFT_eSPI *tft);       // true if tft has an open transaction to close
+  bool     yieldDue(TFT_eSPI *tft);       // true if the open transaction should be closed
+  void     clearDeferred(void);
+
+ private:
+
+  SemaphoreHandle_t _mutex;             // Recursive mutex
+  TaskHandle_t _owner;                  // Task holding the bus
+  uint32_t     _depth;                  // Nesting count of the owner
+  volatile uint32_t _waiting;           // Tasks blocked in acquire()
+  UBaseType_t  _basePriority;           // Owner priority before a ceiling was applied
+  bool         _boosted;                // Owner priority has been raised
+  uint8_t      _priority[BUS_DEVICES];  // Device priority ceilings
+  bool         _defer;                  // Deferred release enabled
+  TFT_eSPI    *_deferTFT;               // TFT with an open transaction
+};
+
+// Bus hooks used by the TFT_eSPI transaction functions
+#define BUS_ACQUIRE(D)     if (_bus) _bus->acquire(D)
+#define BUS_RELEASE(D)     if (_bus) _bus->release(D)
+#define BUS_KEEP_OPEN      (_bus && _bus->deferRelease(this))
+#define BUS_YIELD          if (_bus && _bus->yieldDue(this)) releaseBus()
+#define BUS_CLOSE_DEFERRED if (_bus && _bus->deferred(this)) releaseBus()
+
+#else
+
+#define BUS_ACQUIRE(D)
+#define BUS_RELEASE(D)
+#define BUS_KEEP_OPEN      false
+#define BUS_YIELD
+#define BUS_CLOSE_DEFERRED
+
+#endif
@@ -0,0 +1,113 @@
+/***************************************************************************************
+// Smooth font handle, see Font.h
+// The storeFont() and loadFont(TFT_eFont*) functions are in Smooth_font.cpp
+***************************************************************************************/
+
+/***************************************************************************************
+** Function name:           TFT_eFont
+** Description:             Class constructor
+***************************************************************************************/
+TFT_eFont::TFT_eFont(void)
+{
+  _loaded = false;
+
+  gFont = { nullptr, 0, 0, 0, 0, 0, 0, 0 };
+
+  gUnicode   = NULL;
+  gHeight    = NULL;
+  gWidth     = NULL;
+  gxAdvance  = NULL;
+  gdY        = NULL;
+  gdX        = NULL;
+  gBitmap    = NULL;
+  gFormat    = NULL;
+  gBitmapEnd = 0;
+  gSorted    = false;
+  gStatic    = false;
+  gMapped    = false;
+  gMap       = nullptr;
+
+  gKern      = nullptr;
+  gLig       = nullptr;
+  gKernCount = 0;
+  gLigCount  = 0;
+  gExtTable  = NULL;
+
+#ifdef FONT_FS_AVAILABLE
+  spiffs  = true;
+  fs_font = false;
+#endif
+}
+
+
+/***************************************************************************************
+** Function name:           ~TFT_eFont
+** Description:             Class destructor
+***************************************************************************************/
+TFT_eFont::~TFT_eFont(void)
+{
+  unloadFont();
+}
+
+
+/***************************************************************************************
+** Function name:           unloadFont
+** Description:             Free the font memory and close any font file
+***************************************************************************************/
+void TFT_eFont::unloadFont(void)
+{
+  if (!_loaded) return;
+
+  // Compiled font tables and fonts read in place have no metric arrays to free
+  if (!gStatic)
+  {
+    if (gUnicode)  free(gUnicode);
+    if (gHeight)   free(gHeight);
+    if (gWidth)    free(gWidth);
+    if (gxAdvance) free(gxAdvance);
+    if (gdY)       free(gdY);
+    if (gdX)       free(gdX);
+    if (gBitmap)   free(gBitmap);
+    if (gFormat)   free(gFormat);
+  }
+  if (gExtTable) free(gExtTable);
+
+#ifdef FONT_FS_AVAILABLE
+  if (fs_font && fontFile) fontFile.close();
+  fs_font = false;
+#endif
+
+  gUnicode  = NULL;
+  gHeight   = NULL;
+  gWidth    = NULL;
+  gxAdvance = NULL;
+  gdY       = NULL;
+  gdX       = NULL;
+  gBitmap   = NULL;
+  gFormat   = NULL;
+  gExtTable = NULL;
+  gKern     = nullptr;
+  gLig      = nullptr;
+  gMap      = nullptr;
+
+  gKernCount = 0;
+  gLigCount  = 0;
+  gStatic    = false;
+  gMapped    = false;
+  gSorted    = false;
+
+  gFont.gArray = nullptr;
+  gFont.gCount = 0;
+
+  _loaded = false;
+}
+
+
+/***************************************************************************************
+** Function name:           loaded
+** Description:             Returns true if a font is stored in the handle
+***************************************************************************************/
+bool TFT_eFont::loaded(void)
+{
+  return _loaded;
+}
@@ -0,0 +1,60 @@
+/***************************************************************************************
+// The following class holds a smooth font that has been loaded, so several fonts can be
+// resident at the same time. The font is loaded into the TFT (or a Sprite) as normal,
+// then TFT_eSPI::storeFont() moves the metrics into the handle:
+//
+//   TFT_eFont small, large;
+//   tft.loadFont(NotoSansBold15); tft.storeFont(&small);
+//   tft.loadFont(NotoSansBold36); tft.storeFont(&large);
+//
+// tft.loadFont(&small) then selects the font by copying a few pointers, the font data
+// is not parsed again. A handle can be selected by any number of TFT_eSPI and
+// TFT_eSprite instances. unloadFont() in a TFT or Sprite only deselects the handle.
+// The handle must not be unloaded or deleted while a TFT or Sprite is using it.
+***************************************************************************************/
+
+class TFT_eFont { friend class TFT_eSPI; // TFT_eSPI stores and selects the font
+
+ public:
+
+  TFT_eFont(void);
+  ~TFT_eFont(void);
+
+           // Free the font memory and close any font file
+  void     unloadFont(void);
+
+           // Returns true if a font is stored in the handle
+  bool     loaded(void);
+
+ private:
+
+  bool     _loaded;                  // A font is stored
+
+  // Font metrics and tables moved from TFT_eSPI, see Smooth_font.h
+  TFT_eSPI::fontMetrics gFont;
+  uint16_t* gUnicode;
+  uint8_t*  gHeight;
+  uint8_t*  gWidth;
+  uint8_t*  gxAdvance;
+  int16_t*  gdY;
+  int8_t*   gdX;
+  uint32_t* gBitmap;
+  uint8_t*  gFormat;
+  uint32_t  gBitmapEnd;
+  bool      gSorted;
+  bool      gStatic;
+  bool      gMapped;
+  const uint8_t* gMap;
+
+  const uint8_t* gKern;
+  const uint8_t* gLig;
+  uint16_t  gKernCount;
+  uint16_t  gLigCount;
+  uint8_t*  gExtTable;
+
+#ifdef FONT_FS_AVAILABLE
+  fs::File  fontFile;
+  bool      spiffs;
+  bool      fs_font;
+#endif
+};
@@ -0,0 +1,468 @@
+/***************************************************************************************
+// Multi panel scheduler, see Multi_TFT.h
+***************************************************************************************/
+
+#ifdef MULTI_TFT_DMA
+
+// Chip select pin driven low by the SPI driver callback, -1 if none
+static volatile int8_t multiCS = -1;
+
+/***************************************************************************************
+** Function name:           multi_callback
+** Description:             Select the panel and set the DC line before a transaction
+***************************************************************************************/
+// The transaction user field holds the DC state in bit 0 and the CS pin in bits 1-7
+static void IRAM_ATTR multi_callback(spi_transaction_t *spi_tx)
+{
+  uint32_t user = (uint32_t)(uintptr_t)spi_tx->user;
+  int8_t cs = user >> 1;
+
+  if (cs != multiCS) {
+    if (multiCS >= 0) gpio_ll_set_level(&GPIO, (gpio_num_t)multiCS, 1);
+    gpio_ll_set_level(&GPIO, (gpio_num_t)cs, 0);
+    multiCS = cs;
+  }
+
+  if (user & 1) {DC_D;}
+  else {DC_C;}
+}
+
+
+/***************************************************************************************
+** Function name:           TFT_eMulti
+** Description:             Class constructor
+***************************************************************************************/
+TFT_eMulti::TFT_eMulti(TFT_eSPI *tft)
+{
+  _tft      = tft;
+  _dev      = nullptr;
+  _panels   = 0;
+  _selected = -1;
+  _next     = 0;
+  _index    = 0;
+  _busy     = 0;
+}
+
+
+/***************************************************************************************
+** Function name:           ~TFT_eMulti
+** Description:             Class destructor
+***************************************************************************************/
+TFT_eMulti::~TFT_eMulti(void)
+{
+  end();
+}
+
+
+/***************************************************************************************
+** Function name:           begin
+** Description:             Add the SPI driver device used for the panels
+***************************************************************************************/
+bool TFT_eMulti::begin(void)
+{
+  if (_dev) return true;
+
+  // The bus is initialised for DMA by initDMA()
+  if (!_tft->DMA_Enabled) return false;
+
+  // Chip selects are driven by multi_callback()
+  spi_device_interface_config_t devcfg = {
+    .command_bits = 0,
+    .address_bits = 0,
+    .dummy_bits = 0,
+    .mode = TFT_SPI_MODE,
+    .duty_cycle_pos = 0,
+    .cs_ena_pretrans = 0,
+    .cs_ena_posttrans = 0,
+    .clock_speed_hz = (int)_tft->getSPIWriteFrequency(),
+    .input_delay_ns = 0,
+    .spics_io_num = -1,
+    .flags = SPI_DEVICE_NO_DUMMY,
+    .queue_size = MULTI_QUEUE_SIZE,
+    .pre_cb = multi_callback,
+    #if defined (CONFIG_IDF_TARGET_ESP32) || defined (CONFIG_IDF_TARGET_ESP32C3)
+      .post_cb = 0
+    #else
+      .post_cb = dma_end_callback
+    #endif
+  };
+
+  if (spi_bus_add_device(spi_host, &devcfg, &_dev) != ESP_OK) {
+    _dev = nullptr;
+    return false;
+  }
+
+  _index = 0;
+  _busy  = 0;
+  return true;
+}
+
+
+/***************************************************************************************
+** Function name:           end
+** Description:             Wait for queued frames and remove the SPI driver device
+***************************************************************************************/
+void TFT_eMulti::end(void)
+{
+  if (_dev == nullptr) return;
+
+  deselect();
+  wait();
+  releaseCS();
+
+  spi_bus_remove_device(_dev);
+  _dev = nullptr;
+}
+
+
+/***************************************************************************************
+** Function name:           addPanel
+** Description:             Add a panel, returns the panel number or -1
+***************************************************************************************/
+int8_t TFT_eMulti::addPanel(int8_t cs)
+{
+  if (_panels >= MULTI_PANELS || cs < 0) return -1;
+
+  pinMode(cs, OUTPUT);
+  digitalWrite(cs, HIGH);
+
+  multi_panel_t &pn = _panel[_panels];
+  pn.cs       = cs;
+  pn.head     = 0;
+  pn.count    = 0;
+  pn.queued   = 0;
+  pn.sent     = 0;
+  pn.addr_row = 0xFFFF;
+  pn.addr_col = 0xFFFF;
+  pn.x0 = pn.y0 = pn.x1 = pn.y1 = -1;
+
+  return _panels++;
+}
+
+
+/***************************************************************************************
+** Function name:           pushFrame
+** Description:             Queue a frame for a panel
+***************************************************************************************/
+bool TFT_eMulti::pushFrame(uint8_t panel, int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t* data)
+{
+  if (panel >= _panels || data == nullptr) return false;
+
+  // The SPI driver would copy a frame in PSRAM or one not on a 4 byte boundary
+  if (!esp_ptr_dma_capable(data) || ((uintptr_t)data & 3)) return false;
+
+  if ((x < 0) || (y < 0) || (w < 1) || (h < 1) ||
+      (x + w > _tft->width()) || (y + h > _tft->height())) return false;
+
+  multi_panel_t &pn = _panel[panel];
+  if (pn.count >= MULTI_FRAMES) return false;
+
+  multi_frame_t &f = pn.frame[(pn.head + pn.count) % MULTI_FRAMES];
+  f.data = data;
+  f.x = x;
+  f.y = y;
+  f.w = w;
+  f.h = h;
+  pn.count++;
+
+  // Start sending if the bus is idle
+  update();
+
+  return true;
+}
+
+
+/***************************************************************************************
+** Function name:           update
+** Description:             Feed queued frames to the SPI driver
+***************************************************************************************/
+bool TFT_eMulti::update(void)
+{
+  if (_dev == nullptr) return false;
+
+  collect(false);
+
+  // Frames are held while a panel is selected for CPU drawing
+  if (_selected < 0 && _panels) {
+    // Take a chunk from each panel in turn until the driver queue is full
+    bool fed = true;
+    while (fed) {
+      fed = false;
+      for (uint8_t i = 0; i < _panels; i++) {
+        if (feed((_next + i) % _panels)) fed = true;
+      }
+    }
+    if (++_next >= _panels) _next = 0;
+  }
+
+  bool pending = false;
+  for (uint8_t p = 0; p < _panels; p++) if (_panel[p].count) pending = true;
+
+  // Free the bus for other devices when the queue is empty
+  if (_busy == 0) releaseCS();
+
+  return pending;
+}
+
+
+/***************************************************************************************
+** Function name:           busy
+** Description:             Returns true if a frame for the panel has not been sent
+***************************************************************************************/
+bool TFT_eMulti::busy(uint8_t panel)
+{
+  if (panel >= _panels) return false;
+
+  update();
+
+  return _panel[panel].count > 0;
+}
+
+
+/***************************************************************************************
+** Function name:           wait
+** Description:             Wait until all queued frames have been sent
+***************************************************************************************/
+void TFT_eMulti::wait(void)
+{
+  while (_selected < 0 && update()) collect(true);
+}
+
+
+/***************************************************************************************
+** Function name:           select
+** Description:             Select a panel for CPU drawing
+***************************************************************************************/
+void TFT_eMulti::select(uint8_t panel)
+{
+  if (panel >= _panels) return;
+
+  deselect();
+  wait();
+  releaseCS();
+
+  // Restore the drawPixel() window cache of this panel
+  _tft->addr_row = _panel[panel].addr_row;
+  _tft->addr_col = _panel[panel].addr_col;
+
+  digitalWrite(_panel[panel].cs, LOW);
+  _selected = panel;
+}
+
+
+/***************************************************************************************
+** Function name:           deselect
+** Description:             End CPU drawing to the selected panel
+***************************************************************************************/
+void TFT_eMulti::deselect(void)
+{
+  if (_selected < 0) return;
+
+  multi_panel_t &pn = _panel[_selected];
+
+  // Keep the drawPixel() window cache, the window may have been changed by the CPU
+  pn.addr_row = _tft->addr_row;
+  pn.addr_col = _tft->addr_col;
+  invalidate(_selected);
+
+  _tft->addr_row = 0xFFFF;
+  _tft->addr_col = 0xFFFF;
+
+  digitalWrite(pn.cs, HIGH);
+  _selected = -1;
+}
+
+
+/***************************************************************************************
+** Function name:           invalidate
+** Description:             Forget the window sent to a panel
+***************************************************************************************/
+void TFT_eMulti::invalidate(uint8_t panel)
+{
+  if (panel >= _panels) return;
+
+  multi_panel_t &pn = _panel[panel];
+  pn.x0 = pn.y0 = pn.x1 = pn.y1 = -1;
+}
+
+
+/***************************************************************************************
+** Function name:           panels
+** Description:             Returns the number of panels
+***************************************************************************************/
+uint8_t TFT_eMulti::panels(void)
+{
+  return _panels;
+}
+
+
+/***************************************************************************************
+** Function name:           feed
+** Description:             Queue the next chunk of pixels for a panel
+***************************************************************************************/
+// Returns false if the panel has nothing to send or the driver queue is full
+bool TFT_eMulti::feed(uint8_t p)
+{
+  multi_panel_t &pn = _panel[p];
+
+  if (pn.queued >= pn.count) return false;
+
+  // A new frame needs up to 5 transactions for the window
+  if (MULTI_QUEUE_SIZE - _busy < (pn.sent ? 1 : 6)) return false;
+
+  multi_frame_t &f = pn.frame[(pn.head + pn.queued) % MULTI_FRAMES];
+  uint32_t len = f.w * f.h;
+
+  if (pn.sent == 0) queueWindow(p, f.x, f.y, f.w, f.h);
+
+  uint32_t n = len - pn.sent;
+  if (n > MULTI_CHUNK) n = MULTI_CHUNK;
+
+  bool last = (pn.sent + n == len);
+  queuePixels(p, f.data + pn.sent, n, last);
+
+  if (last) {
+    pn.sent = 0;
+    pn.queued++;
+  }
+  else pn.sent += n;
+
+  return true;
+}
+
+
+/***************************************************************************************
+** Function name:           queueWindow
+** Description:             Queue the window commands that differ from the last frame
+***************************************************************************************/
+void TFT_eMulti::queueWindow(uint8_t p, int32_t x, int32_t y, int32_t w, int32_t h)
+{
+  multi_panel_t &pn = _panel[p];
+
+  int32_t x0 = x, y0 = y, x1 = x + w - 1, y1 = y + h - 1;
+
+  #ifdef CGRAM_OFFSET
+    x0+=_tft->colstart;
+    x1+=_tft->colstart;
+    y0+=_tft->rowstart;
+    y1+=_tft->rowstart;
+  #endif
+
+  if ((x0 != pn.x0) || (x1 != pn.x1)) {
+    queueBytes(p, false, TFT_CASET, 1);
+    queueBytes(p, true,  (uint32_t)x0 << 16 | x1, 4);
+    pn.x0 = x0;
+    pn.x1 = x1;
+  }
+
+  if ((y0 != pn.y0) || (y1 != pn.y1)) {
+    queueBytes(p, false, TFT_PASET, 1);
+    queueBytes(p, true,  (uint32_t)y0 << 16 | y1, 4);
+    pn.y0 = y0;
+    pn.y1 = y1;
+  }
+
+  queueBytes(p, false, TFT_RAMWR, 1);
+
+  // The drawPixel() window cache of the panel is no longer valid
+  pn.addr_row = 0xFFFF;
+  pn.addr_col = 0xFFFF;
+}
+
+
+/***************************************************************************************
+** Function name:           queueBytes
+** Description:             Queue up to 4 command or data bytes for a panel
+***************************************************************************************/
+void TFT_eMulti::queueBytes(uint8_t p, bool dc, uint32_t data, uint8_t bytes)
+{
+  spi_transaction_t *trans = nextTrans(p, false);
+
+  trans->user = (void *)(uintptr_t)(dc | (_panel[p].cs << 1));
+  trans->flags = SPI_TRANS_USE_TXDATA;
+  trans->length = bytes * 8;
+  for (uint8_t i = 0; i < bytes; i++) trans->tx_data[i] = data >> (8 * (bytes - 1 - i));
+
+  esp_err_t ret = spi_device_queue_trans(_dev, trans, portMAX_DELAY);
+  assert(ret == ESP_OK);
+
+  _busy++;
+}
+
+
+/***************************************************************************************
+** Function name:           queuePixels
+** Description:             Queue a block of pixels for a panel
+***************************************************************************************/
+void TFT_eMulti::queuePixels(uint8_t p, const uint16_t* data, uint32_t len, bool last)
+{
+  spi_transaction_t *trans = nextTrans(p, last);
+
+  trans->user = (void *)(uintptr_t)(1 | (_panel[p].cs << 1));
+  trans->tx_buffer = data;
+  trans->length = len * 16;
+
+  esp_err_t ret = spi_device_queue_trans(_dev, trans, portMAX_DELAY);
+  assert(ret == ESP_OK);
+
+  _busy++;
+}
+
+
+/***************************************************************************************
+** Function name:           nextTrans
+** Description:             Get the next transaction in the ring
+***************************************************************************************/
+// The caller checks there is a free transaction, results are collected in queue order
+spi_transaction_t* TFT_eMulti::nextTrans(uint8_t p, bool last)
+{
+  spi_transaction_t *trans = &_trans[_index];
+  _last[_index] = last ? p + 1 : 0;
+  if (++_index >= MULTI_QUEUE_SIZE) _index = 0;
+
+  memset(trans, 0, sizeof(spi_transaction_t));
+
+  return trans;
+}
+
+
+/***************************************************************************************
+** Function name:           collect
+** Description:             Collect sent transactions, release sent frames
+***************************************************************************************/
+// If block is true this waits for at least one transaction
+void TFT_eMulti::collect(bool block)
+{
+  spi_transaction_t *rtrans;
+  TickType_t ticks = block ? portMAX_DELAY : 0;
+
+  while (_busy) {
+    if (spi_device_get_trans_result(_dev, &rtrans, ticks) != ESP_OK) break;
+    ticks = 0;
+    _busy--;
+
+    uint8_t last = _last[rtrans - _trans];
+    if (last) {
+      multi_panel_t &pn = _panel[last - 1];
+      if (++pn.head >= MULTI_FRAMES) pn.head = 0;
+      pn.count--;
+      pn.queued--;
+    }
+  }
+}
+
+
+/***************************************************************************************
+** Function name:           releaseCS
+** Description:             Raise the chip select left low by the callback
+***************************************************************************************/
+// Only called when no transactions are queued
+void TFT_eMulti::releaseCS(void)
+{
+  if (multiCS < 0) return;
+
+  digitalWrite(multiCS, HIGH);
+  multiCS = -1;
+}
+
+#endif
@@ -0,0 +1,126 @@
+/***************************************************************************************
+// The following class drives several displays of the same type that share one SPI bus,
+// each with its own chip select pin (ESP32 with SPI DMA only). TFT_CS must not be
+// defined in the setup file.
+//
+// Frames are queued per panel with pushFrame() and returned to the sketch when sent.
+// update() feeds the SPI driver queue, taking a chunk of pixels from each panel with a
+// queued frame in turn, so transfers to all the panels are interleaved and the bus is
+// kept busy while the CPU renders the next frames. The chip select of a panel is driven
+// by the SPI driver callback and is only changed when the next transfer is for another
+// panel, the panel controller continues the RAM write when it is selected again.
+//
+// The address window last sent to each panel is remembered, so a frame with the same
+// window as the last frame to that panel only sends the RAM write command. The pixel
+// window cache used by drawPixel() is also kept per panel by select(), so
+// MULTI_TFT_SUPPORT is not needed when CPU drawing is done between select() and
+// deselect().
+//
+// Frame pixels must be in the TFT byte order (as in a 16-bit Sprite) and the frame
+// buffer must be 4 byte aligned in DMA capable (internal) memory and stay unchanged
+// until busy() returns false for the panel.
+//
+// Only one instance can be used, tft.initDMA() must be called before begin().
+***************************************************************************************/
+
+#if defined (ESP32_DMA) && !defined (TFT_PARALLEL_8_BIT) && !defined (ILI9225_DRIVER) && !defined (SSD1351_DRIVER) && !defined (RPI_DISPLAY_TYPE)
+  #define MULTI_TFT_DMA
+#endif
+
+#define MULTI_PANELS 4      // Maximum number of panels
+#define MULTI_FRAMES 2      // Frames that can be queued for each panel
+
+#ifndef MULTI_QUEUE_SIZE
+  #define MULTI_QUEUE_SIZE 16 // SPI driver transactions in flight, minimum 6
+#endif
+
+#ifndef MULTI_CHUNK
+  #define MULTI_CHUNK 2048    // Pixels sent to a panel before the next panel is served (even)
+#endif
+
+#ifdef MULTI_TFT_DMA
+
+class TFT_eMulti {
+
+ public:
+
+  explicit TFT_eMulti(TFT_eSPI *tft);
+  ~TFT_eMulti(void);
+
+           // Add the SPI driver device used for the panels, returns false on failure
+  bool     begin(void);
+
+           // Wait for queued frames and remove the SPI driver device
+  void     end(void);
+
+           // Add a panel with chip select pin cs, returns the panel number or -1 if the
+           // panel limit is reached. Call after tft.init() so all panels are initialised.
+  int8_t   addPanel(int8_t cs);
+
+           // Queue a frame of w x h pixels for the window at x,y. Returns false if the
+           // panel frame queue is full, the window is not on the screen or the frame
+           // is not in DMA capable memory.
+  bool     pushFrame(uint8_t panel, int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t* data);
+
+           // Feed queued frames to the SPI driver, returns true while frames are queued.
+           // Call often, for example in loop() between rendering frames.
+  bool     update(void);
+
+           // Returns true if a frame queued for the panel has not been sent
+  bool     busy(uint8_t panel);
+
+           // Wait until all queued frames have been sent
+  void     wait(void);
+
+           // Select a panel for CPU drawing with the TFT_eSPI functions, waits for queued
+           // frames first. Call deselect() before the next update().
+  void     select(uint8_t panel);
+  void     deselect(void);
+
+           // Forget the window sent to a panel, use if the panel is drawn with another
+           // instance or the CS pin is driven by the sketch
+  void     invalidate(uint8_t panel);
+
+  uint8_t  panels(void);
+
+ private:
+
+  typedef struct {
+    const uint16_t* data;
+    int32_t  x, y, w, h;
+  } multi_frame_t;
+
+  typedef struct {
+    int8_t   cs;
+    int32_t  x0, y0, x1, y1;      // Window in RAM coordinates, x0 < 0 if unknown
+    int32_t  addr_row, addr_col;  // drawPixel() window cache while not selected
+    multi_frame_t frame[MULTI_FRAMES];
+    uint8_t  head;                // Oldest frame not sent
+    uint8_t  count;               // Frames queued
+    uint8_t  queued;              // Frames with all pixels in the SPI driver queue
+    uint32_t sent;                // Pixels of the next frame in the SPI driver queue
+  } multi_panel_t;
+
+  bool     feed(uint8_t p);                                     // Queue the next chunk for a panel
+  void     queueWindow(uint8_t p, int32_t x, int32_t y, int32_t w, int32_t h);
+  void     queueBytes(uint8_t p, bool dc, uint32_t data, uint8_t bytes);
+  void     queuePixels(uint8_t p, const uint16_t* data, uint32_t len, bool last);
+  spi_transaction_t* nextTrans(uint8_t p, bool last);
+  void     collect(bool block);                                 // Collect sent transactions
+  void     releaseCS(void);
+
+  TFT_eSPI *_tft;
+  spi_device_handle_t _dev;
+
+  multi_panel_t _panel[MULTI_PANELS];
+  uint8_t  _panels;
+  int8_t   _selected;             // Panel selected for CPU drawing, -1 if none
+  uint8_t  _next;                 // Panel served first by the next update()
+
+  spi_transaction_t _trans[MULTI_QUEUE_SIZE]; // Ring of transactions
+  uint8_t  _last[MULTI_QUEUE_SIZE];           // Panel number + 1 if the last of a frame
+  uint8_t  _index;                            // Next free transaction
+  uint8_t  _busy;                             // Transactions not collected
+};
+
+#endif
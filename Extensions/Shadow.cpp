@@ -0,0 +1,167 @@
+// The shadow content map is part of the TFT_eSPI class, see Shadow.h
+
+/***************************************************************************************
+** Function name:           createShadow
+** Description:             Allocate the shadow map, all tiles are unknown
+***************************************************************************************/
+bool TFT_eSPI::createShadow(void)
+{
+  deleteShadow();
+
+  // The tile count is the same for all rotations
+  uint32_t tiles = ((_init_width  + (1 << SHADOW_SHIFT) - 1) >> SHADOW_SHIFT) *
+                   ((_init_height + (1 << SHADOW_SHIFT) - 1) >> SHADOW_SHIFT);
+
+  _shadowColor = (uint16_t*)malloc(tiles * 2);
+  _shadowKnown = (uint8_t*)malloc((tiles + 7) >> 3);
+
+  if (_shadowColor == nullptr || _shadowKnown == nullptr) {
+    deleteShadow();
+    return false;
+  }
+
+  invalidateShadow();
+  return true;
+}
+
+
+/***************************************************************************************
+** Function name:           deleteShadow
+** Description:             Free the shadow map
+***************************************************************************************/
+void TFT_eSPI::deleteShadow(void)
+{
+  if (_shadowColor) free(_shadowColor);
+  if (_shadowKnown) free(_shadowKnown);
+  _shadowColor = nullptr;
+  _shadowKnown = nullptr;
+}
+
+
+/***************************************************************************************
+** Function name:           invalidateShadow
+** Description:             Mark all tiles unknown
+***************************************************************************************/
+void TFT_eSPI::invalidateShadow(void)
+{
+  if (_shadowColor == nullptr) return;
+
+  // Map size depends on the rotation
+  _shadowCols = (_width  + (1 << SHADOW_SHIFT) - 1) >> SHADOW_SHIFT;
+  _shadowRows = (_height + (1 << SHADOW_SHIFT) - 1) >> SHADOW_SHIFT;
+
+  memset(_shadowKnown, 0, (_shadowCols * _shadowRows + 7) >> 3);
+}
+
+
+/***************************************************************************************
+** Function name:           shadowMatch
+** Description:             Returns true if all tiles in range are known to be color
+***************************************************************************************/
+bool TFT_eSPI::shadowMatch(int32_t c0, int32_t r0, int32_t c1, int32_t r1, uint16_t color)
+{
+  for (int32_t r = r0; r <= r1; r++) {
+    uint32_t i = r * _shadowCols + c0;
+    for (int32_t c = c0; c <= c1; c++, i++) {
+      if (!(_shadowKnown[i >> 3] & (1 << (i & 7))) || _shadowColor[i] != color) return false;
+    }
+  }
+  return true;
+}
+
+
+/***************************************************************************************
+** Function name:           shadowFill
+** Description:             Trim a fill to the tiles that differ from the fill colour
+***************************************************************************************/
+// Returns false if the whole area is known to be the fill colour
+bool TFT_eSPI::shadowFill(int32_t &x, int32_t &y, int32_t &w, int32_t &h, uint16_t color)
+{
+  int32_t c0 = x >> SHADOW_SHIFT;
+  int32_t r0 = y >> SHADOW_SHIFT;
+  int32_t c1 = (x + w - 1) >> SHADOW_SHIFT;
+  int32_t r1 = (y + h - 1) >> SHADOW_SHIFT;
+
+  // Trim tile rows from the top and bottom
+  while (r0 <= r1 && shadowMatch(c0, r0, c1, r0, color)) r0++;
+  if (r0 > r1) return false;
+  while (shadowMatch(c0, r1, c1, r1, color)) r1--;
+
+  // Trim tile columns from the left and right, the top row has a tile that differs
+  while (shadowMatch(c0, r0, c0, r1, color)) c0++;
+  while (shadowMatch(c1, r0, c1, r1, color)) c1--;
+
+  int32_t xe = x + w;
+  int32_t ye = y + h;
+
+  if (x < (c0 << SHADOW_SHIFT)) x = c0 << SHADOW_SHIFT;
+  if (y < (r0 << SHADOW_SHIFT)) y = r0 << SHADOW_SHIFT;
+  if (xe > ((c1 + 1) << SHADOW_SHIFT)) xe = (c1 + 1) << SHADOW_SHIFT;
+  if (ye > ((r1 + 1) << SHADOW_SHIFT)) ye = (r1 + 1) << SHADOW_SHIFT;
+
+  w = xe - x;
+  h = ye - y;
+
+  return true;
+}
+
+
+/***************************************************************************************
+** Function name:           shadowSolid
+** Description:             Mark tiles fully covered by a fill as known
+***************************************************************************************/
+void TFT_eSPI::shadowSolid(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color)
+{
+  // Tiles on the right and bottom edges of the screen may be part tiles
+  int32_t c0 = (x + (1 << SHADOW_SHIFT) - 1) >> SHADOW_SHIFT;
+  int32_t r0 = (y + (1 << SHADOW_SHIFT) - 1) >> SHADOW_SHIFT;
+  int32_t c1 = ((x + w == _width)  ? _shadowCols : (x + w) >> SHADOW_SHIFT) - 1;
+  int32_t r1 = ((y + h == _height) ? _shadowRows : (y + h) >> SHADOW_SHIFT) - 1;
+
+  for (int32_t r = r0; r <= r1; r++) {
+    uint32_t i = r * _shadowCols + c0;
+    for (int32_t c = c0; c <= c1; c++, i++) {
+      _shadowColor[i] = color;
+      _shadowKnown[i >> 3] |= 1 << (i & 7);
+    }
+  }
+}
+
+
+/***************************************************************************************
+** Function name:           shadowUnknown
+** Description:             Mark tiles overlapped by a window as unknown
+***************************************************************************************/
+void TFT_eSPI::shadowUnknown(int32_t x0, int32_t y0, int32_t x1, int32_t y1)
+{
+  if (x0 < 0) x0 = 0;
+  if (y0 < 0) y0 = 0;
+  if (x1 >= _width)  x1 = _width  - 1;
+  if (y1 >= _height) y1 = _height - 1;
+  if (x0 > x1 || y0 > y1) return;
+
+  int32_t c0 = x0 >> SHADOW_SHIFT;
+  int32_t c1 = x1 >> SHADOW_SHIFT;
+
+  for (int32_t r = y0 >> SHADOW_SHIFT; r <= (y1 >> SHADOW_SHIFT); r++) {
+    uint32_t i = r * _shadowCols + c0;
+    for (int32_t c = c0; c <= c1; c++, i++) _shadowKnown[i >> 3] &= ~(1 << (i & 7));
+  }
+}
+
+
+/***************************************************************************************
+** Function name:           shadowPixel
+** Description:             Check a pixel against the map, else mark its tile unknown
+***************************************************************************************/
+bool TFT_eSPI::shadowPixel(int32_t x, int32_t y, uint16_t color)
+{
+  uint32_t i = (y >> SHADOW_SHIFT) * _shadowCols + (x >> SHADOW_SHIFT);
+
+  if (_shadowKnown[i >> 3] & (1 << (i & 7))) {
+    if (_shadowColor[i] == color) return true;
+    _shadowKnown[i >> 3] &= ~(1 << (i & 7));
+  }
+
+  return false;
+}
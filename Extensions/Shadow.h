@@ -0,0 +1,37 @@
+ // This is part of the TFT_eSPI class and is associated with the shadow content map
+
+ // The shadow map has one entry per 8 x 8 pixel tile of the screen. A tile is "known"
+ // when the library has filled all of it with one colour, it becomes unknown when any
+ // other graphics are drawn over it. Fills of tiles that are known to hold the fill
+ // colour are not sent, so a clear and redraw update only clears the tiles that have
+ // changed. The map needs 2 bytes + 1 bit per tile, e.g. 2.5 kbytes for 320 x 240.
+
+ public:
+           // Create the shadow map, all tiles are unknown. Returns false if the map cannot
+           // be allocated.
+  bool     createShadow(void);
+
+           // Delete the shadow map
+  void     deleteShadow(void);
+
+           // Mark all tiles unknown, call this after the TFT has been written to by other
+           // means (e.g. commands sent with writecommand())
+  void     invalidateShadow(void);
+
+ private:
+           // Trim a fill to the tiles that differ from the colour, false if none differ
+  bool     shadowFill(int32_t &x, int32_t &y, int32_t &w, int32_t &h, uint16_t color);
+           // Mark the tiles fully covered by a fill as known
+  void     shadowSolid(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color);
+           // Mark the tiles overlapped by a window as unknown
+  void     shadowUnknown(int32_t x0, int32_t y0, int32_t x1, int32_t y1);
+           // Returns true if a pixel is known to have the colour, else marks its tile unknown
+  bool     shadowPixel(int32_t x, int32_t y, uint16_t color);
+           // Returns true if all the tiles in the range are known to have the colour
+  bool     shadowMatch(int32_t c0, int32_t r0, int32_t c1, int32_t r1, uint16_t color);
+
+  #define  SHADOW_SHIFT 3 // 8 x 8 pixel tiles
+
+  uint16_t *_shadowColor = nullptr; // Tile colours
+  uint8_t  *_shadowKnown = nullptr; // Tile known flags, one bit per tile
+  int32_t   _shadowCols, _shadowRows; // Tile map size for the current rotation
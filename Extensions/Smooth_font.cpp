@@ -6,17 +6,67 @@
 // New anti-aliased (smoothed) font functions added below
 ////////////////////////////////////////////////////////////////////////////////////////
 
+static uint32_t fontSerial = 0; // Last font serial number, see layoutFont()
+
 /***************************************************************************************
 ** Function name:           loadFont
 ** Description:             loads parameters from a font vlw array in memory
 *************************************************************************************x*/
-void TFT_eSPI::loadFont(const uint8_t array[])
+void TFT_eSPI::loadFont(const uint8_t array[], bool mapped)
 {
   if (array == nullptr) return;
+  if (fontLoaded) unloadFont();
   fontPtr = (uint8_t*) array;
+  gMapped = mapped;
   loadFont("", false);
 }
 
+/***************************************************************************************
+** Function name:           loadFont
+** Description:             uses the metrics in compiled font tables
+*************************************************************************************x*/
+// The tables are made by Tools/Compile_font/font2table.py and are used in place, so no
+// memory is allocated and the font data is not parsed
+void TFT_eSPI::loadFont(const smoothFont &font)
+{
+  if (fontLoaded) unloadFont();
+
+#ifdef FONT_FS_AVAILABLE
+  fs_font = false;
+#endif
+
+  gFont.gArray     = font.bitmap;
+  gFont.gCount     = font.gCount;
+  gFont.yAdvance   = font.yAdvance;
+  gFont.spaceWidth = font.spaceWidth;
+  gFont.ascent     = font.ascent;
+  gFont.descent    = font.descent;
+  gFont.maxAscent  = font.maxAscent;
+  gFont.maxDescent = font.maxDescent;
+
+  gUnicode   = (uint16_t*)font.unicode;
+  gHeight    =  (uint8_t*)font.height;
+  gWidth     =  (uint8_t*)font.width;
+  gxAdvance  =  (uint8_t*)font.xAdvance;
+  gdY        =  (int16_t*)font.dY;
+  gdX        =   (int8_t*)font.dX;
+  gBitmap    = (uint32_t*)font.bitmapOffset;
+  gFormat    =  (uint8_t*)font.format;
+  gBitmapEnd = font.bitmapSize;
+
+  gKern      = font.kerning;
+  gKernCount = font.kerningCount;
+  gLig       = font.ligature;
+  gLigCount  = font.ligatureCount;
+
+  gSorted = true;
+  gStatic = true;
+
+  gFontId    = ++fontSerial;
+  fontLoaded = true;
+}
+
+
 #ifdef FONT_FS_AVAILABLE
 /***************************************************************************************
 ** Function name:           loadFont
@@ -25,7 +75,9 @@ void TFT_eSPI::loadFont(const uint8_t array[])
 void TFT_eSPI::loadFont(String fontName, fs::FS &ffs)
 {
   fontFS = ffs;
+  BUS_ACQUIRE(BUS_SD); // The file system may be on a shared SPI bus (SD card)
   loadFont(fontName, false);
+  BUS_RELEASE(BUS_SD);
 }
 #endif
 
@@ -54,7 +106,7 @@ void TFT_eSPI::loadFont(String fontName, bool flash)
       4. gxAdvance for cursor (setWidth in Processing)
       5. dY = distance from cursor baseline to top of glyph bitmap (signed value +ve = up)
       6. dX = distance from cursor to left side of glyph bitmap (signed value -ve = left)
-      7. padding value, typically 0
+      7. padding value, typically 0 (bitmap format and size, see below)
 
     The bitmaps start next at 24 + (28 * gCount) bytes from the start of the file.
     Each pixel is 1 byte, an 8-bit Alpha value which represents the transparency from
@@ -71,6 +123,38 @@ void TFT_eSPI::loadFont(String fontName, bool flash)
        a zero/one terminated character string giving the font name
        last byte is 0 for non-anti-aliased and 1 for anti-aliased (smoothed)
 
+    Compressed bitmaps (optional, created by the Create_font sketch):
+       If glyph parameter 7 is not 0 the top byte is the bitmap format and the lower
+       24 bits are the bitmap size in bytes. These fonts need this library version.
+         VLW_ALPHA_4:   4-bit alpha, 2 pixels per byte with the left pixel in the
+                        high nibble, alpha = nibble * 17
+         VLW_ALPHA_RLE: runs within each bitmap row, a byte n is followed by:
+                        n = 0x00-0x3F, nothing: n + 1 transparent pixels
+                        n = 0x40-0x7F, nothing: (n & 0x3F) + 1 opaque pixels
+                        n = 0x80-0xFF, (n & 0x7F) + 1 bytes of 8-bit alpha
+
+    Extended table (optional, added by the Create_font sketch):
+       If header parameter 4 is not 0 it is the offset from the start of the file to
+       an extended table, normally placed at the end of the file. Older versions of
+       this library ignore the parameter so the file remains compatible.
+         uint32_t 0x54465458 ("TFTX")
+         uint32_t number of kerning pairs
+         uint32_t number of ligatures
+         Kerning pairs, 6 bytes each, sorted by first then second Unicode:
+           uint16_t first Unicode, uint16_t second Unicode,
+           int16_t x adjustment in pixels added to the cursor before the second glyph
+         Ligatures, 6 bytes each, sorted by first then second Unicode:
+           uint16_t first Unicode, uint16_t second Unicode,
+           uint16_t Unicode of the glyph that replaces the pair
+
+    Glyph map (optional, added by the Create_font sketch if addGlyphMap is true):
+       Follows the ligatures in the extended table. With the map the glyph metrics
+       can be read in place from a font array, see loadFont(array, true).
+         uint32_t 0x5446544D ("TFTM")
+         uint32_t flags, bit 0 set if the glyphs are in ascending Unicode order
+         uint32_t maximum descent, as found by loadMetrics()
+         uint32_t offset of each glyph bitmap from the start of the file
+
 
     Glyph bitmap example is:
     // Cursor coordinate positions for this and next character are marked by 'C'
@@ -128,7 +212,7 @@ void TFT_eSPI::loadFont(String fontName, bool flash)
   gFont.gCount   = (uint16_t)readInt32(); // glyph count in file
                              readInt32(); // vlw encoder version - discard
   gFont.yAdvance = (uint16_t)readInt32(); // Font size in points, not pixels
-                             readInt32(); // discard
+  uint32_t extOffset =       readInt32(); // Extended table offset, 0 if none
   gFont.ascent   = (uint16_t)readInt32(); // top of "d"
   gFont.descent  = (uint16_t)readInt32(); // bottom of "p"
 
@@ -138,10 +222,17 @@ void TFT_eSPI::loadFont(String fontName, bool flash)
   gFont.yAdvance   = gFont.ascent + gFont.descent;
   gFont.spaceWidth = gFont.yAdvance / 4;  // Guess at space width
 
+  gFontId    = ++fontSerial;
   fontLoaded = true;
 
-  // Fetch the metrics for each glyph
-  loadMetrics();
+  // Fetch the metrics for each glyph, unless they can be read in place from the array
+  if (!gMapped || !mapMetrics()) {
+    gMapped = false;
+    loadMetrics();
+  }
+
+  // Fetch the kerning and ligature tables
+  if (extOffset) loadExtTable(extOffset);
 }
 
 
@@ -165,6 +256,7 @@ void TFT_eSPI::loadMetrics(void)
     gdY       =  (int16_t*)ps_malloc( gFont.gCount * 2); // offset from bitmap top edge from lowest point in any character
     gdX       =   (int8_t*)ps_malloc( gFont.gCount );    // offset for bitmap left edge relative to cursor X
     gBitmap   = (uint32_t*)ps_malloc( gFont.gCount * 4); // seek pointer to glyph bitmap in the file
+    gFormat   =  (uint8_t*)ps_malloc( gFont.gCount );    // bitmap format
   }
   else
 #endif
@@ -176,6 +268,7 @@ void TFT_eSPI::loadMetrics(void)
     gdY       =  (int16_t*)malloc( gFont.gCount * 2); // offset from bitmap top edge from lowest point in any character
     gdX       =   (int8_t*)malloc( gFont.gCount );    // offset for bitmap left edge relative to cursor X
     gBitmap   = (uint32_t*)malloc( gFont.gCount * 4); // seek pointer to glyph bitmap in the file
+    gFormat   =  (uint8_t*)malloc( gFont.gCount );    // bitmap format
   }
 
 #ifdef SHOW_ASCENT_DESCENT
@@ -197,7 +290,7 @@ void TFT_eSPI::loadMetrics(void)
     gxAdvance[gNum] =  (uint8_t)readInt32(); // xAdvance - to move x cursor
     gdY[gNum]       =  (int16_t)readInt32(); // y delta from baseline
     gdX[gNum]       =   (int8_t)readInt32(); // x delta from cursor
-    readInt32(); // ignored
+    uint32_t format =           readInt32(); // Bitmap format and size, 0 for 8-bit alpha
 
     //Serial.print("Unicode = 0x"); Serial.print(gUnicode[gNum], HEX); Serial.print(", gHeight  = "); Serial.println(gHeight[gNum]);
     //Serial.print("Unicode = 0x"); Serial.print(gUnicode[gNum], HEX); Serial.print(", gWidth  = "); Serial.println(gWidth[gNum]);
@@ -235,25 +328,319 @@ void TFT_eSPI::loadMetrics(void)
     }
 
     gBitmap[gNum] = bitmapPtr;
+    gFormat[gNum] = format >> 24;
 
-    bitmapPtr += gWidth[gNum] * gHeight[gNum];
+    if (format) bitmapPtr += format & 0xFFFFFF;
+    else bitmapPtr += gWidth[gNum] * gHeight[gNum];
 
     gNum++;
     yield();
   }
 
+  gBitmapEnd = bitmapPtr;
+
   gFont.yAdvance = gFont.maxAscent + gFont.maxDescent;
 
   gFont.spaceWidth = (gFont.ascent + gFont.descent) * 2/7;  // Guess at space width
 }
 
 
+/***************************************************************************************
+** Function name:           mapMetrics
+** Description:             Find the glyph map so metrics are read in place from the array
+*************************************************************************************x*/
+// Returns false if the font does not have a glyph map
+bool TFT_eSPI::mapMetrics(void)
+{
+#ifdef FONT_FS_AVAILABLE
+  if (fs_font) return false;
+#endif
+
+  fontPtr = (uint8_t*)gFont.gArray + 12;
+  uint32_t extOffset = readInt32();
+  if (extOffset == 0) return false;
+
+  // The glyph map follows the kerning and ligature tables
+  fontPtr = (uint8_t*)gFont.gArray + extOffset;
+  if (readInt32() != VLW_EXT_MAGIC) return false;
+  uint32_t entries = readInt32();
+  entries += readInt32();
+  fontPtr += entries * VLW_EXT_ENTRY;
+  if (readInt32() != VLW_MAP_MAGIC) return false;
+
+  uint32_t flags   = readInt32();
+  gFont.maxDescent = (uint16_t)readInt32();
+  gMap = fontPtr;
+
+  gSorted = flags & 1;
+
+  gFont.yAdvance = gFont.maxAscent + gFont.maxDescent;
+
+  gFont.spaceWidth = (gFont.ascent + gFont.descent) * 2/7;  // Guess at space width
+
+  return true;
+}
+
+
+/***************************************************************************************
+** Function name:           getGlyphMetrics
+** Description:             Get the metrics of a glyph
+*************************************************************************************x*/
+void TFT_eSPI::getGlyphMetrics(uint16_t gNum, glyphMetrics* gm)
+{
+  if (gMapped)
+  {
+    // The 32-bit big endian glyph parameters are read in place
+    const uint8_t* p = gFont.gArray + 24 + gNum * 28;
+    gm->height   = pgm_read_byte(p + 7);
+    gm->width    = pgm_read_byte(p + 11);
+    gm->xAdvance = pgm_read_byte(p + 15);
+    gm->dY       = (int16_t)((pgm_read_byte(p + 18) << 8) | pgm_read_byte(p + 19));
+    gm->dX       = (int8_t)pgm_read_byte(p + 23);
+    gm->format   = pgm_read_byte(p + 24);
+  }
+  else
+  {
+    gm->height   = gHeight[gNum];
+    gm->width    = gWidth[gNum];
+    gm->xAdvance = gxAdvance[gNum];
+    gm->dY       = gdY[gNum];
+    gm->dX       = gdX[gNum];
+    gm->format   = gFormat[gNum];
+  }
+  gm->bitmap = glyphBitmap(gNum);
+}
+
+
+/***************************************************************************************
+** Function name:           glyphUnicode
+** Description:             Get the Unicode of a glyph
+*************************************************************************************x*/
+uint16_t TFT_eSPI::glyphUnicode(uint16_t gNum)
+{
+  if (gMapped)
+  {
+    const uint8_t* p = gFont.gArray + 24 + gNum * 28;
+    return (pgm_read_byte(p + 2) << 8) | pgm_read_byte(p + 3);
+  }
+  return gUnicode[gNum];
+}
+
+
+/***************************************************************************************
+** Function name:           glyphBitmap
+** Description:             Get the offset of a glyph bitmap from the start of the font
+*************************************************************************************x*/
+uint32_t TFT_eSPI::glyphBitmap(uint16_t gNum)
+{
+  if (gMapped)
+  {
+    const uint8_t* p = gMap + gNum * 4;
+    uint32_t val  = (uint32_t)pgm_read_byte(p)     << 24;
+             val |= (uint32_t)pgm_read_byte(p + 1) << 16;
+             val |= (uint32_t)pgm_read_byte(p + 2) << 8;
+             val |= (uint32_t)pgm_read_byte(p + 3);
+    return val;
+  }
+  return gBitmap[gNum];
+}
+
+
+/***************************************************************************************
+** Function name:           loadExtTable
+** Description:             Find the kerning and ligature tables
+*************************************************************************************x*/
+void TFT_eSPI::loadExtTable(uint32_t offset)
+{
+#ifdef FONT_FS_AVAILABLE
+  if (fs_font) fontFile.seek(offset, fs::SeekSet);
+  else
+#endif
+  fontPtr = (uint8_t*)gFont.gArray + offset;
+
+  if (readInt32() != VLW_EXT_MAGIC) return;
+
+  uint16_t kCount = (uint16_t)readInt32();
+  uint16_t lCount = (uint16_t)readInt32();
+  uint32_t bytes  = (kCount + lCount) * VLW_EXT_ENTRY;
+
+  if (bytes == 0) return;
+
+#ifdef FONT_FS_AVAILABLE
+  // Tables are searched often so keep a copy in RAM, this is the only allocation
+  if (fs_font) {
+    gExtTable = (uint8_t*)malloc(bytes);
+    if (gExtTable == nullptr) return;
+    if (fontFile.read(gExtTable, bytes) != bytes) {
+      free(gExtTable);
+      gExtTable = nullptr;
+      return;
+    }
+    gKern = gExtTable;
+  }
+  else
+#endif
+  gKern = fontPtr; // Tables are read directly from the font array
+
+  gLig = gKern + kCount * VLW_EXT_ENTRY;
+  gKernCount = kCount;
+  gLigCount  = lCount;
+}
+
+
+/***************************************************************************************
+** Function name:           findExtEntry
+** Description:             Binary search of a kerning or ligature table for a pair
+*************************************************************************************x*/
+const uint8_t* TFT_eSPI::findExtEntry(const uint8_t* table, uint16_t count, uint16_t first, uint16_t second)
+{
+  uint32_t key = ((uint32_t)first << 16) | second;
+  int32_t  lo = 0, hi = (int32_t)count - 1;
+
+  while (lo <= hi) {
+    int32_t mid = (lo + hi) >> 1;
+    const uint8_t* entry = table + mid * VLW_EXT_ENTRY;
+    uint32_t val  = (uint32_t)pgm_read_byte(entry)     << 24;
+             val |= (uint32_t)pgm_read_byte(entry + 1) << 16;
+             val |= (uint32_t)pgm_read_byte(entry + 2) << 8;
+             val |= (uint32_t)pgm_read_byte(entry + 3);
+    if (val == key) return entry;
+    if (val < key) lo = mid + 1;
+    else hi = mid - 1;
+  }
+
+  return nullptr;
+}
+
+
+/***************************************************************************************
+** Function name:           getKerning
+** Description:             Return the x adjustment in pixels between two characters
+*************************************************************************************x*/
+int16_t TFT_eSPI::getKerning(uint16_t first, uint16_t second)
+{
+  if (gKernCount == 0) return 0;
+
+  const uint8_t* entry = findExtEntry(gKern, gKernCount, first, second);
+  if (entry == nullptr) return 0;
+
+  return (int16_t)((pgm_read_byte(entry + 4) << 8) | pgm_read_byte(entry + 5));
+}
+
+
+/***************************************************************************************
+** Function name:           getLigature
+** Description:             Return the Unicode of the ligature for two characters, or 0
+*************************************************************************************x*/
+uint16_t TFT_eSPI::getLigature(uint16_t first, uint16_t second)
+{
+  if (gLigCount == 0) return 0;
+
+  const uint8_t* entry = findExtEntry(gLig, gLigCount, first, second);
+  if (entry == nullptr) return 0;
+
+  return (pgm_read_byte(entry + 4) << 8) | pgm_read_byte(entry + 5);
+}
+
+
+/***************************************************************************************
+** Function name:           getGlyphData
+** Description:             Return a pointer to a glyph bitmap, font files are read to RAM
+*************************************************************************************x*/
+// A glyph from a font file is read to a scratch buffer that is reused for the next glyph,
+// it is only reallocated for a larger glyph and is freed by unloadFont()
+const uint8_t* TFT_eSPI::getGlyphData(uint16_t gNum)
+{
+#ifdef FONT_FS_AVAILABLE
+  if (fs_font) {
+    uint32_t end  = (gNum + 1 < gFont.gCount) ? gBitmap[gNum + 1] : gBitmapEnd;
+    uint32_t size = end - gBitmap[gNum];
+
+    if (size > gScratchSize) {
+      if (gScratch) free(gScratch);
+      gScratch = (uint8_t*)malloc(size);
+      gScratchSize = gScratch ? size : 0;
+      if (gScratch == nullptr) return nullptr;
+    }
+
+    if (!spiffs) { BUS_ACQUIRE(BUS_SD); }
+    fontFile.seek(gBitmap[gNum], fs::SeekSet); // This is slow for a significant position shift!
+    fontFile.read(gScratch, size);
+    if (!spiffs) { BUS_RELEASE(BUS_SD); }
+    return gScratch;
+  }
+#endif
+
+  return gFont.gArray + glyphBitmap(gNum);
+}
+
+
+/***************************************************************************************
+** Function name:           readGlyphRun
+** Description:             Return the alpha of the next run of pixels in a glyph bitmap
+*************************************************************************************x*/
+// The run length is returned in len, runs do not cross the end of a bitmap row
+uint8_t TFT_eSPI::readGlyphRun(glyphRun* run, uint16_t* len)
+{
+  *len = 1;
+
+  if (run->format == VLW_ALPHA_4) {
+    uint8_t nibble = pgm_read_byte(run->data + run->pos);
+    if (run->low) { nibble &= 0x0F; run->pos++; }
+    else nibble >>= 4;
+    run->low = !run->low;
+    return nibble * 17;
+  }
+
+  if (run->format == VLW_ALPHA_RLE) {
+    if (run->literal) {
+      run->literal--;
+      return pgm_read_byte(run->data + run->pos++);
+    }
+
+    uint8_t n = pgm_read_byte(run->data + run->pos++);
+    if (n & 0x80) {
+      run->literal = n & 0x7F;
+      return pgm_read_byte(run->data + run->pos++);
+    }
+
+    *len = (n & 0x3F) + 1;
+    return (n & 0x40) ? 0xFF : 0;
+  }
+
+  return pgm_read_byte(run->data + run->pos++);
+}
+
+
 /***************************************************************************************
 ** Function name:           deleteMetrics
 ** Description:             Delete the old glyph metrics and free up the memory
 *************************************************************************************x*/
 void TFT_eSPI::unloadFont( void )
 {
+  // Compiled font tables are not allocated and a handle owns the memory of the fonts
+  // it stores, so only the pointers are cleared
+  if (gStatic || gHandle)
+  {
+    gUnicode  = NULL;
+    gHeight   = NULL;
+    gWidth    = NULL;
+    gxAdvance = NULL;
+    gdY       = NULL;
+    gdX       = NULL;
+    gBitmap   = NULL;
+    gFormat   = NULL;
+    gExtTable = NULL;
+#ifdef FONT_FS_AVAILABLE
+    if (gHandle) fontFile = fs::File();
+#endif
+    gStatic   = false;
+    gHandle   = nullptr;
+  }
+  gSorted = false;
+  gMapped = false;
+  gMap    = nullptr;
+
   if (gUnicode)
   {
     free(gUnicode);
@@ -296,9 +683,33 @@ void TFT_eSPI::unloadFont( void )
     gBitmap = NULL;
   }
 
+  if (gFormat)
+  {
+    free(gFormat);
+    gFormat = NULL;
+  }
+
+  if (gExtTable)
+  {
+    free(gExtTable);
+    gExtTable = NULL;
+  }
+
+  gKern = nullptr;
+  gLig  = nullptr;
+  gKernCount = 0;
+  gLigCount  = 0;
+
   gFont.gArray = nullptr;
 
 #ifdef FONT_FS_AVAILABLE
+  if (gScratch)
+  {
+    free(gScratch);
+    gScratch = nullptr;
+  }
+  gScratchSize = 0;
+
   if (fs_font && fontFile) fontFile.close();
 #endif
 
@@ -306,6 +717,95 @@ void TFT_eSPI::unloadFont( void )
 }
 
 
+/***************************************************************************************
+** Function name:           storeFont
+** Description:             Move the loaded font into a font handle
+*************************************************************************************x*/
+bool TFT_eSPI::storeFont(TFT_eFont *font)
+{
+  if (font == nullptr || !fontLoaded || gHandle) return false;
+
+  font->unloadFont();
+
+  font->gFont      = gFont;
+  font->gUnicode   = gUnicode;
+  font->gHeight    = gHeight;
+  font->gWidth     = gWidth;
+  font->gxAdvance  = gxAdvance;
+  font->gdY        = gdY;
+  font->gdX        = gdX;
+  font->gBitmap    = gBitmap;
+  font->gFormat    = gFormat;
+  font->gBitmapEnd = gBitmapEnd;
+  font->gSorted    = gSorted;
+  font->gStatic    = gStatic;
+  font->gMapped    = gMapped;
+  font->gMap       = gMap;
+
+  font->gKern      = gKern;
+  font->gLig       = gLig;
+  font->gKernCount = gKernCount;
+  font->gLigCount  = gLigCount;
+  font->gExtTable  = gExtTable;
+
+#ifdef FONT_FS_AVAILABLE
+  font->fontFile   = fontFile;
+  font->spiffs     = spiffs;
+  font->fs_font    = fs_font;
+#endif
+
+  font->_loaded = true;
+
+  // The font stays selected, but is now owned by the handle
+  gHandle = font;
+
+  return true;
+}
+
+
+/***************************************************************************************
+** Function name:           loadFont
+** Description:             Select a font stored in a font handle
+*************************************************************************************x*/
+void TFT_eSPI::loadFont(TFT_eFont *font)
+{
+  if (fontLoaded) unloadFont();
+
+  if (font == nullptr || !font->_loaded) return;
+
+  gFont      = font->gFont;
+  gUnicode   = font->gUnicode;
+  gHeight    = font->gHeight;
+  gWidth     = font->gWidth;
+  gxAdvance  = font->gxAdvance;
+  gdY        = font->gdY;
+  gdX        = font->gdX;
+  gBitmap    = font->gBitmap;
+  gFormat    = font->gFormat;
+  gBitmapEnd = font->gBitmapEnd;
+  gSorted    = font->gSorted;
+  gStatic    = font->gStatic;
+  gMapped    = font->gMapped;
+  gMap       = font->gMap;
+
+  gKern      = font->gKern;
+  gLig       = font->gLig;
+  gKernCount = font->gKernCount;
+  gLigCount  = font->gLigCount;
+  gExtTable  = font->gExtTable;
+
+#ifdef FONT_FS_AVAILABLE
+  fontFile   = font->fontFile;
+  spiffs     = font->spiffs;
+  fs_font    = font->fs_font;
+#endif
+
+  gHandle    = font;
+  gFontId    = ++fontSerial;
+  fontLoaded = true;
+}
+
+
 /***************************************************************************************
 ** Function name:           readInt32
 ** Description:             Get a 32-bit integer from the font file
@@ -340,9 +840,28 @@ uint32_t TFT_eSPI::readInt32(void)
 *************************************************************************************x*/
 bool TFT_eSPI::getUnicodeIndex(uint16_t unicode, uint16_t *index)
 {
+  if (gSorted)
+  {
+    // Binary search of a sorted glyph table
+    int32_t lo = 0, hi = (int32_t)gFont.gCount - 1;
+    while (lo <= hi)
+    {
+      int32_t mid = (lo + hi) >> 1;
+      uint16_t code = glyphUnicode(mid);
+      if (code == unicode)
+      {
+        *index = mid;
+        return true;
+      }
+      if (code < unicode) lo = mid + 1;
+      else hi = mid - 1;
+    }
+    return false;
+  }
+
   for (uint16_t i = 0; i < gFont.gCount; i++)
   {
-    if (gUnicode[i] == unicode)
+    if (glyphUnicode(i) == unicode)
     {
       *index = i;
       return true;
@@ -394,29 +913,23 @@ void TFT_eSPI::drawGlyph(uint16_t code)
   
   if (found)
   {
+    glyphMetrics gm;
+    getGlyphMetrics(gNum, &gm);
 
-    if (textwrapX && (cursor_x + gWidth[gNum] + gdX[gNum] > width()))
+    if (textwrapX && (cursor_x + gm.width + gm.dX > width()))
     {
       cursor_y += gFont.yAdvance;
       cursor_x = 0;
       bg_cursor_x = 0;
     }
     if (textwrapY && ((cursor_y + gFont.yAdvance) >= height())) cursor_y = 0;
-    if (cursor_x == 0) cursor_x -= gdX[gNum];
+    if (cursor_x == 0) cursor_x -= gm.dX;
 
-    uint8_t* pbuffer = nullptr;
-    const uint8_t* gPtr = (const uint8_t*) gFont.gArray;
+    // Get the bitmap before starting the TFT transaction, fonts in a file are read to RAM
+    glyphRun run = { getGlyphData(gNum), 0, gm.format, 0, false };
 
-#ifdef FONT_FS_AVAILABLE
-    if (fs_font)
-    {
-      fontFile.seek(gBitmap[gNum], fs::SeekSet);
-      pbuffer =  (uint8_t*)malloc(gWidth[gNum]);
-    }
-#endif
-
-    int16_t cy = cursor_y + gFont.maxAscent - gdY[gNum];
-    int16_t cx = cursor_x + gdX[gNum];
+    int16_t cy = cursor_y + gFont.maxAscent - gm.dY;
+    int16_t cx = cursor_x + gm.dX;
 
     //  if (cx > width() && bg_cursor_x > width()) return;
     //  if (cursor_y > height()) return;
@@ -435,9 +948,9 @@ void TFT_eSPI::drawGlyph(uint16_t code)
 
     // Fill area above glyph
     if (_fillbg) {
-      fillwidth  = (cursor_x + gxAdvance[gNum]) - bg_cursor_x;
+      fillwidth  = (cursor_x + gm.xAdvance) - bg_cursor_x;
       if (fillwidth > 0) {
-        fillheight = gFont.maxAscent - gdY[gNum];
+        fillheight = gFont.maxAscent - gm.dY;
         // Could be negative
         if (fillheight > 0) {
           fillRect(bg_cursor_x, cursor_y, fillwidth, fillheight, textbgcolor);
@@ -449,41 +962,23 @@ void TFT_eSPI::drawGlyph(uint16_t code)
       }
 
       // Fill any area to left of glyph                              
-      if (bg_cursor_x < cx) fillRect(bg_cursor_x, cy, cx - bg_cursor_x, gHeight[gNum], textbgcolor);
+      if (bg_cursor_x < cx) fillRect(bg_cursor_x, cy, cx - bg_cursor_x, gm.height, textbgcolor);
       // Set x position in glyph area where background starts
       if (bg_cursor_x > cx) bx = bg_cursor_x - cx;
       // Fill any area to right of glyph
-      if (cx + gWidth[gNum] < cursor_x + gxAdvance[gNum]) {
-        fillRect(cx + gWidth[gNum], cy, (cursor_x + gxAdvance[gNum]) - (cx + gWidth[gNum]), gHeight[gNum], textbgcolor);
+      if (cx + gm.width < cursor_x + gm.xAdvance) {
+        fillRect(cx + gm.width, cy, (cursor_x + gm.xAdvance) - (cx + gm.width), gm.height, textbgcolor);
       }
     }
 
-    for (int32_t y = 0; y < gHeight[gNum]; y++)
+    for (int32_t y = 0; run.data && y < gm.height; y++)
     {
-#ifdef FONT_FS_AVAILABLE
-      if (fs_font) {
-        if (spiffs)
-        {
-          fontFile.read(pbuffer, gWidth[gNum]);
-          //Serial.println("SPIFFS");
-        }
-        else
-        {
-          endWrite();    // Release SPI for SD card transaction
-          fontFile.read(pbuffer, gWidth[gNum]);
-          startWrite();  // Re-start SPI for TFT transaction
-          //Serial.println("Not SPIFFS");
-        }
-      }
-#endif
-
-      for (int32_t x = 0; x < gWidth[gNum]; x++)
+      int32_t x = 0;
+      while (x < gm.width)
       {
-#ifdef FONT_FS_AVAILABLE
-        if (fs_font) pixel = pbuffer[x];
-        else
-#endif
-        pixel = pgm_read_byte(gPtr + gBitmap[gNum] + x + gWidth[gNum] * y);
+        // Runs of opaque or transparent pixels are drawn as lines without per pixel tests
+        uint16_t len = 1;
+        pixel = readGlyphRun(&run, &len);
 
         if (pixel)
         {
@@ -501,19 +996,21 @@ void TFT_eSPI::drawGlyph(uint16_t code)
           else
           {
             if (fl==0) fxs = x + cx;
-            fl++;
+            fl += len;
           }
         }
         else
         {
           if (fl) { drawFastHLine( fxs, y + cy, fl, fg); fl = 0; }
           if (_fillbg) {
-            if (x >= bx) {
-              if (bl==0) bxs = x + cx;
-              bl++;
+            int32_t xs = (x < bx) ? bx : x; // Background starts at bx
+            if (xs < x + len) {
+              if (bl==0) bxs = xs + cx;
+              bl += x + len - xs;
             }
           }
         }
+        x += len;
       }
       if (fl) { drawFastHLine( fxs, y + cy, fl, fg); fl = 0; }
       if (bl) { drawFastHLine( bxs, y + cy, bl, bg); bl = 0; }
@@ -521,14 +1018,13 @@ void TFT_eSPI::drawGlyph(uint16_t code)
 
     // Fill area below glyph
     if (fillwidth > 0) {
-      fillheight = (cursor_y + gFont.yAdvance) - (cy + gHeight[gNum]);
+      fillheight = (cursor_y + gFont.yAdvance) - (cy + gm.height);
       if (fillheight > 0) {
-        fillRect(bg_cursor_x, cy + gHeight[gNum], fillwidth, fillheight, textbgcolor);
+        fillRect(bg_cursor_x, cy + gm.height, fillwidth, fillheight, textbgcolor);
       }
     }
 
-    if (pbuffer) free(pbuffer);
-    cursor_x += gxAdvance[gNum];
+    cursor_x += gm.xAdvance;
     endWrite();
   }
   else
@@ -557,13 +1053,16 @@ void TFT_eSPI::showFont(uint32_t td)
   
   for (uint16_t i = 0; i < gFont.gCount; i++)
   {
+    glyphMetrics gm;
+    getGlyphMetrics(i, &gm);
+
     // Check if this will need a new screen
-    if (cursorX + gdX[i] + gWidth[i] >= width())  {
-      cursorX = -gdX[i];
+    if (cursorX + gm.dX + gm.width >= width())  {
+      cursorX = -gm.dX;
 
       cursorY += gFont.yAdvance;
       if (cursorY + gFont.maxAscent + gFont.descent >= height()) {
-        cursorX = -gdX[i];
+        cursorX = -gm.dX;
         cursorY = 0;
         delay(timeDelay);
         timeDelay = td;
@@ -572,8 +1071,8 @@ void TFT_eSPI::showFont(uint32_t td)
     }
 
     setCursor(cursorX, cursorY);
-    drawGlyph(gUnicode[i]);
-    cursorX += gxAdvance[i];
+    drawGlyph(glyphUnicode(i));
+    cursorX += gm.xAdvance;
     yield();
   }
 
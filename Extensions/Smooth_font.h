@@ -1,17 +1,43 @@
  // Coded by Bodmer 10/2/18, see license in root directory.
  // This is part of the TFT_eSPI class and is associated with anti-aliased font functions
 
+// Extended vlw table identifier ("TFTX") and table entry size in bytes, see loadFont()
+#define VLW_EXT_MAGIC 0x54465458
+#define VLW_EXT_ENTRY 6
+
+// Glyph map identifier ("TFTM"), follows the extended table ligatures, see loadFont()
+#define VLW_MAP_MAGIC 0x5446544D
+
+// Glyph bitmap formats, in the top byte of glyph parameter 7, see loadFont()
+#define VLW_ALPHA_8   0  // 8-bit alpha per pixel
+#define VLW_ALPHA_4   1  // 4-bit alpha per pixel, 2 pixels per byte
+#define VLW_ALPHA_RLE 2  // Run length encoded alpha
+
  public:
 
   // These are for the new anti-aliased fonts
-  void     loadFont(const uint8_t array[]);
+           // If mapped is true the glyph metrics are read in place from the array, no
+           // memory is allocated. This needs a font with a glyph map, see loadFont()
+           // and addGlyphMap in the Create_font sketch.
+  void     loadFont(const uint8_t array[], bool mapped = false);
+  void     loadFont(const smoothFont &font);  // Font tables made by font2table.py
 #ifdef FONT_FS_AVAILABLE
   void     loadFont(String fontName, fs::FS &ffs);
 #endif
   void     loadFont(String fontName, bool flash = true);
   void     unloadFont( void );
+
+           // Move the loaded font into a font handle, the font stays selected. Returns
+           // false if no font is loaded or the font is already in a handle.
+  bool     storeFont(TFT_eFont *font);
+           // Select a font stored in a handle, no memory is allocated
+  void     loadFont(TFT_eFont *font);
   bool     getUnicodeIndex(uint16_t unicode, uint16_t *index);
 
+           // Kerning and ligatures from the font extended table (0 if none)
+  int16_t  getKerning(uint16_t first, uint16_t second);
+  uint16_t getLigature(uint16_t first, uint16_t second);
+
   virtual void drawGlyph(uint16_t code);
 
   void     showFont(uint32_t td);
@@ -39,6 +65,43 @@ fontMetrics gFont = { nullptr, 0, 0, 0, 0, 0, 0, 0 };
   int16_t*  gdY = NULL;       //topExtent
   int8_t*   gdX = NULL;       //leftExtent
   uint32_t* gBitmap = NULL;   //file pointer to greyscale bitmap
+  uint8_t*  gFormat = NULL;   //bitmap format
+  uint32_t  gBitmapEnd = 0;   //file pointer to end of last bitmap
+  bool      gSorted = false;  //gUnicode is in ascending order
+  bool      gStatic = false;  //metrics are in compiled font tables, not allocated
+  bool      gMapped = false;  //metrics are read in place from the font array
+  const uint8_t* gMap = nullptr; //glyph bitmap offsets in the font array
+  TFT_eFont* gHandle = nullptr; //font handle selected, the handle owns the metrics
+  uint32_t  gFontId = 0;      //serial number of the font load, identifies the font in text layouts
+
+  // Metrics for one glyph, see getGlyphMetrics()
+  typedef struct
+  {
+    uint8_t  height;                 // Bitmap height
+    uint8_t  width;                  // Bitmap width
+    uint8_t  xAdvance;               // Cursor advance
+    int16_t  dY;                     // Baseline to top of bitmap
+    int8_t   dX;                     // Cursor to left of bitmap
+    uint8_t  format;                 // Bitmap format
+    uint32_t bitmap;                 // Bitmap offset
+  } glyphMetrics;
+
+  // Glyph bitmap decoder state
+  typedef struct
+  {
+    const uint8_t* data;             // Bitmap data
+    uint32_t pos;                    // Index of next byte
+    uint8_t  format;                 // Bitmap format
+    uint8_t  literal;                // Pixels left in a run length encoded literal
+    bool     low;                    // Next 4-bit pixel is in the low nibble
+  } glyphRun;
+
+  // Kerning pair and ligature tables from the font extended table, see loadFont()
+  const uint8_t* gKern = nullptr;  // Kerning pairs, in the font array or gExtTable
+  const uint8_t* gLig  = nullptr;  // Ligatures, follow the kerning pairs
+  uint16_t  gKernCount = 0;
+  uint16_t  gLigCount  = 0;
+  uint8_t*  gExtTable  = NULL;     // RAM copy of the tables for a font file
 
   bool     fontLoaded = false; // Flags when a anti-aliased font is loaded
 
@@ -47,6 +110,8 @@ fontMetrics gFont = { nullptr, 0, 0, 0, 0, 0, 0, 0 };
   fs::FS   &fontFS  = SPIFFS;
   bool     spiffs   = true;
   bool     fs_font = false;    // For ESP32/8266 use smooth font file or FLASH (PROGMEM) array
+  uint8_t* gScratch = nullptr; // Glyph bitmap read from the font file, only grows
+  uint32_t gScratchSize = 0;
 
 #else
   bool     fontFile = true;
@@ -55,6 +120,14 @@ fontMetrics gFont = { nullptr, 0, 0, 0, 0, 0, 0, 0 };
   private:
 
   void     loadMetrics(void);
+  bool     mapMetrics(void);
+  void     getGlyphMetrics(uint16_t gNum, glyphMetrics* gm);
+  uint16_t glyphUnicode(uint16_t gNum);
+  uint32_t glyphBitmap(uint16_t gNum);
+  void     loadExtTable(uint32_t offset);
+  const uint8_t* findExtEntry(const uint8_t* table, uint16_t count, uint16_t first, uint16_t second);
+  const uint8_t* getGlyphData(uint16_t gNum);
+  uint8_t  readGlyphRun(glyphRun* run, uint16_t* len);
   uint32_t readInt32(void);
 
   uint8_t* fontPtr = nullptr;
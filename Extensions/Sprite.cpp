@@ -24,6 +24,7 @@ TFT_eSprite::TFT_eSprite(TFT_eSPI *tft)
   _swapBytes = false;   // Do not swap pushImage colour bytes by default
 
   _created = false;
+  _view    = false;
   _vpOoB   = true;
 
   _xs = 0;  // window bounds for pushColor
@@ -36,6 +37,9 @@ TFT_eSprite::TFT_eSprite(TFT_eSPI *tft)
 
   _colorMap = nullptr;
 
+  _pool    = nullptr;
+  _poolGen = 0;
+
   _psram_enable = true;
   
   // Ensure end_tft_write() does nothing in inherited functions.
@@ -111,6 +115,78 @@ void* TFT_eSprite::createSprite(int16_t w, int16_t h, uint8_t frames)
 }
 
 
+/***************************************************************************************
+** Function name:           createView
+** Description:             Create a sprite that uses an area of another sprite's memory
+***************************************************************************************/
+// No memory is allocated, the view uses the source Sprite memory with the source line
+// length as the stride, so graphics drawn in the view appear in the source Sprite.
+void* TFT_eSprite::createView(TFT_eSprite *src, int16_t x, int16_t y, int16_t w, int16_t h)
+{
+  if ( _created || src == nullptr || !src->_created ) return nullptr;
+
+  // Crop to the source Sprite
+  if (x < 0) { w += x; x = 0; }
+  if (y < 0) { h += y; y = 0; }
+  if ((x + w) > src->_dwidth)  w = src->_dwidth  - x;
+  if ((y + h) > src->_dheight) h = src->_dheight - y;
+
+  if ( w < 1 || h < 1 ) return nullptr;
+
+  // 4bpp and 1bpp views must start on a byte boundary
+  if (src->_bpp == 4 && (x & 0x01)) return nullptr;
+  if (src->_bpp == 1 && (x & 0x07)) return nullptr;
+
+  _bpp      = src->_bpp;
+  _iwidth   = src->_iwidth;   // Source line length is the stride
+  _bitwidth = src->_bitwidth;
+  _iheight  = _dheight = h;
+  _dwidth   = w;
+
+  // Start of the view in the currently selected source frame buffer
+  if      (_bpp == 16) _img8 = src->_img8 + ((x + y * _iwidth) << 1);
+  else if (_bpp ==  8) _img8 = src->_img8 +  (x + y * _iwidth);
+  else if (_bpp ==  4) _img8 = src->_img8 + ((x + y * _iwidth) >> 1);
+  else                 _img8 = src->_img8 + ((x + y * _bitwidth) >> 3);
+
+  _img8_1 = _img8;
+  _img8_2 = _img8;
+  _img    = (uint16_t*) _img8;
+  _img4   = _img8;
+
+  _colorMap = src->_colorMap; // Palette is shared with the source
+
+  cursor_x = 0;
+  cursor_y = 0;
+
+  // Default scroll rectangle and gap fill colour
+  _sx = 0;
+  _sy = 0;
+  _sw = w;
+  _sh = h;
+  _scolor = TFT_BLACK;
+
+  _view    = true;
+  _created = true;
+
+  rotation = 0;
+  setViewport(0, 0, _dwidth, _dheight);
+  setPivot(_dwidth/2, _dheight/2);
+
+  return _img8_1;
+}
+
+
+/***************************************************************************************
+** Function name:           isView
+** Description:             Returns true if the sprite is a view of another sprite
+***************************************************************************************/
+bool TFT_eSprite::isView(void)
+{
+  return _view;
+}
+
+
 /***************************************************************************************
 ** Function name:           getPointer
 ** Description:             Returns pointer to start of sprite memory area
@@ -156,54 +232,26 @@ void* TFT_eSprite::callocSprite(int16_t w, int16_t h, uint8_t frames)
   // this means push/writeColor functions do not need additional bounds checks and
   // hence will run faster in normal circumstances.
   uint8_t* ptr8 = nullptr;
+  uint32_t bytes;
 
   if (frames > 2) frames = 2; // Currently restricted to 2 frame buffers
   if (frames < 1) frames = 1;
 
   if (_bpp == 16)
   {
-#if defined (ESP32) && defined (CONFIG_SPIRAM_SUPPORT)
-    if ( psramFound() && _psram_enable && !_tft->DMA_Enabled)
-    {
-      ptr8 = ( uint8_t*) ps_calloc(frames * w * h + frames, sizeof(uint16_t));
-      //Serial.println("PSRAM");
-    }
-    else
-#endif
-    {
-      ptr8 = ( uint8_t*) calloc(frames * w * h + frames, sizeof(uint16_t));
-      //Serial.println("Normal RAM");
-    }
+    bytes = (frames * w * h + frames) * sizeof(uint16_t);
   }
 
   else if (_bpp == 8)
   {
-#if defined(__IMXRT1062__)
-    if (external_psram_size > 0 && _psram_enable) {
-        ptr8 = (uint8_t*)extmem_malloc(frames * w * h + frames * sizeof(uint16_t));
-    }
-#elif defined(ESP32) && defined(CONFIG_SPIRAM_SUPPORT)
-    if (psramFound() && _psram_enable) {
-        ptr8 = (uint8_t*)ps_malloc(frames * w * h + frames * sizeof(uint16_t));
-    }
-#endif
-    ptr8 = ( uint8_t*) calloc(frames * w * h + frames, sizeof(uint8_t));
+    bytes = frames * w * h + frames;
   }
 
   else if (_bpp == 4)
   {
     w = (w+1) & 0xFFFE; // width needs to be multiple of 2, with an extra "off screen" pixel
     _iwidth = w;
-#if defined(__IMXRT1062__)
-    if (external_psram_size > 0 && _psram_enable) {
-        ptr8 = (uint8_t*)extmem_malloc(frames * w * h + frames * sizeof(uint16_t));
-    }
-#elif defined(ESP32) && defined(CONFIG_SPIRAM_SUPPORT)
-    if (psramFound() && _psram_enable) {
-        ptr8 = (uint8_t*)ps_malloc(frames * w * h + frames * sizeof(uint16_t));
-    }
-#endif
-    ptr8 = ( uint8_t*) calloc(((frames * w * h) >> 1) + frames, sizeof(uint8_t));
+    bytes = ((frames * w * h) >> 1) + frames;
   }
 
   else // Must be 1 bpp
@@ -215,18 +263,35 @@ void* TFT_eSprite::callocSprite(int16_t w, int16_t h, uint8_t frames)
     w =  (w+7) & 0xFFF8; // width should be the multiple of 8 bits to be compatible with epdpaint
     _iwidth = w;         // _iwidth is rounded up to be multiple of 8, so might not be = _dwidth
     _bitwidth = w;       // _bitwidth will not be rotated whereas _iwidth may be
+    bytes = frames * (w>>3) * h + frames;
+  }
+
+  // Use the memory pool if one has been set, the heap is not used as a fallback
+  if (_pool)
+  {
+    _poolGen = _pool->generation();
+    return _pool->allocate(bytes, true);
+  }
 
 #if defined(__IMXRT1062__)
-    if (external_psram_size > 0 && _psram_enable) {
-        ptr8 = (uint8_t*)extmem_malloc(frames * w * h + frames * sizeof(uint16_t));
-    }
+  if (external_psram_size > 0 && _psram_enable && _bpp != 16) {
+      ptr8 = (uint8_t*)extmem_calloc(bytes, sizeof(uint8_t));
+  }
 #elif defined(ESP32) && defined(CONFIG_SPIRAM_SUPPORT)
-    if (psramFound() && _psram_enable) {
-        ptr8 = (uint8_t*)ps_malloc(frames * w * h + frames * sizeof(uint16_t));
-    }
+  // 16bpp Sprites stay in internal RAM if DMA is used
+  if (psramFound() && _psram_enable && (_bpp != 16 || !_tft->DMA_Enabled)) {
+      ptr8 = (uint8_t*)ps_calloc(bytes, sizeof(uint8_t));
+  }
 #endif
-    ptr8 = ( uint8_t*) calloc(frames * (w>>3) * h + frames, sizeof(uint8_t));
+
+  if (ptr8 == nullptr) ptr8 = (uint8_t*)calloc(bytes, sizeof(uint8_t));
+
+#if defined(ESP32) && defined(CONFIG_SPIRAM_SUPPORT) && defined(DMA_BOUNCE_SIZE)
+  // Large 16bpp Sprites can use PSRAM, pushImageDMA() sends them through bounce buffers
+  if (ptr8 == nullptr && psramFound() && _psram_enable) {
+      ptr8 = (uint8_t*)ps_calloc(bytes, sizeof(uint8_t));
   }
+#endif
 
   return ptr8;
 }
@@ -389,21 +454,30 @@ void TFT_eSprite::deleteSprite(void)
 {
   if (_colorMap != nullptr)
   {
-    free(_colorMap);
+    if (!_view) free(_colorMap); // A view shares the source palette
     _colorMap = nullptr;
   }
 
   if (_created)
   {
-   #if defined(__IMXRT1062__)
-    if (external_psram_size > 0 && _psram_enable) {
-        extmem_free(_img8);
+    if (_view)
+    {
+      // Memory belongs to the source Sprite
+      _view = false;
     }
-#elif defined(ESP32) && defined(CONFIG_SPIRAM_SUPPORT)
-    if (psramFound() && _psram_enable) {
-        free(_img8);  // ESP32's free handles PSRAM automatically
+    else if (_pool)
+    {
+      // Memory is not returned if the pool has been reset since it was allocated
+      if (_poolGen == _pool->generation()) _pool->release(_img8_1);
     }
+    else
+    {
+#if defined(__IMXRT1062__)
+      extmem_free(_img8_1); // Handles both internal and external RAM
+#else
+      free(_img8_1);        // ESP32's free handles PSRAM automatically
 #endif
+    }
     _img8 = nullptr;
     _created = false;
     _vpOoB   = true;  // TFT_eSPI class write() uses this to check for valid sprite
@@ -411,6 +485,29 @@ void TFT_eSprite::deleteSprite(void)
 }
 
 
+/***************************************************************************************
+** Function name:           setPool
+** Description:             Set a memory pool for the Sprite, nullptr to use the heap
+***************************************************************************************/
+bool TFT_eSprite::setPool(TFT_eSprite_Pool *pool)
+{
+  if (_created) return false;
+
+  _pool = pool;
+  return true;
+}
+
+
+/***************************************************************************************
+** Function name:           getPool
+** Description:             Return the memory pool pointer, nullptr if heap is used
+***************************************************************************************/
+TFT_eSprite_Pool* TFT_eSprite::getPool(void)
+{
+  return _pool;
+}
+
+
 /***************************************************************************************
 ** Function name:           pushRotated - Fast fixed point integer maths version
 ** Description:             Push rotated Sprite to TFT screen
@@ -683,6 +780,9 @@ void TFT_eSprite::pushSprite(int32_t x, int32_t y)
 {
   if (!_created) return;
 
+  // Line stride of a view is not the width so push as a windowed area
+  if (_view) { pushSprite(x, y, 0, 0, _dwidth, _dheight); return; }
+
   if (_bpp == 16)
   {
     bool oldSwapBytes = _tft->getSwapBytes();
@@ -706,6 +806,9 @@ void TFT_eSprite::pushSprite(int32_t x, int32_t y, uint16_t transp)
 {
   if (!_created) return;
 
+  // Line stride of a view is not the width so push as a windowed area
+  if (_view) { pushSprite(x, y, 0, 0, _dwidth, _dheight, transp); return; }
+
   if (_bpp == 16)
   {
     bool oldSwapBytes = _tft->getSwapBytes();
@@ -750,6 +853,9 @@ bool TFT_eSprite::pushToSprite(TFT_eSprite *dspr, int32_t x, int32_t y)
   if (_bpp ==  4 && ds_bpp !=  4) return false;
   if (_bpp ==  1 && ds_bpp !=  1) return false;
 
+  // Line stride of a view is not the width so push as a windowed area
+  if (_view) return pushToSprite(dspr, x, y, 0, 0, _dwidth, _dheight);
+
   bool oldSwapBytes = dspr->getSwapBytes();
   dspr->setSwapBytes(false);
   dspr->pushImage(x, y, _dwidth, _dheight, _img, _bpp);
@@ -768,52 +874,14 @@ bool TFT_eSprite::pushToSprite(TFT_eSprite *dspr, int32_t x, int32_t y)
 //    16bpp  -> 16bpp
 //    16bpp  ->  8bpp
 //     8bpp  ->  8bpp
+//     4bpp  ->  4bpp (transp is the palette index)
 //     1bpp  ->  1bpp
 
 bool TFT_eSprite::pushToSprite(TFT_eSprite *dspr, int32_t x, int32_t y, uint16_t transp)
 {
-  if ( !_created  || !dspr->_created) return false; // Check Sprites exist
-
-  // Check destination sprite compatibility
-  int8_t ds_bpp = dspr->getColorDepth();
-  if (_bpp == 16 && ds_bpp != 16 && ds_bpp !=  8) return false;
-  if (_bpp ==  8 && ds_bpp !=  8) return false;
-  if (_bpp ==  4 || ds_bpp ==  4) return false;
-  if (_bpp ==  1 && ds_bpp !=  1) return false;
-
-  bool oldSwapBytes = dspr->getSwapBytes();
-  uint16_t sline_buffer[width()];
-
-  transp = transp>>8 | transp<<8;
-
-  // Scan destination bounding box and fetch transformed pixels from source Sprite
-  for (int32_t ys = 0; ys < height(); ys++) {
-    int32_t ox = x;
-    uint32_t pixel_count = 0;
-
-    for (int32_t xs = 0; xs < width(); xs++) {
-      uint16_t rp = 0;
-      if (_bpp == 16) rp = _img[xs + ys * width()];
-      else { rp = readPixel(xs, ys); rp = rp>>8 | rp<<8; }
-      //dspr->drawPixel(xs, ys, rp);
+  if (!_created) return false;
 
-      if (transp == rp) {
-        if (pixel_count) {
-          dspr->pushImage(ox, y, pixel_count, 1, sline_buffer);
-          ox += pixel_count;
-          pixel_count = 0;
-        }
-        ox++;
-      }
-      else {
-        sline_buffer[pixel_count++] = rp;
-      }
-    }
-    if (pixel_count) dspr->pushImage(ox, y, pixel_count, 1, sline_buffer);
-    y++;
-  }
-  dspr->setSwapBytes(oldSwapBytes);
-  return true;
+  return pushToSprite(dspr, x, y, 0, 0, width(), height(), transp);
 }
 
 
@@ -847,7 +915,7 @@ bool TFT_eSprite::pushSprite(int32_t tx, int32_t ty, int32_t sx, int32_t sy, int
     _tft->setSwapBytes(false);
 
     // Check if a faster block copy to screen is possible
-    if ( sx == 0 && sw == _dwidth)
+    if ( sx == 0 && sw == _iwidth)
       _tft->pushImage(tx, ty, sw, sh, _img + _iwidth * _ys );
     else // Render line by line
       while (sh--)
@@ -858,7 +926,7 @@ bool TFT_eSprite::pushSprite(int32_t tx, int32_t ty, int32_t sx, int32_t sy, int
   else if (_bpp == 8)
   {
     // Check if a faster block copy to screen is possible
-    if ( sx == 0 && sw == _dwidth)
+    if ( sx == 0 && sw == _iwidth)
       _tft->pushImage(tx, ty, sw, sh, _img8 + _iwidth * _ys, (bool)true );
     else // Render line by line
     while (sh--)
@@ -867,7 +935,7 @@ bool TFT_eSprite::pushSprite(int32_t tx, int32_t ty, int32_t sx, int32_t sy, int
   else if (_bpp == 4)
   {
     // Check if a faster block copy to screen is possible
-    if ( sx == 0 && sw == _dwidth)
+    if ( sx == 0 && ((sw + 1) & 0xFFFE) == _iwidth)
       _tft->pushImage(tx, ty, sw, sh, _img4 + (_iwidth>>1) * _ys, false, _colorMap );
     else // Render line by line
     {
@@ -897,14 +965,19 @@ bool TFT_eSprite::pushSprite(int32_t tx, int32_t ty, int32_t sx, int32_t sy, int
   else // 1bpp
   {
     // Check if a faster block copy to screen is possible
-    if ( sx == 0 && sw == _dwidth)
+    if ( sx == 0 && ((sw + 7) >> 3) == (_bitwidth >> 3))
       _tft->pushImage(tx, ty, sw, sh, _img8 + (_bitwidth>>3) * _ys, (bool)false );
     else // Render line by line
     {
       _tft->startWrite();
       while (sh--)
       {
-        _tft->pushImage(tx, ty++, sw, 1, _img8 + (_bitwidth>>3) * _ys++, (bool)false );
+        if (_xs & 0x07) // Line does not start on a byte boundary so plot pixel by pixel
+          for (int32_t xp = 0; xp < sw; xp++) _tft->drawPixel(tx + xp, ty, readPixel(_xs + xp, _ys));
+        else
+          _tft->pushImage(tx, ty, sw, 1, _img8 + (_bitwidth>>3) * _ys + (_xs>>3), (bool)false );
+        ty++;
+        _ys++;
       }
       _tft->endWrite();
     }
@@ -914,6 +987,216 @@ bool TFT_eSprite::pushSprite(int32_t tx, int32_t ty, int32_t sx, int32_t sy, int
 }
 
 
+/***************************************************************************************
+** Function name:           pushSprite
+** Description:             Push a cropped sprite to the TFT at tx, ty with transparent colour
+***************************************************************************************/
+// For 4bpp Sprites transp is the palette index, for 1bpp Sprites 0 bits are transparent
+bool TFT_eSprite::pushSprite(int32_t tx, int32_t ty, int32_t sx, int32_t sy, int32_t sw, int32_t sh, uint16_t transp)
+{
+  if (!_created) return false;
+
+  // Perform window boundary checks and crop if needed
+  setWindow(sx, sy, sx + sw - 1, sy + sh - 1);
+
+  // Calculate new sprite window bounding box width and height
+  sw = _xe - _xs + 1;
+  sh = _ye - _ys + 1;
+
+  if (_ys >= _iheight) return false;
+
+  if (_bpp == 16)
+  {
+    bool oldSwapBytes = _tft->getSwapBytes();
+    _tft->setSwapBytes(false);
+
+    // Check if a faster block copy to screen is possible
+    if ( sx == 0 && sw == _iwidth)
+      _tft->pushImage(tx, ty, sw, sh, _img + _iwidth * _ys, transp );
+    else // Render line by line
+      while (sh--)
+        _tft->pushImage(tx, ty++, sw, 1, _img + _xs + _iwidth * _ys++, transp );
+
+    _tft->setSwapBytes(oldSwapBytes);
+  }
+  else if (_bpp == 8)
+  {
+    transp = (uint8_t)((transp & 0xE000)>>8 | (transp & 0x0700)>>6 | (transp & 0x0018)>>3);
+
+    // Check if a faster block copy to screen is possible
+    if ( sx == 0 && sw == _iwidth)
+      _tft->pushImage(tx, ty, sw, sh, _img8 + _iwidth * _ys, (uint8_t)transp, (bool)true );
+    else // Render line by line
+      while (sh--)
+        _tft->pushImage(tx, ty++, sw, 1, _img8 + _xs + _iwidth * _ys++, (uint8_t)transp, (bool)true );
+  }
+  else if (_bpp == 4)
+  {
+    transp &= 0x0F;
+    int32_t ds = _xs&1; // Odd x start pixel
+
+    _tft->startWrite();
+    while (sh--)
+    {
+      if (ds)
+      {
+        uint8_t index = _img4[(_xs + _iwidth * _ys)>>1] & 0x0F;
+        if (index != transp) _tft->drawPixel(tx, ty, _colorMap[index]);
+      }
+      if (sw > ds)
+        _tft->pushImage(tx + ds, ty, sw - ds, 1, _img4 + ((_xs + ds + _iwidth * _ys)>>1), (uint8_t)transp, false, _colorMap );
+      _ys++;
+      ty++;
+    }
+    _tft->endWrite();
+  }
+  else // 1bpp
+  {
+    _tft->startWrite();
+    while (sh--)
+    {
+      if (_xs & 0x07) // Line does not start on a byte boundary so plot pixel by pixel
+      {
+        for (int32_t xp = 0; xp < sw; xp++)
+          if (readPixelValue(_xs + xp, _ys) == 1) _tft->drawPixel(tx + xp, ty, _tft->bitmap_fg);
+      }
+      else
+        _tft->pushImage(tx, ty, sw, 1, _img8 + (_bitwidth>>3) * _ys + (_xs>>3), (uint8_t)0, (bool)false );
+      ty++;
+      _ys++;
+    }
+    _tft->endWrite();
+  }
+
+  return true;
+}
+
+
+/***************************************************************************************
+** Function name:           pushToSprite
+** Description:             Push a cropped sprite to another sprite at x, y
+***************************************************************************************/
+// Supports the same colour depths as pushToSprite(dspr, x, y)
+bool TFT_eSprite::pushToSprite(TFT_eSprite *dspr, int32_t x, int32_t y, int32_t sx, int32_t sy, int32_t sw, int32_t sh)
+{
+  if ( !_created  || !dspr->_created) return false; // Check Sprites exist
+
+  // Check destination sprite compatibility
+  int8_t ds_bpp = dspr->getColorDepth();
+  if (_bpp == 16 && ds_bpp != 16 && ds_bpp !=  8) return false;
+  if (_bpp ==  8 && ds_bpp !=  8) return false;
+  if (_bpp ==  4 && ds_bpp !=  4) return false;
+  if (_bpp ==  1 && ds_bpp !=  1) return false;
+
+  // Crop to the source Sprite
+  if (sx < 0) { x -= sx; sw += sx; sx = 0; }
+  if (sy < 0) { y -= sy; sh += sy; sy = 0; }
+  if ((sx + sw) > _dwidth)  sw = _dwidth  - sx;
+  if ((sy + sh) > _dheight) sh = _dheight - sy;
+  if (sw < 1 || sh < 1) return false;
+
+  bool oldSwapBytes = dspr->getSwapBytes();
+  dspr->setSwapBytes(false);
+
+  while (sh--)
+  {
+    if (_bpp == 16)
+      dspr->pushImage(x, y, sw, 1, _img + sx + _iwidth * sy, _bpp);
+    else if (_bpp == 8)
+      dspr->pushImage(x, y, sw, 1, (uint16_t*)(_img8 + sx + _iwidth * sy), _bpp);
+    else if (_bpp == 4 && !(sx & 1))
+      dspr->pushImage(x, y, sw, 1, (uint16_t*)(_img4 + ((sx + _iwidth * sy)>>1)), _bpp);
+    else // Odd 4bpp start pixel or 1bpp, copy the palette index or bit value
+      for (int32_t xp = 0; xp < sw; xp++) dspr->drawPixel(x + xp, y, readPixelValue(sx + xp, sy));
+    y++;
+    sy++;
+  }
+
+  dspr->setSwapBytes(oldSwapBytes);
+
+  return true;
+}
+
+
+/***************************************************************************************
+** Function name:           pushToSprite
+** Description:             Push a cropped sprite to another sprite with transparent colour
+***************************************************************************************/
+// Note: The following sprite to sprite colour depths are currently supported:
+//    Source    Destination
+//    16bpp  -> 16bpp
+//    16bpp  ->  8bpp
+//     8bpp  ->  8bpp
+//     4bpp  ->  4bpp (transp is the palette index)
+//     1bpp  ->  1bpp
+
+bool TFT_eSprite::pushToSprite(TFT_eSprite *dspr, int32_t x, int32_t y, int32_t sx, int32_t sy, int32_t sw, int32_t sh, uint16_t transp)
+{
+  if ( !_created  || !dspr->_created) return false; // Check Sprites exist
+
+  // Check destination sprite compatibility
+  int8_t ds_bpp = dspr->getColorDepth();
+  if (_bpp == 16 && ds_bpp != 16 && ds_bpp !=  8) return false;
+  if (_bpp ==  8 && ds_bpp !=  8) return false;
+  if (_bpp ==  4 && ds_bpp !=  4) return false;
+  if (_bpp ==  1 && ds_bpp !=  1) return false;
+
+  // Crop to the source Sprite
+  if (sx < 0) { x -= sx; sw += sx; sx = 0; }
+  if (sy < 0) { y -= sy; sh += sy; sy = 0; }
+  if ((sx + sw) > width())  sw = width()  - sx;
+  if ((sy + sh) > height()) sh = height() - sy;
+  if (sw < 1 || sh < 1) return false;
+
+  // 4bpp palette index is compared and copied directly
+  if (_bpp == 4)
+  {
+    transp &= 0x0F;
+    for (int32_t ys = sy; ys < sy + sh; ys++) {
+      for (int32_t xs = sx; xs < sx + sw; xs++) {
+        uint16_t index = readPixelValue(xs, ys);
+        if (index != transp) dspr->drawPixel(x + xs - sx, y, index);
+      }
+      y++;
+    }
+    return true;
+  }
+
+  bool oldSwapBytes = dspr->getSwapBytes();
+  uint16_t sline_buffer[sw];
+
+  transp = transp>>8 | transp<<8;
+
+  // Scan destination bounding box and fetch transformed pixels from source Sprite
+  for (int32_t ys = sy; ys < sy + sh; ys++) {
+    int32_t ox = x;
+    uint32_t pixel_count = 0;
+
+    for (int32_t xs = sx; xs < sx + sw; xs++) {
+      uint16_t rp = 0;
+      if (_bpp == 16) rp = _img[xs + ys * _iwidth];
+      else { rp = readPixel(xs, ys); rp = rp>>8 | rp<<8; }
+
+      if (transp == rp) {
+        if (pixel_count) {
+          dspr->pushImage(ox, y, pixel_count, 1, sline_buffer);
+          ox += pixel_count;
+          pixel_count = 0;
+        }
+        ox++;
+      }
+      else {
+        sline_buffer[pixel_count++] = rp;
+      }
+    }
+    if (pixel_count) dspr->pushImage(ox, y, pixel_count, 1, sline_buffer);
+    y++;
+  }
+  dspr->setSwapBytes(oldSwapBytes);
+  return true;
+}
+
+
 /***************************************************************************************
 ** Function name:           readPixelValue
 ** Description:             Read the color map index of a pixel at defined coordinates
@@ -1314,6 +1597,9 @@ void TFT_eSprite::pushColor(uint16_t color)
 {
   if (!_created ) return;
 
+  // A view has no "off screen" pixel, the row below is in the source Sprite
+  if (_view && _yptr >= _dheight) return;
+
   // Write the colour to RAM in set window
   if (_bpp == 16)
     _img [_xptr + _yptr * _iwidth] = (uint16_t) (color >> 8) | (color << 8);
@@ -1378,6 +1664,9 @@ void TFT_eSprite::writeColor(uint16_t color)
 {
   if (!_created ) return;
 
+  // A view has no "off screen" pixel, the row below is in the source Sprite
+  if (_view && _yptr >= _dheight) return;
+
   // Write 16-bit RGB 565 encoded colour to RAM
   if (_bpp == 16) _img [_xptr + _yptr * _iwidth] = color;
 
@@ -1415,12 +1704,15 @@ void TFT_eSprite::writeColor(uint16_t color)
 // Intentionally not constrained to viewport area
 void TFT_eSprite::setScrollRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color)
 {
-  if ((x >= _iwidth) || (y >= _iheight) || !_created ) return;
+  // A view must not scroll pixels outside the view area
+  int32_t iw = _view ? _dwidth : _iwidth;
+
+  if ((x >= iw) || (y >= _iheight) || !_created ) return;
 
   if (x < 0) { w += x; x = 0; }
   if (y < 0) { h += y; y = 0; }
 
-  if ((x + w) > _iwidth ) w = _iwidth  - x;
+  if ((x + w) > iw)       w = iw       - x;
   if ((y + h) > _iheight) h = _iheight - y;
 
   if ( w < 1 || h < 1) return;
@@ -1541,7 +1833,7 @@ void TFT_eSprite::fillSprite(uint32_t color)
   if (!_created || _vpOoB) return;
 
   // Use memset if possible as it is super fast
-  if(_xDatum == 0 && _yDatum == 0  &&  _xWidth == width())
+  if(_xDatum == 0 && _yDatum == 0  &&  _xWidth == width() && !_view)
   {
     if(_bpp == 16) {
       if ( (uint8_t)color == (uint8_t)(color>>8) ) {
@@ -2100,6 +2392,22 @@ void TFT_eSprite::drawChar(int32_t x, int32_t y, uint16_t c, uint32_t color, uin
       int8_t   xo = pgm_read_byte(&glyph->xOffset),
                yo = pgm_read_byte(&glyph->yOffset);
 
+      if (_fillbg && (bg != color)) {
+        // Fill the character cell from the end of the previous cell, see TFT_eSPI::drawChar()
+        uint8_t xa  = pgm_read_byte(&glyph->xAdvance);
+        int32_t cx0 = 0;
+        int32_t cx1 = ((xo + w > xa) ? xo + w : xa) * size;
+        if ((last_cursor_x == x) && (bg_cursor_x > x)) cx0 = bg_cursor_x - x;
+        if (cx0 > cx1) cx1 = cx0;
+
+        last_cursor_x = x + xa * size;
+        bg_cursor_x   = x + cx1;
+
+        int16_t cy0 = (yo < -glyph_ab) ? yo : -glyph_ab;
+        int16_t cy1 = (yo + h > glyph_bb) ? yo + h : glyph_bb;
+        if (cx1 > cx0) fillRect(x + cx0, y + cy0 * size, cx1 - cx0, (cy1 - cy0) * size, bg);
+      }
+
       if (((x + xo + w * size - 1) < (_vpX - _xDatum)) || // Clip left
           ((y + yo + h * size - 1) < (_vpY - _yDatum)))   // Clip top
         return;
@@ -2306,45 +2614,29 @@ int16_t TFT_eSprite::drawChar(uint16_t uniCode, int32_t x, int32_t y, uint8_t fo
     if (_bpp == 16) bgcolor = (textbgcolor >> 8) | (textbgcolor << 8);
     else if (_bpp == 8) bgcolor = ((textbgcolor & 0xE000)>>8 | (textbgcolor & 0x0700)>>6 | (textbgcolor & 0x0018)>>3);
 
-    if (textcolor == textbgcolor && !clip && _bpp != 1) {
-      int32_t px = 0, py = pY; // To hold character block start and end column and row values
+    if (textcolor == textbgcolor && !clip) {
+      int32_t px = 0, py = 0; // Run start column and row in the character
       int32_t pc = 0; // Pixel count
-      uint8_t np = textsize * textsize; // Number of pixels in a drawn pixel
-
-      uint8_t tnp = 0; // Temporary copy of np for while loop
-      uint8_t ts = textsize - 1; // Temporary copy of textsize
-      // 16-bit pixel count so maximum font size is equivalent to 180x180 pixels in area
-      // w is total number of pixels to plot to fill character block
+      int32_t rl = 0; // Run length
+      int32_t sl = 0; // Span length
+      // Runs of foreground pixels are split into horizontal spans at the character edge
+      // and each span is drawn with one fillRect()
+      // w is total number of pixels in character block
       while (pc < w) {
         line = pgm_read_byte((uint8_t *)flash_address);
         flash_address++;
         if (line & 0x80) {
-          line &= 0x7F;
-          line++;
-          if (ts) {
-            px = xd + textsize * (pc % width); // Keep these px and py calculations outside the loop as they are slow
-            py = yd + textsize * (pc / width);
-          }
-          else {
-            px = xd + pc % width; // Keep these px and py calculations outside the loop as they are slow
-            py = yd + pc / width;
-          }
-          while (line--) { // In this case the while(line--) is faster
-            pc++; // This is faster than putting pc+=line before while()?
-            setWindow(px, py, px + ts, py + ts);
-
-            if (ts) {
-              tnp = np;
-              while (tnp--) writeColor(color);
-            }
-            else writeColor(color);
-
-            px += textsize;
-
-            if (px >= (xd + width * textsize)) {
-              px = xd;
-              py += textsize;
-            }
+          rl = (line & 0x7F) + 1;
+          px = pc % width; // Keep these px and py calculations outside the loop as they are slow
+          py = pc / width;
+          pc += rl;
+          while (rl > 0) {
+            sl = width - px;
+            if (sl > rl) sl = rl;
+            fillRect(x + px * textsize, y + py * textsize, sl * textsize, textsize, textcolor);
+            rl -= sl;
+            px = 0;
+            py++;
           }
         }
         else {
@@ -2473,21 +2765,23 @@ void TFT_eSprite::drawGlyph(uint16_t code)
 
   if (found)
   {
+    glyphMetrics gm;
+    getGlyphMetrics(gNum, &gm);
 
     bool newSprite = !_created;
 
     if (newSprite)
     {
-      createSprite(gWidth[gNum], gFont.yAdvance);
+      createSprite(gm.width, gFont.yAdvance);
       if(fg != bg) fillSprite(bg);
-      cursor_x = -gdX[gNum];
+      cursor_x = -gm.dX;
       bg_cursor_x = cursor_x;
       last_cursor_x = cursor_x;
       cursor_y = 0;
     }
     else
     {
-      if( textwrapX && ((cursor_x + gWidth[gNum] + gdX[gNum]) > width())) {
+      if( textwrapX && ((cursor_x + gm.width + gm.dX) > width())) {
         cursor_y += gFont.yAdvance;
         cursor_x = 0;
         bg_cursor_x = 0;
@@ -2495,21 +2789,14 @@ void TFT_eSprite::drawGlyph(uint16_t code)
       }
 
       if( textwrapY && ((cursor_y + gFont.yAdvance) > height())) cursor_y = 0;
-      if ( cursor_x == 0) cursor_x -= gdX[gNum];
+      if ( cursor_x == 0) cursor_x -= gm.dX;
     }
 
-    uint8_t* pbuffer = nullptr;
-    const uint8_t* gPtr = (const uint8_t*) gFont.gArray;
+    // Get the bitmap, fonts in a file are read to RAM
+    glyphRun run = { getGlyphData(gNum), 0, gm.format, 0, false };
 
-#ifdef FONT_FS_AVAILABLE
-    if (fs_font) {
-      fontFile.seek(gBitmap[gNum], fs::SeekSet); // This is slow for a significant position shift!
-      pbuffer =  (uint8_t*)malloc(gWidth[gNum]);
-    }
-#endif
-
-    int16_t cy = cursor_y + gFont.maxAscent - gdY[gNum];
-    int16_t cx = cursor_x + gdX[gNum];
+    int16_t cy = cursor_y + gFont.maxAscent - gm.dY;
+    int16_t cx = cursor_x + gm.dX;
 
     //  if (cx > width() && bg_cursor_x > width()) return;
     //  if (cursor_y > height()) return;
@@ -2526,9 +2813,9 @@ void TFT_eSprite::drawGlyph(uint16_t code)
 
     // Fill area above glyph
     if (_fillbg) {
-      fillwidth  = (cursor_x + gxAdvance[gNum]) - bg_cursor_x;
+      fillwidth  = (cursor_x + gm.xAdvance) - bg_cursor_x;
       if (fillwidth > 0) {
-        fillheight = gFont.maxAscent - gdY[gNum];
+        fillheight = gFont.maxAscent - gm.dY;
         if (fillheight > 0) {
           fillRect(bg_cursor_x, cursor_y, fillwidth, fillheight, textbgcolor);
         }
@@ -2539,30 +2826,23 @@ void TFT_eSprite::drawGlyph(uint16_t code)
       }
 
       // Fill any area to left of glyph                              
-      if (bg_cursor_x < cx) fillRect(bg_cursor_x, cy, cx - bg_cursor_x, gHeight[gNum], textbgcolor);
+      if (bg_cursor_x < cx) fillRect(bg_cursor_x, cy, cx - bg_cursor_x, gm.height, textbgcolor);
       // Set x position in glyph area where background starts
       if (bg_cursor_x > cx) bx = bg_cursor_x - cx;
       // Fill any area to right of glyph
-      if (cx + gWidth[gNum] < cursor_x + gxAdvance[gNum]) {
-        fillRect(cx + gWidth[gNum], cy, (cursor_x + gxAdvance[gNum]) - (cx + gWidth[gNum]), gHeight[gNum], textbgcolor);
+      if (cx + gm.width < cursor_x + gm.xAdvance) {
+        fillRect(cx + gm.width, cy, (cursor_x + gm.xAdvance) - (cx + gm.width), gm.height, textbgcolor);
       }
     }
 
-    for (int32_t y = 0; y < gHeight[gNum]; y++)
+    for (int32_t y = 0; run.data && y < gm.height; y++)
     {
-#ifdef FONT_FS_AVAILABLE
-      if (fs_font) {
-        fontFile.read(pbuffer, gWidth[gNum]);
-      }
-#endif
-
-      for (int32_t x = 0; x < gWidth[gNum]; x++)
+      int32_t x = 0;
+      while (x < gm.width)
       {
-#ifdef FONT_FS_AVAILABLE
-        if (fs_font) pixel = pbuffer[x];
-        else
-#endif
-        pixel = pgm_read_byte(gPtr + gBitmap[gNum] + x + gWidth[gNum] * y);
+        // Runs of opaque or transparent pixels are drawn as lines without per pixel tests
+        uint16_t len = 1;
+        pixel = readGlyphRun(&run, &len);
 
         if (pixel)
         {
@@ -2580,19 +2860,21 @@ void TFT_eSprite::drawGlyph(uint16_t code)
           else
           {
             if (fl==0) fxs = x + cx;
-            fl++;
+            fl += len;
           }
         }
         else
         {
           if (fl) { drawFastHLine( fxs, y + cy, fl, fg); fl = 0; }
           if (_fillbg) {
-            if (x >= bx) {
-              if (bl==0) bxs = x + cx;
-              bl++;
+            int32_t xs = (x < bx) ? bx : x; // Background starts at bx
+            if (xs < x + len) {
+              if (bl==0) bxs = xs + cx;
+              bl += x + len - xs;
             }
           }
         }
+        x += len;
       }
       if (fl) { drawFastHLine( fxs, y + cy, fl, fg); fl = 0; }
       if (bl) { drawFastHLine( bxs, y + cy, bl, bg); bl = 0; }
@@ -2600,14 +2882,13 @@ void TFT_eSprite::drawGlyph(uint16_t code)
 
     // Fill area below glyph
     if (fillwidth > 0) {
-      fillheight = (cursor_y + gFont.yAdvance) - (cy + gHeight[gNum]);
+      fillheight = (cursor_y + gFont.yAdvance) - (cy + gm.height);
       if (fillheight > 0) {
-        fillRect(bg_cursor_x, cy + gHeight[gNum], fillwidth, fillheight, textbgcolor);
+        fillRect(bg_cursor_x, cy + gm.height, fillwidth, fillheight, textbgcolor);
       }
     }
 
-    if (pbuffer) free(pbuffer);
-    cursor_x += gxAdvance[gNum];
+    cursor_x += gm.xAdvance;
 
     if (newSprite)
     {
@@ -2659,13 +2940,15 @@ void TFT_eSprite::printToSprite(char *cbuffer, uint16_t len) //String string)
       uint16_t unicode = decodeUTF8((uint8_t*)cbuffer, &n, len - n);
       if (getUnicodeIndex(unicode, &index))
       {
+        glyphMetrics gm;
+        getGlyphMetrics(index, &gm);
         if (first) {
           first = false;
-          sWidth -= gdX[index];
-          cursorX += gdX[index];
+          sWidth -= gm.dX;
+          cursorX += gm.dX;
         }
-        if (n == len) sWidth += ( gWidth[index] + gdX[index]);
-        else sWidth += gxAdvance[index];
+        if (n == len) sWidth += ( gm.width + gm.dX);
+        else sWidth += gm.xAdvance;
       }
       else sWidth += gFont.spaceWidth + 1;
     }
@@ -2699,8 +2982,11 @@ void TFT_eSprite::printToSprite(char *cbuffer, uint16_t len) //String string)
 ***************************************************************************************/
 int16_t TFT_eSprite::printToSprite(int16_t x, int16_t y, uint16_t index)
 {
+  glyphMetrics gm;
+  getGlyphMetrics(index, &gm);
+
   bool newSprite = !_created;
-  int16_t sWidth = gWidth[index];
+  int16_t sWidth = gm.width;
 
   if (newSprite)
   {
@@ -2708,14 +2994,14 @@ int16_t TFT_eSprite::printToSprite(int16_t x, int16_t y, uint16_t index)
 
     if (textcolor != textbgcolor) fillSprite(textbgcolor);
 
-    drawGlyph(gUnicode[index]);
+    drawGlyph(glyphUnicode(index));
 
-    pushSprite(x + gdX[index], y, textbgcolor);
+    pushSprite(x + gm.dX, y, textbgcolor);
     deleteSprite();
   }
 
-  else drawGlyph(gUnicode[index]);
+  else drawGlyph(glyphUnicode(index));
 
-  return gxAdvance[index];
+  return gm.xAdvance;
 }
 #endif
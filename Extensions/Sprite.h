@@ -21,6 +21,16 @@ class TFT_eSprite : public TFT_eSPI {
            //  - 2 bytes per pixel for 16-bit color depth (565 RGB format)
   void*    createSprite(int16_t width, int16_t height, uint8_t frames = 1);
 
+           // Create a sprite that is a view of a width x height area at x,y in another sprite.
+           // No memory is allocated or copied, graphics drawn in the view are clipped to the
+           // view and appear in the source sprite. The source colour depth and palette are
+           // used. For 4bpp x must be even, for 1bpp x must be a multiple of 8. The view must
+           // be deleted before the source sprite. Returns a pointer to the view or nullptr.
+  void*    createView(TFT_eSprite *src, int16_t x, int16_t y, int16_t width, int16_t height);
+
+           // Returns true if the sprite is a view of another sprite
+  bool     isView(void);
+
            // Returns a pointer to the sprite or nullptr if not created, user must cast to pointer type
   void*    getPointer(void);
 
@@ -30,6 +40,12 @@ class TFT_eSprite : public TFT_eSPI {
            // Delete the sprite to free up the RAM
   void     deleteSprite(void);
 
+           // Allocate the Sprite memory from a memory pool instead of the heap, set to nullptr
+           // to use the heap. Must be called before createSprite(), returns false if the
+           // Sprite already exists.
+  bool     setPool(TFT_eSprite_Pool *pool);
+  TFT_eSprite_Pool* getPool(void);
+
            // Select the frame buffer for graphics write (for 2 colour ePaper and DMA toggle buffer)
            // Returns a pointer to the Sprite frame buffer
   void*    frameBuffer(int8_t f);
@@ -125,11 +141,17 @@ class TFT_eSprite : public TFT_eSPI {
 
            // Push a windowed area of the sprite to the TFT at tx, ty
   bool     pushSprite(int32_t tx, int32_t ty, int32_t sx, int32_t sy, int32_t sw, int32_t sh);
+           // As above but with a transparent colour (palette index for 4bpp, 0 bits for 1bpp)
+  bool     pushSprite(int32_t tx, int32_t ty, int32_t sx, int32_t sy, int32_t sw, int32_t sh, uint16_t transparent);
 
            // Push the sprite to another sprite at x,y. This fn calls pushImage() in the destination sprite (dspr) class.
   bool     pushToSprite(TFT_eSprite *dspr, int32_t x, int32_t y);
   bool     pushToSprite(TFT_eSprite *dspr, int32_t x, int32_t y, uint16_t transparent);
 
+           // Push a windowed area of the sprite to another sprite at x,y
+  bool     pushToSprite(TFT_eSprite *dspr, int32_t x, int32_t y, int32_t sx, int32_t sy, int32_t sw, int32_t sh);
+  bool     pushToSprite(TFT_eSprite *dspr, int32_t x, int32_t y, int32_t sx, int32_t sy, int32_t sw, int32_t sh, uint16_t transparent);
+
            // Draw a single character in the selected font
   int16_t  drawChar(uint16_t uniCode, int32_t x, int32_t y, uint8_t font),
            drawChar(uint16_t uniCode, int32_t x, int32_t y);
@@ -152,6 +174,9 @@ class TFT_eSprite : public TFT_eSPI {
 
   TFT_eSPI *_tft;
 
+  TFT_eSprite_Pool *_pool; // Memory pool for the Sprite, nullptr if heap is used
+  uint32_t _poolGen;       // Pool generation when the Sprite memory was allocated
+
            // Reserve memory for the Sprite and return a pointer
   void*    callocSprite(int16_t width, int16_t height, uint8_t frames = 1);
 
@@ -174,6 +199,7 @@ class TFT_eSprite : public TFT_eSPI {
   int32_t  _cosra;   // Cosine of rotation angle in fixed point
 
   bool     _created; // A Sprite has been created and memory reserved
+  bool     _view;    // Sprite is a view of another Sprite's memory
   bool     _gFont = false; 
 
   int32_t  _xs, _ys, _xe, _ye, _xptr, _yptr; // for setWindow
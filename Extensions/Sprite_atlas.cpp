@@ -0,0 +1,305 @@
+/***************************************************************************************
+// Sprite atlas (sprite sheet) class, see Sprite_atlas.h
+***************************************************************************************/
+
+/***************************************************************************************
+** Function name:           TFT_eSprite_Atlas
+** Description:             Class constructor
+***************************************************************************************/
+TFT_eSprite_Atlas::TFT_eSprite_Atlas(TFT_eSPI *tft) : _sheet(tft)
+{
+  _entry      = nullptr;
+  _shelf      = nullptr;
+  _maxEntries = 0;
+  _entries    = 0;
+  _shelves    = 0;
+  _nextY      = 0;
+  _align      = 1;
+}
+
+
+/***************************************************************************************
+** Function name:           ~TFT_eSprite_Atlas
+** Description:             Class destructor
+***************************************************************************************/
+TFT_eSprite_Atlas::~TFT_eSprite_Atlas(void)
+{
+  deleteAtlas();
+}
+
+
+/***************************************************************************************
+** Function name:           createAtlas
+** Description:             Create the sheet Sprite and the entry table
+***************************************************************************************/
+void* TFT_eSprite_Atlas::createAtlas(int16_t w, int16_t h, uint16_t maxEntries, int8_t bpp)
+{
+  if (_sheet.created()) deleteAtlas();
+  if (maxEntries == 0) return nullptr;
+
+  // One allocation holds the entry table and the shelves (one shelf per entry worst case)
+  _entry = (atlasRect*)calloc(2 * maxEntries, sizeof(atlasRect));
+  if (_entry == nullptr) return nullptr;
+  _shelf = _entry + maxEntries;
+
+  _sheet.setColorDepth(bpp);
+  if (_sheet.createSprite(w, h) == nullptr)
+  {
+    free(_entry);
+    _entry = nullptr;
+    _shelf = nullptr;
+    return nullptr;
+  }
+
+  bpp = _sheet.getColorDepth();
+  if      (bpp == 4) _align = 2;
+  else if (bpp == 1) _align = 8;
+  else               _align = 1;
+
+  _maxEntries = maxEntries;
+  clear();
+
+  return _sheet.getPointer();
+}
+
+
+/***************************************************************************************
+** Function name:           deleteAtlas
+** Description:             Delete the sheet Sprite and table
+***************************************************************************************/
+void TFT_eSprite_Atlas::deleteAtlas(void)
+{
+  _sheet.deleteSprite();
+
+  if (_entry) free(_entry);
+  _entry = nullptr;
+  _shelf = nullptr;
+
+  _maxEntries = 0;
+  _entries    = 0;
+  _shelves    = 0;
+  _nextY      = 0;
+}
+
+
+/***************************************************************************************
+** Function name:           created
+** Description:             Returns true if the atlas has been created
+***************************************************************************************/
+bool TFT_eSprite_Atlas::created(void)
+{
+  return _sheet.created() && _entry != nullptr;
+}
+
+
+/***************************************************************************************
+** Function name:           getSprite
+** Description:             Returns a pointer to the sheet Sprite
+***************************************************************************************/
+TFT_eSprite* TFT_eSprite_Atlas::getSprite(void)
+{
+  return &_sheet;
+}
+
+
+/***************************************************************************************
+** Function name:           clear
+** Description:             Remove all entries and fill the sheet with a colour
+***************************************************************************************/
+void TFT_eSprite_Atlas::clear(uint32_t color)
+{
+  _entries = 0;
+  _shelves = 0;
+  _nextY   = 0;
+
+  if (_sheet.created()) _sheet.fillSprite(color);
+}
+
+
+/***************************************************************************************
+** Function name:           setEntry
+** Description:             Define an entry for an area of the sheet, returns index or -1
+***************************************************************************************/
+int16_t TFT_eSprite_Atlas::setEntry(int16_t x, int16_t y, int16_t w, int16_t h)
+{
+  if (!created() || _entries >= _maxEntries) return -1;
+
+  // Entry must be inside the sheet
+  if (x < 0 || y < 0 || w < 1 || h < 1) return -1;
+  if ((x + w) > _sheet.width() || (y + h) > _sheet.height()) return -1;
+
+  _entry[_entries] = { x, y, w, h };
+
+  // Space below a defined entry is not used for packing
+  if ((y + h) > _nextY)
+  {
+    _nextY = y + h;
+    _shelves = 0; // Existing shelves may overlap the entry
+  }
+
+  return _entries++;
+}
+
+
+/***************************************************************************************
+** Function name:           setEntries
+** Description:             Define entries from a table, returns the number added
+***************************************************************************************/
+uint16_t TFT_eSprite_Atlas::setEntries(const atlasRect *table, uint16_t count)
+{
+  uint16_t added = 0;
+
+  while (added < count)
+  {
+    if (setEntry(table[added].x, table[added].y, table[added].w, table[added].h) < 0) break;
+    added++;
+  }
+
+  return added;
+}
+
+
+/***************************************************************************************
+** Function name:           reserveEntry
+** Description:             Pack a w x h area into the free space, returns index or -1
+***************************************************************************************/
+int16_t TFT_eSprite_Atlas::reserveEntry(int16_t w, int16_t h)
+{
+  if (!created() || _entries >= _maxEntries) return -1;
+  if (w < 1 || h < 1) return -1;
+
+  // Width rounded up so the next entry starts on a byte boundary
+  int16_t aw = (w + _align - 1) & ~(_align - 1);
+  int16_t sheetW = _sheet.width();
+
+  // Use the lowest shelf that is tall enough and has space
+  int16_t best = -1;
+  for (uint16_t i = 0; i < _shelves; i++)
+  {
+    if (_shelf[i].h < h || (_shelf[i].x + w) > sheetW) continue;
+    if (best < 0 || _shelf[i].h < _shelf[best].h) best = i;
+  }
+
+  // Otherwise start a new shelf below the last one
+  if (best < 0)
+  {
+    if (w > sheetW || (_nextY + h) > _sheet.height()) return -1;
+    best = _shelves++;
+    _shelf[best] = { 0, _nextY, 0, h };
+    _nextY += h;
+  }
+
+  _entry[_entries] = { _shelf[best].x, _shelf[best].y, w, h };
+  _shelf[best].x += aw;
+
+  return _entries++;
+}
+
+
+/***************************************************************************************
+** Function name:           addImage
+** Description:             Pack an image into the free space, returns index or -1
+***************************************************************************************/
+int16_t TFT_eSprite_Atlas::addImage(int16_t w, int16_t h, uint16_t *data, uint8_t sbpp)
+{
+  if (data == nullptr) return -1;
+
+  int16_t index = reserveEntry(w, h);
+  if (index < 0) return -1;
+
+  _sheet.pushImage(_entry[index].x, _entry[index].y, w, h, data, sbpp);
+
+  return index;
+}
+
+
+/***************************************************************************************
+** Function name:           addImage
+** Description:             Pack a 565 FLASH (PROGMEM) image, returns index or -1
+***************************************************************************************/
+int16_t TFT_eSprite_Atlas::addImage(int16_t w, int16_t h, const uint16_t *data)
+{
+  if (data == nullptr) return -1;
+
+  int16_t index = reserveEntry(w, h);
+  if (index < 0) return -1;
+
+  _sheet.pushImage(_entry[index].x, _entry[index].y, w, h, data);
+
+  return index;
+}
+
+
+/***************************************************************************************
+** Function name:           getEntry
+** Description:             Get the rectangle for an entry
+***************************************************************************************/
+bool TFT_eSprite_Atlas::getEntry(uint16_t index, atlasRect *rect)
+{
+  if (index >= _entries || rect == nullptr) return false;
+
+  *rect = _entry[index];
+  return true;
+}
+
+
+/***************************************************************************************
+** Function name:           entries
+** Description:             Returns the number of entries defined
+***************************************************************************************/
+uint16_t TFT_eSprite_Atlas::entries(void)
+{
+  return _entries;
+}
+
+
+/***************************************************************************************
+** Function name:           pushEntry
+** Description:             Render an entry to the TFT at x, y
+***************************************************************************************/
+bool TFT_eSprite_Atlas::pushEntry(uint16_t index, int32_t x, int32_t y)
+{
+  if (index >= _entries) return false;
+
+  atlasRect *r = &_entry[index];
+  return _sheet.pushSprite(x, y, r->x, r->y, r->w, r->h);
+}
+
+
+/***************************************************************************************
+** Function name:           pushEntry
+** Description:             Render an entry to the TFT at x, y with transparent colour
+***************************************************************************************/
+bool TFT_eSprite_Atlas::pushEntry(uint16_t index, int32_t x, int32_t y, uint16_t transp)
+{
+  if (index >= _entries) return false;
+
+  atlasRect *r = &_entry[index];
+  return _sheet.pushSprite(x, y, r->x, r->y, r->w, r->h, transp);
+}
+
+
+/***************************************************************************************
+** Function name:           pushEntry
+** Description:             Render an entry to another Sprite at x, y
+***************************************************************************************/
+bool TFT_eSprite_Atlas::pushEntry(TFT_eSprite *dspr, uint16_t index, int32_t x, int32_t y)
+{
+  if (index >= _entries) return false;
+
+  atlasRect *r = &_entry[index];
+  return _sheet.pushToSprite(dspr, x, y, r->x, r->y, r->w, r->h);
+}
+
+
+/***************************************************************************************
+** Function name:           pushEntry
+** Description:             Render an entry to another Sprite at x, y with transparent colour
+***************************************************************************************/
+bool TFT_eSprite_Atlas::pushEntry(TFT_eSprite *dspr, uint16_t index, int32_t x, int32_t y, uint16_t transp)
+{
+  if (index >= _entries) return false;
+
+  atlasRect *r = &_entry[index];
+  return _sheet.pushToSprite(dspr, x, y, r->x, r->y, r->w, r->h, transp);
+}
@@ -0,0 +1,85 @@
+/***************************************************************************************
+// The following class stores many small images (icons, glyphs, tiles etc.) in a single
+// Sprite, called an atlas or sprite sheet, with a table of the rectangle occupied by
+// each image. This avoids the memory overhead of a separate Sprite per image.
+//
+// Images can be added at runtime, they are packed into rows ("shelves") in the free
+// space of the sheet, or the table can be defined for a sheet that has been drawn or
+// loaded by the sketch. Entries are rendered to the TFT or to another Sprite using
+// the windowed pushSprite() and pushToSprite() functions of the sheet Sprite.
+***************************************************************************************/
+
+// Position and size of an image in the atlas
+typedef struct
+{
+  int16_t x;
+  int16_t y;
+  int16_t w;
+  int16_t h;
+} atlasRect;
+
+class TFT_eSprite_Atlas {
+
+ public:
+
+  explicit TFT_eSprite_Atlas(TFT_eSPI *tft);
+  ~TFT_eSprite_Atlas(void);
+
+           // Create the sheet Sprite of width x height pixels with the given colour depth
+           // and a table for up to maxEntries images. Returns a pointer to the Sprite memory
+           // or nullptr. getSprite()->setPool() can be called first to use a memory pool.
+  void*    createAtlas(int16_t width, int16_t height, uint16_t maxEntries, int8_t bpp = 16);
+
+           // Delete the sheet Sprite and table
+  void     deleteAtlas(void);
+
+           // Returns true if the atlas has been created
+  bool     created(void);
+
+           // Returns a pointer to the sheet Sprite, e.g. to set a palette or draw in the sheet
+  TFT_eSprite* getSprite(void);
+
+           // Remove all entries and fill the sheet with a colour
+  void     clear(uint32_t color = 0);
+
+           // Define an entry for an area already drawn in the sheet, returns the index or -1
+  int16_t  setEntry(int16_t x, int16_t y, int16_t w, int16_t h);
+           // Define entries from a table, returns the number of entries added
+  uint16_t setEntries(const atlasRect *table, uint16_t count);
+
+           // Find free space in the sheet for an image of w x h pixels, returns the index or -1
+           // The area can then be drawn using getSprite() and the getEntry() coordinates
+  int16_t  reserveEntry(int16_t w, int16_t h);
+
+           // Pack an image into the free space, returns the entry index or -1 if there is no space
+           // The data format is as for TFT_eSprite::pushImage()
+  int16_t  addImage(int16_t w, int16_t h, uint16_t *data, uint8_t sbpp = 0);
+  int16_t  addImage(int16_t w, int16_t h, const uint16_t *data);
+
+           // Get the rectangle for an entry, returns false if the index is not valid
+  bool     getEntry(uint16_t index, atlasRect *rect);
+
+           // Number of entries defined
+  uint16_t entries(void);
+
+           // Render an entry to the TFT at x,y, optionally with a transparent colour
+           // (palette index for 4bpp, 0 bits are transparent for 1bpp)
+  bool     pushEntry(uint16_t index, int32_t x, int32_t y);
+  bool     pushEntry(uint16_t index, int32_t x, int32_t y, uint16_t transparent);
+
+           // Render an entry into another Sprite at x,y, optionally with a transparent colour
+  bool     pushEntry(TFT_eSprite *dspr, uint16_t index, int32_t x, int32_t y);
+  bool     pushEntry(TFT_eSprite *dspr, uint16_t index, int32_t x, int32_t y, uint16_t transparent);
+
+ private:
+
+  TFT_eSprite _sheet;    // Sprite holding the images
+
+  atlasRect *_entry;     // Entry table
+  atlasRect *_shelf;     // Shelves used for packing, x is the first free pixel, w is not used
+  uint16_t  _maxEntries; // Table size
+  uint16_t  _entries;    // Entries defined
+  uint16_t  _shelves;    // Shelves in use
+  int16_t   _nextY;      // y coordinate for the next shelf
+  uint8_t   _align;      // x alignment so entries start on a byte boundary (4 and 1 bpp)
+};
@@ -0,0 +1,343 @@
+/***************************************************************************************
+// Memory pool for Sprite frame buffers, see Sprite_pool.h
+***************************************************************************************/
+
+// Each block starts with a 32-bit header holding a check value and the size class
+#define POOL_HEADER   4
+#define POOL_MAGIC    0x5EA10000
+#define POOL_NO_CLASS 0xFF
+
+/***************************************************************************************
+** Function name:           TFT_eSprite_Pool
+** Description:             Class constructor
+***************************************************************************************/
+TFT_eSprite_Pool::TFT_eSprite_Pool(void)
+{
+  _base  = nullptr;
+  _size  = 0;
+  _top   = 0;
+  _psram = false;
+  _generation = 0;
+
+  memset(&_stats, 0, sizeof(_stats));
+  for (uint8_t i = 0; i < POOL_CLASSES; i++) _freeList[i] = nullptr;
+}
+
+
+/***************************************************************************************
+** Function name:           ~TFT_eSprite_Pool
+** Description:             Class destructor
+***************************************************************************************/
+TFT_eSprite_Pool::~TFT_eSprite_Pool(void)
+{
+  end();
+}
+
+
+/***************************************************************************************
+** Function name:           begin
+** Description:             Reserve the pool memory, returns true if successful
+***************************************************************************************/
+bool TFT_eSprite_Pool::begin(uint32_t size, bool psram)
+{
+  if (_base) end();
+
+  size &= ~3UL; // Keep blocks 32-bit aligned for DMA
+  if (size < (1UL << POOL_MIN_SHIFT)) return false;
+
+  _psram = false;
+
+#if defined (ESP32) && defined (CONFIG_SPIRAM_SUPPORT)
+  if (psram && psramFound())
+  {
+    _base = (uint8_t*) ps_malloc(size);
+    _psram = (_base != nullptr);
+  }
+#elif defined(__IMXRT1062__)
+  if (psram && external_psram_size > 0)
+  {
+    _base = (uint8_t*) extmem_malloc(size);
+    _psram = (_base != nullptr);
+  }
+#else
+  psram = psram; // Stop unused parameter warning
+#endif
+
+  // Use internal RAM if PSRAM is not requested or not available
+  if (_base == nullptr) _base = (uint8_t*) malloc(size);
+  if (_base == nullptr) return false;
+
+  _size = size;
+  memset(&_stats, 0, sizeof(_stats));
+  _stats.capacity = size;
+  reset();
+
+  return true;
+}
+
+
+/***************************************************************************************
+** Function name:           end
+** Description:             Release the pool memory
+***************************************************************************************/
+void TFT_eSprite_Pool::end(void)
+{
+  if (_base == nullptr) return;
+
+#if defined(__IMXRT1062__)
+  extmem_free(_base); // Handles both internal and external RAM
+#else
+  free(_base);        // ESP32's free handles PSRAM automatically
+#endif
+
+  _base  = nullptr;
+  _size  = 0;
+  _psram = false;
+  reset();
+  memset(&_stats, 0, sizeof(_stats));
+}
+
+
+/***************************************************************************************
+** Function name:           created
+** Description:             Returns true if the pool has memory reserved
+***************************************************************************************/
+bool TFT_eSprite_Pool::created(void)
+{
+  return _base != nullptr;
+}
+
+
+/***************************************************************************************
+** Function name:           inPSRAM
+** Description:             Returns true if the pool memory is in PSRAM
+***************************************************************************************/
+bool TFT_eSprite_Pool::inPSRAM(void)
+{
+  return _psram;
+}
+
+
+/***************************************************************************************
+** Function name:           sizeClass
+** Description:             Return the smallest size class for a block of size bytes
+***************************************************************************************/
+uint8_t TFT_eSprite_Pool::sizeClass(uint32_t size)
+{
+  if (size < (1UL << POOL_MIN_SHIFT)) size = 1UL << POOL_MIN_SHIFT;
+
+  // Power of 2 range, then quarter within the range rounded up
+  uint8_t  shift = 31 - __builtin_clz(size);
+  uint32_t step  = 1UL << (shift - 2);
+  uint32_t sub   = (size - (1UL << shift) + step - 1) >> (shift - 2);
+
+  if (sub > 3) { shift++; sub = 0; }
+  if (shift >= POOL_MAX_SHIFT) return POOL_NO_CLASS;
+
+  return ((shift - POOL_MIN_SHIFT) << 2) + sub;
+}
+
+
+/***************************************************************************************
+** Function name:           classSize
+** Description:             Return the block size in bytes for a size class
+***************************************************************************************/
+uint32_t TFT_eSprite_Pool::classSize(uint8_t index)
+{
+  uint8_t shift = (index >> 2) + POOL_MIN_SHIFT;
+  return (1UL << shift) + (index & 3) * (1UL << (shift - 2));
+}
+
+
+/***************************************************************************************
+** Function name:           allocate
+** Description:             Allocate a block from the pool, returns nullptr if no space
+***************************************************************************************/
+void* TFT_eSprite_Pool::allocate(uint32_t size, bool clear)
+{
+  if (_base == nullptr || size == 0 || size > _size) { _stats.fails++; return nullptr; }
+
+  uint8_t index = sizeClass(size + POOL_HEADER);
+  if (index == POOL_NO_CLASS) { _stats.fails++; return nullptr; }
+
+  uint8_t* block = nullptr;
+
+  // Reuse a released block of the same class, else a block up to twice the size
+  // if the undivided space is used up. The search is bounded to 5 classes.
+  for (uint8_t i = index; i < index + 5 && i < POOL_CLASSES; i++)
+  {
+    if (_freeList[i])
+    {
+      block = (uint8_t*)_freeList[i];
+      _freeList[i] = *(void**)(block + POOL_HEADER);
+      _stats.cached -= classSize(i);
+      index = i;
+      break;
+    }
+    if (i == index && _top + classSize(index) <= _size) break;
+  }
+
+  uint32_t bsize = classSize(index);
+
+  // Otherwise divide a new block from the free space
+  if (block == nullptr)
+  {
+    if (_top + bsize > _size) { _stats.fails++; return nullptr; }
+    block = _base + _top;
+    _top += bsize;
+    _stats.reserved = _top;
+  }
+
+  *(uint32_t*)block = POOL_MAGIC | index;
+
+  _stats.used += bsize;
+  _stats.blocks++;
+  if (_stats.used > _stats.peak) _stats.peak = _stats.used;
+
+  if (clear) memset(block + POOL_HEADER, 0, size);
+
+  return block + POOL_HEADER;
+}
+
+
+/***************************************************************************************
+** Function name:           release
+** Description:             Return a block to the pool
+***************************************************************************************/
+void TFT_eSprite_Pool::release(void* ptr)
+{
+  if (!contains(ptr)) return;
+
+  uint8_t* block  = (uint8_t*)ptr - POOL_HEADER;
+  uint32_t header = *(uint32_t*)block;
+
+  if ((header & 0xFFFFFF00) != POOL_MAGIC || (header & 0xFF) >= POOL_CLASSES)
+  {
+  #ifdef TFT_eSPI_DEBUG
+    Serial.println("Sprite pool: release of invalid block");
+  #endif
+    return;
+  }
+
+  uint8_t  index = header & 0xFF;
+  uint32_t bsize = classSize(index);
+
+  *(uint32_t*)block = 0; // Catch a second release of the same block
+
+  _stats.used -= bsize;
+  _stats.blocks--;
+
+  // No blocks left so all the pool memory becomes free space again
+  if (_stats.blocks == 0)
+  {
+    for (uint8_t i = 0; i < POOL_CLASSES; i++) _freeList[i] = nullptr;
+    _top = 0;
+    _stats.reserved = 0;
+    _stats.cached   = 0;
+    return;
+  }
+
+  // The last block divided is returned to the free space, others go in a free list
+  if (block + bsize == _base + _top)
+  {
+    _top -= bsize;
+    _stats.reserved = _top;
+  }
+  else
+  {
+    *(void**)(block + POOL_HEADER) = _freeList[index];
+    _freeList[index] = block;
+    _stats.cached += bsize;
+  }
+}
+
+
+/***************************************************************************************
+** Function name:           reset
+** Description:             Release all blocks
+***************************************************************************************/
+void TFT_eSprite_Pool::reset(void)
+{
+  _top = 0;
+  _generation++;
+
+  for (uint8_t i = 0; i < POOL_CLASSES; i++) _freeList[i] = nullptr;
+
+  _stats.used     = 0;
+  _stats.reserved = 0;
+  _stats.cached   = 0;
+  _stats.blocks   = 0;
+}
+
+
+/***************************************************************************************
+** Function name:           generation
+** Description:             Returns the reset count
+***************************************************************************************/
+uint32_t TFT_eSprite_Pool::generation(void)
+{
+  return _generation;
+}
+
+
+/***************************************************************************************
+** Function name:           contains
+** Description:             Returns true if ptr is inside the pool memory
+***************************************************************************************/
+bool TFT_eSprite_Pool::contains(const void* ptr)
+{
+  if (_base == nullptr) return false;
+  const uint8_t* p = (const uint8_t*)ptr;
+  return (p >= _base + POOL_HEADER) && (p < _base + _size);
+}
+
+
+/***************************************************************************************
+** Function name:           getStats
+** Description:             Returns a copy of the pool statistics
+***************************************************************************************/
+poolStats TFT_eSprite_Pool::getStats(void)
+{
+  return _stats;
+}
+
+
+/***************************************************************************************
+** Function name:           resetStats
+** Description:             Clear the peak and fail counters
+***************************************************************************************/
+void TFT_eSprite_Pool::resetStats(void)
+{
+  _stats.peak  = _stats.used;
+  _stats.fails = 0;
+}
+
+
+/***************************************************************************************
+** Function name:           maxAlloc
+** Description:             Bytes in the largest block that can currently be allocated
+***************************************************************************************/
+uint32_t TFT_eSprite_Pool::maxAlloc(void)
+{
+  if (_base == nullptr) return 0;
+
+  uint32_t largest = 0;
+
+  // Largest released block
+  for (int16_t i = POOL_CLASSES - 1; i >= 0; i--)
+  {
+    if (_freeList[i]) { largest = classSize(i); break; }
+  }
+
+  // Largest class that fits in the undivided space
+  uint32_t space = _size - _top;
+  if (space >= (1UL << POOL_MIN_SHIFT))
+  {
+    uint8_t index = sizeClass(space);
+    if (index == POOL_NO_CLASS) index = POOL_CLASSES - 1;
+    else if (classSize(index) > space) index--; // sizeClass() rounds up
+    if (classSize(index) > largest) largest = classSize(index);
+  }
+
+  return (largest > POOL_HEADER) ? largest - POOL_HEADER : 0;
+}
@@ -0,0 +1,87 @@
+/***************************************************************************************
+// The following class provides a memory pool for Sprites. A single block of RAM (or
+// PSRAM) is reserved once and Sprite frame buffers are then carved out of it using
+// segregated size classes, so allocation and release run in constant time and the
+// system heap is not fragmented by Sprites being repeatedly created and deleted.
+//
+// Each power of 2 size range is split into 4 size classes, so no more than 25% of a
+// block is lost to rounding. Released blocks are kept in a free list for their size
+// class and reused by the next request of the same class. reset() releases all blocks
+// at once, e.g. when a new screen is drawn.
+***************************************************************************************/
+
+// Size class range, smallest block is 16 bytes, largest is 16MB
+#define POOL_MIN_SHIFT    4
+#define POOL_MAX_SHIFT   24
+#define POOL_CLASSES     ((POOL_MAX_SHIFT - POOL_MIN_SHIFT) * 4)
+
+// Memory pool statistics
+typedef struct
+{
+  uint32_t capacity;  // Size of the pool in bytes
+  uint32_t used;      // Bytes in allocated blocks (including block header and rounding)
+  uint32_t peak;      // Highest value of used since begin() or resetStats()
+  uint32_t reserved;  // Bytes of the pool that have been divided into blocks
+  uint32_t cached;    // Bytes in released blocks held in the free lists
+  uint32_t blocks;    // Number of allocated blocks
+  uint32_t fails;     // Number of failed allocation requests since begin() or resetStats()
+} poolStats;
+
+class TFT_eSprite_Pool {
+
+ public:
+
+  TFT_eSprite_Pool(void);
+  ~TFT_eSprite_Pool(void);
+
+           // Reserve size bytes for the pool, in PSRAM if psram is true and PSRAM is available
+           // Returns true if the memory was reserved
+  bool     begin(uint32_t size, bool psram = false);
+
+           // Release the pool memory back to the heap, any Sprites using the pool must be deleted first
+  void     end(void);
+
+           // Returns true if the pool has memory reserved
+  bool     created(void);
+
+           // Returns true if the pool memory is in PSRAM
+  bool     inPSRAM(void);
+
+           // Allocate a block of size bytes, cleared to zero if clear is true
+           // Returns nullptr if the pool cannot supply the block
+  void*    allocate(uint32_t size, bool clear = false);
+           // Return a block to the pool, ptr must have been allocated by this pool
+  void     release(void* ptr);
+
+           // Release all blocks in one step. Sprites allocated before the reset must
+           // not be drawn to, deleteSprite() can still be called on them safely.
+  void     reset(void);
+
+           // Incremented by each reset() so stale allocations can be detected
+  uint32_t generation(void);
+
+           // Returns true if ptr is inside the pool memory
+  bool     contains(const void* ptr);
+
+           // Get the pool statistics, clear the peak and fail counters
+  poolStats getStats(void);
+  void     resetStats(void);
+
+           // Bytes in the largest block that can currently be allocated
+  uint32_t maxAlloc(void);
+
+ private:
+
+  uint8_t  sizeClass(uint32_t size);    // Return the smallest class that can hold size bytes
+  uint32_t classSize(uint8_t index);    // Return the block size for a class
+
+  uint8_t  *_base;       // Pool memory
+  uint32_t _size;        // Pool size in bytes
+  uint32_t _top;         // Offset of the first byte not yet divided into blocks
+  uint32_t _generation;  // Incremented on reset()
+  bool     _psram;       // Pool memory is in PSRAM
+
+  poolStats _stats;
+
+  void*    _freeList[POOL_CLASSES]; // Head of the released block list for each size class
+};
@@ -0,0 +1,280 @@
+/***************************************************************************************
+// Scrolling text terminal, see Terminal.h
+***************************************************************************************/
+
+/***************************************************************************************
+** Function name:           TFT_eTerminal
+** Description:             Class constructor
+***************************************************************************************/
+TFT_eTerminal::TFT_eTerminal(TFT_eSPI *tft) : _spr(tft)
+{
+  _tft = tft;
+
+  _started  = false;
+  _hwScroll = false;
+  _full     = false;
+
+  _font = 2;
+  _fg   = TFT_WHITE;
+  _bg   = TFT_BLACK;
+
+  _top    = 0;
+  _width  = 0;
+  _lineH  = 0;
+  _lines  = 0;
+  _slot   = 0;
+  _scroll = 0;
+  _x      = 0;
+
+  _lineLen = nullptr;
+
+  _utfLen  = 0;
+  _utfNeed = 0;
+}
+
+
+/***************************************************************************************
+** Function name:           ~TFT_eTerminal
+** Description:             Class destructor
+***************************************************************************************/
+TFT_eTerminal::~TFT_eTerminal(void)
+{
+  end();
+}
+
+
+/***************************************************************************************
+** Function name:           begin
+** Description:             Start the terminal, returns false if it cannot be created
+***************************************************************************************/
+bool TFT_eTerminal::begin(uint16_t top, uint16_t bottom, uint8_t font, uint8_t bpp)
+{
+  if (_started) end();
+
+  _font  = font;
+  _lineH = _tft->fontHeight(font);
+  if (_lineH == 0) return false;
+
+  int32_t h = _tft->height() - top - bottom;
+  _lines = h / _lineH;
+  if (_lines < 1) return false;
+
+  _top   = top;
+  _width = _tft->width();
+
+  // Any lines left over are added to the bottom fixed area so a scroll is a whole text line
+  bottom = _tft->height() - top - _lines * _lineH;
+
+  _hwScroll = (_tft->getRotation() == 0) && _tft->setScrollArea(top, bottom);
+
+  if (_hwScroll)
+  {
+    _lineLen = (uint16_t*)calloc(_lines, sizeof(uint16_t));
+    if (_lineLen == nullptr)
+    {
+      _tft->setScrollArea(0, 0);
+      return false;
+    }
+  }
+  else
+  {
+    _spr.setColorDepth(bpp);
+    if (_spr.createSprite(_width, _lines * _lineH) == nullptr) return false;
+  }
+
+  _started = true;
+  clear();
+
+  return true;
+}
+
+
+/***************************************************************************************
+** Function name:           end
+** Description:             Stop the terminal and release memory
+***************************************************************************************/
+void TFT_eTerminal::end(void)
+{
+  if (!_started) return;
+
+  if (_hwScroll)
+  {
+    _tft->setScrollArea(0, 0);
+    _tft->setScrollStart(0);
+  }
+
+  if (_lineLen) free(_lineLen);
+  _lineLen = nullptr;
+
+  _spr.deleteSprite();
+
+  _started  = false;
+  _hwScroll = false;
+}
+
+
+/***************************************************************************************
+** Function name:           setTextColor
+** Description:             Set the text foreground and background colours
+***************************************************************************************/
+void TFT_eTerminal::setTextColor(uint16_t fgcolor, uint16_t bgcolor)
+{
+  _fg = fgcolor;
+  _bg = bgcolor;
+}
+
+
+/***************************************************************************************
+** Function name:           clear
+** Description:             Clear the terminal area and move to the top line
+***************************************************************************************/
+void TFT_eTerminal::clear(void)
+{
+  if (!_started) return;
+
+  _x      = 0;
+  _slot   = 0;
+  _scroll = 0;
+  _full   = false;
+  _utfLen = 0;
+
+  if (_hwScroll)
+  {
+    for (uint16_t i = 0; i < _lines; i++) _lineLen[i] = 0;
+    _tft->setScrollStart(_top);
+    _tft->fillRect(0, _top, _width, _lines * _lineH, _bg);
+  }
+  else
+  {
+    _spr.fillSprite(_bg);
+    _spr.setScrollRect(0, 0, _width, _lines * _lineH, _bg);
+    _spr.pushSprite(0, _top);
+  }
+}
+
+
+/***************************************************************************************
+** Function name:           hardwareScroll
+** Description:             Returns true if hardware scrolling is used
+***************************************************************************************/
+bool TFT_eTerminal::hardwareScroll(void)
+{
+  return _hwScroll;
+}
+
+
+/***************************************************************************************
+** Function name:           lines
+** Description:             Returns the number of text lines
+***************************************************************************************/
+uint16_t TFT_eTerminal::lines(void)
+{
+  return _lines;
+}
+
+
+/***************************************************************************************
+** Function name:           clearLine
+** Description:             Clear the text in a line (hardware scroll only)
+***************************************************************************************/
+void TFT_eTerminal::clearLine(uint16_t slot)
+{
+  // Only the part of the line that has text needs to be cleared
+  if (_lineLen[slot]) _tft->fillRect(0, _top + slot * _lineH, _lineLen[slot], _lineH, _bg);
+  _lineLen[slot] = 0;
+}
+
+
+/***************************************************************************************
+** Function name:           newLine
+** Description:             Start a new line, scroll if all lines have been used
+***************************************************************************************/
+void TFT_eTerminal::newLine(void)
+{
+  _x = 0;
+
+  if (!_full)
+  {
+    if (++_slot < _lines) return;
+    _full = true;
+    _slot = _lines - 1;
+  }
+
+  if (_hwScroll)
+  {
+    // The oldest line becomes the new bottom line, so clear it and move the scroll start
+    _slot = _scroll;
+    clearLine(_slot);
+    if (++_scroll >= _lines) _scroll = 0;
+    _tft->setScrollStart(_top + _scroll * _lineH);
+  }
+  else
+  {
+    _spr.scroll(0, -_lineH);
+    _spr.pushSprite(0, _top);
+  }
+}
+
+
+/***************************************************************************************
+** Function name:           write
+** Description:             Print stream support, draws a character and moves the cursor
+***************************************************************************************/
+size_t TFT_eTerminal::write(uint8_t c)
+{
+  if (!_started) return 0;
+
+  if (c == '\n') { newLine(); return 1; }
+  if (c == '\r') { _x = 0;    return 1; }
+
+  // Collect the bytes of a UTF-8 encoded character
+  if (_utfLen == 0)
+  {
+    if      (c >= 0xF0) _utfNeed = 3;
+    else if (c >= 0xE0) _utfNeed = 2;
+    else if (c >= 0xC0) _utfNeed = 1;
+    else                _utfNeed = 0;
+  }
+  _utf[_utfLen++] = c;
+  if (_utfLen <= _utfNeed) return 1;
+  _utf[_utfLen] = 0;
+
+  uint16_t index = 0;
+  uint16_t uniCode = _tft->decodeUTF8((uint8_t*)_utf, &index, _utfLen);
+  _utfLen = 0;
+
+  if (uniCode < 32) return 1;
+
+  // Wrap to a new line if the character will not fit, characters are drawn at size 1
+  uint8_t ts = _tft->textsize;
+  _tft->textsize = 1;
+  int16_t cw = _tft->textWidth(_utf, _font);
+  _tft->textsize = ts;
+  if (_x + cw > _width) newLine();
+
+  int32_t y = _slot * _lineH;
+
+  if (_hwScroll)
+  {
+    // Draw with the terminal colours then restore the TFT settings
+    uint32_t fg = _tft->textcolor, bg = _tft->textbgcolor;
+    _tft->setTextColor(_fg, _bg);
+    _tft->setTextSize(1);
+
+    _x += _tft->drawChar(uniCode, _x, _top + y, _font);
+
+    _tft->setTextColor(fg, bg);
+    _tft->setTextSize(ts);
+
+    if (_x > (int32_t)_lineLen[_slot]) _lineLen[_slot] = _x;
+  }
+  else
+  {
+    _spr.setTextColor(_fg, _bg);
+    int32_t x = _x;
+    _x += _spr.drawChar(uniCode, _x, y, _font);
+    _spr.pushSprite(x, _top + y, x, y, _x - x, _lineH);
+  }
+
+  return 1;
+}
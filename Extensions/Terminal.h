@@ -0,0 +1,70 @@
+/***************************************************************************************
+// The following class provides a scrolling text terminal (log console) on the TFT.
+//
+// Where the display driver supports hardware vertical scrolling (ILI9341, ST7789 and
+// ST7796 in rotation 0) the display is scrolled by changing the controller scroll
+// start address, so a new line only needs the old top line to be cleared and the new
+// text drawn. For other drivers and rotations the text is drawn in a Sprite that is
+// scrolled in RAM and pushed to the screen.
+//
+// The class inherits Print so print() and println() can be used.
+***************************************************************************************/
+
+class TFT_eTerminal : public Print {
+
+ public:
+
+  explicit TFT_eTerminal(TFT_eSPI *tft);
+  ~TFT_eTerminal(void);
+
+           // Start the terminal in the area between the top and bottom fixed areas (in pixels)
+           // using font 1-8. The Sprite fallback uses colour depth bpp (1, 4, 8 or 16).
+           // Returns false if the terminal cannot be created.
+  bool     begin(uint16_t top = 0, uint16_t bottom = 0, uint8_t font = 2, uint8_t bpp = 8);
+
+           // Stop the terminal, the hardware scroll position is reset
+  void     end(void);
+
+           // Set text foreground and background colours
+  void     setTextColor(uint16_t fgcolor, uint16_t bgcolor);
+
+           // Clear the terminal area and move to the top line
+  void     clear(void);
+
+           // Returns true if hardware scrolling is used
+  bool     hardwareScroll(void);
+
+           // Returns the number of text lines
+  uint16_t lines(void);
+
+           // Print stream support, '\n' starts a new line and '\r' returns to the line start
+  size_t   write(uint8_t c);
+
+ private:
+
+  void     newLine(void);                    // Start a new line, scroll if needed
+  void     clearLine(uint16_t slot);         // Clear a text line (hardware scroll only)
+
+  TFT_eSPI    *_tft;
+  TFT_eSprite  _spr;      // Sprite used if hardware scrolling is not available
+
+  bool     _started;      // begin() has run
+  bool     _hwScroll;     // Hardware scrolling is in use
+  bool     _full;         // All lines have been used so new lines scroll
+
+  uint8_t  _font;         // Font number
+  uint16_t _fg, _bg;      // Text colours
+
+  int32_t  _top;          // Screen y coordinate of the top of the terminal area
+  int32_t  _width;        // Terminal width in pixels
+  uint16_t _lineH;        // Line height in pixels
+  uint16_t _lines;        // Number of lines
+  uint16_t _slot;         // Memory line being written to (hardware scroll line order)
+  uint16_t _scroll;       // Memory line shown at the top of the terminal area
+  int32_t  _x;            // Cursor x coordinate
+
+  uint16_t *_lineLen;     // Pixel length of text in each line, limits the clearing needed
+
+  char     _utf[5];       // UTF-8 character being received
+  uint8_t  _utfLen, _utfNeed;
+};
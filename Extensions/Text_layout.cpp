@@ -0,0 +1,160 @@
+/***************************************************************************************
+// Text layout glyph run, see Text_layout.h
+// The layoutString() and drawLayout() functions are in TFT_eSPI.cpp
+***************************************************************************************/
+
+/***************************************************************************************
+** Function name:           TFT_eTextLayout
+** Description:             Class constructor
+***************************************************************************************/
+TFT_eTextLayout::TFT_eTextLayout(void)
+{
+  _glyphs  = nullptr;
+  _size    = 0;
+  _created = false;
+
+  invalidate();
+}
+
+
+/***************************************************************************************
+** Function name:           TFT_eTextLayout
+** Description:             Class constructor for a buffer provided by the sketch
+***************************************************************************************/
+TFT_eTextLayout::TFT_eTextLayout(layoutGlyph *buffer, uint16_t size)
+{
+  _glyphs  = buffer;
+  _size    = buffer ? size : 0;
+  _created = false;
+
+  invalidate();
+}
+
+
+/***************************************************************************************
+** Function name:           ~TFT_eTextLayout
+** Description:             Class destructor
+***************************************************************************************/
+TFT_eTextLayout::~TFT_eTextLayout(void)
+{
+  deleteLayout();
+}
+
+
+/***************************************************************************************
+** Function name:           createLayout
+** Description:             Allocate a buffer for size glyphs
+***************************************************************************************/
+bool TFT_eTextLayout::createLayout(uint16_t size)
+{
+  deleteLayout();
+
+  if (size == 0) return false;
+
+  _glyphs = (layoutGlyph*)malloc(size * sizeof(layoutGlyph));
+  if (_glyphs == nullptr) return false;
+
+  _size    = size;
+  _created = true;
+
+  return true;
+}
+
+
+/***************************************************************************************
+** Function name:           deleteLayout
+** Description:             Delete an allocated buffer
+***************************************************************************************/
+void TFT_eTextLayout::deleteLayout(void)
+{
+  if (_created) free(_glyphs);
+
+  _glyphs  = nullptr;
+  _size    = 0;
+  _created = false;
+
+  invalidate();
+}
+
+
+/***************************************************************************************
+** Function name:           invalidate
+** Description:             Force the next layoutString() to decode the string
+***************************************************************************************/
+void TFT_eTextLayout::invalidate(void)
+{
+  _valid   = false;
+  _count   = 0;
+  _width   = 0;
+  _height  = 0;
+  _advance = 0;
+  _hash    = 0;
+  _bytes   = 0;
+  _fontRef = nullptr;
+  _font    = 0;
+  _textsize = 0;
+  _digits  = false;
+  _utf8    = false;
+}
+
+
+/***************************************************************************************
+** Function name:           valid
+** Description:             Returns true if the layout has been set up
+***************************************************************************************/
+bool TFT_eTextLayout::valid(void)
+{
+  return _valid;
+}
+
+
+/***************************************************************************************
+** Function name:           length
+** Description:             Returns the number of glyphs
+***************************************************************************************/
+uint16_t TFT_eTextLayout::length(void)
+{
+  return _count;
+}
+
+
+/***************************************************************************************
+** Function name:           width
+** Description:             Returns the string width in pixels
+***************************************************************************************/
+int16_t TFT_eTextLayout::width(void)
+{
+  return _width;
+}
+
+
+/***************************************************************************************
+** Function name:           height
+** Description:             Returns the font height in pixels
+***************************************************************************************/
+int16_t TFT_eTextLayout::height(void)
+{
+  return _height;
+}
+
+
+/***************************************************************************************
+** Function name:           advance
+** Description:             Returns the sum of the glyph advances in pixels
+***************************************************************************************/
+int16_t TFT_eTextLayout::advance(void)
+{
+  return _advance;
+}
+
+
+/***************************************************************************************
+** Function name:           getGlyph
+** Description:             Returns a glyph entry or nullptr
+***************************************************************************************/
+const layoutGlyph* TFT_eTextLayout::getGlyph(uint16_t index)
+{
+  if (!_valid || index >= _count) return nullptr;
+
+  return &_glyphs[index];
+}
@@ -0,0 +1,78 @@
+/***************************************************************************************
+// The following class holds a string that has been decoded into a run of glyphs by
+// TFT_eSPI::layoutString(). Each glyph entry has the Unicode point, the glyph index in
+// the font and the x position of the glyph relative to the start of the string. The
+// string width, advance and height are found in the same pass.
+//
+// TFT_eSPI::drawLayout() positions the run using the text datum and padding settings
+// and draws it, so the string is only decoded once. drawString() uses a temporary
+// layout, a sketch can keep a layout to redraw a string: layoutString() does not
+// decode the string again if the string, font and text size are unchanged.
+***************************************************************************************/
+
+// Glyphs in the layout used by drawString(), longer strings are drawn in chunks
+#define DRAW_STRING_GLYPHS 64
+
+// Glyph in a layout
+typedef struct
+{
+  uint16_t code;    // Unicode point
+  uint16_t index;   // Glyph index in the font
+  int16_t  x;       // x position relative to the start of the string (scaled by text size)
+  int16_t  kern;    // Kerning adjustment included in x (smooth fonts)
+} layoutGlyph;
+
+class TFT_eTextLayout { friend class TFT_eSPI; // TFT_eSPI creates and draws the layout
+
+ public:
+
+  TFT_eTextLayout(void);
+
+           // Use a glyph buffer provided by the sketch (no memory is allocated)
+  TFT_eTextLayout(layoutGlyph *buffer, uint16_t size);
+
+  ~TFT_eTextLayout(void);
+
+           // Allocate a buffer for strings of up to size glyphs, returns false if the
+           // allocation fails
+  bool     createLayout(uint16_t size);
+
+           // Delete an allocated buffer
+  void     deleteLayout(void);
+
+           // Force the next layoutString() to decode the string
+  void     invalidate(void);
+
+           // Returns true if layoutString() has set up the layout
+  bool     valid(void);
+
+           // Layout information, all in pixels and including text size scaling
+  uint16_t length(void);    // Number of glyphs
+  int16_t  width(void);     // String width, as returned by textWidth()
+  int16_t  height(void);    // Font height
+  int16_t  advance(void);   // Distance to the start of the next string
+
+           // Returns a glyph entry, or nullptr if index is out of range
+  const layoutGlyph* getGlyph(uint16_t index);
+
+ private:
+
+  layoutGlyph *_glyphs;     // Glyph buffer
+  uint16_t _size;           // Glyph buffer capacity
+  bool     _created;        // Buffer allocated by createLayout()
+  bool     _valid;          // Layout has been set up
+
+  uint16_t _count;          // Number of glyphs
+  int16_t  _width;          // String width
+  int16_t  _height;         // Font height
+  int16_t  _advance;        // Sum of the glyph advances
+
+  // Used to check the layout is for the current string and font
+  uint32_t _hash;           // Hash of the string bytes
+  uint16_t _bytes;          // String length in bytes
+  const void *_fontRef;     // Free font or smooth font used
+  uint8_t  _font;           // Font number
+  uint8_t  _textsize;       // Text size
+  bool     _digits;         // String was laid out as a number
+  bool     _utf8;           // UTF-8 decoding was enabled
+};
@@ -22,9 +22,10 @@
 // The touch controller has a low SPI clock rate
 inline void TFT_eSPI::begin_touch_read_write(void){
   DMA_BUSY_CHECK;
+  BUS_CLOSE_DEFERRED; // End a TFT transaction left open
   CS_H; // Just in case it has been left low
   #if defined (SPI_HAS_TRANSACTION) && defined (SUPPORT_TRANSACTIONS)
-    if (locked) {locked = false; spi.beginTransaction(SPISettings(SPI_TOUCH_FREQUENCY, MSBFIRST, SPI_MODE0));}
+    if (locked) {BUS_ACQUIRE(BUS_TOUCH); locked = false; spi.beginTransaction(SPISettings(SPI_TOUCH_FREQUENCY, MSBFIRST, SPI_MODE0));}
   #else
     spi.setFrequency(SPI_TOUCH_FREQUENCY);
   #endif
@@ -39,9 +40,9 @@ inline void TFT_eSPI::begin_touch_read_write(void){
 inline void TFT_eSPI::end_touch_read_write(void){
   T_CS_H;
   #if defined (SPI_HAS_TRANSACTION) && defined (SUPPORT_TRANSACTIONS)
-    if(!inTransaction) {if (!locked) {locked = true; spi.endTransaction();}}
+    if(!inTransaction) {if (!locked) {locked = true; spi.endTransaction(); BUS_RELEASE(BUS_TOUCH);}}
   #else
-    spi.setFrequency(SPI_FREQUENCY);
+    spi.setFrequency(_spiWriteFreq);
   #endif
   //SET_BUS_WRITE_MODE;
 }
@@ -0,0 +1,226 @@
+/***************************************************************************************
+// Bus trace capture, see Trace.h
+***************************************************************************************/
+
+#ifdef TFT_TRACE
+
+/***************************************************************************************
+** Function name:           TFT_eTrace
+** Description:             Class constructor
+***************************************************************************************/
+TFT_eTrace::TFT_eTrace(TFT_eSPI *tft)
+{
+  _tft        = tft;
+  _out        = nullptr;
+  _buffer     = nullptr;
+  _bufferSize = 0;
+  _count      = 0;
+  _size       = 0;
+  _time       = 0;
+}
+
+
+/***************************************************************************************
+** Function name:           ~TFT_eTrace
+** Description:             Class destructor
+***************************************************************************************/
+TFT_eTrace::~TFT_eTrace(void)
+{
+  end();
+}
+
+
+/***************************************************************************************
+** Function name:           begin
+** Description:             Start recording to a sink
+***************************************************************************************/
+bool TFT_eTrace::begin(Print &out, uint16_t size)
+{
+  end();
+
+  if (size < 32) size = 32;
+
+  uint32_t clock = _tft->getSPIWriteFrequency();
+
+  _buffer = (uint8_t*)malloc(size);
+  if (_buffer == nullptr) return false;
+
+  _out        = &out;
+  _bufferSize = size;
+  _count      = 0;
+  _size       = 0;
+  _time       = micros();
+
+  // Header
+  put8('T'); put8('F'); put8('T'); put8('T');
+  put8(TRACE_VERSION);
+  put8(_tft->getRotation());
+  put16(_tft->width());
+  put16(_tft->height());
+  put16(clock);
+  put16(clock >> 16);
+
+  _tft->setTrace(this);
+
+  return true;
+}
+
+
+/***************************************************************************************
+** Function name:           end
+** Description:             Stop recording
+***************************************************************************************/
+void TFT_eTrace::end(void)
+{
+  if (_buffer == nullptr) return;
+
+  _tft->setTrace(nullptr);
+  flush();
+
+  free(_buffer);
+  _buffer = nullptr;
+  _out    = nullptr;
+}
+
+
+/***************************************************************************************
+** Function name:           frame
+** Description:             Mark the end of a frame and write the buffer to the sink
+***************************************************************************************/
+void TFT_eTrace::frame(void)
+{
+  if (_buffer == nullptr) return;
+
+  record(TRACE_FRAME);
+  flush();
+}
+
+
+/***************************************************************************************
+** Function name:           flush
+** Description:             Write the buffered records to the sink
+***************************************************************************************/
+void TFT_eTrace::flush(void)
+{
+  if (_count == 0) return;
+
+  _out->write(_buffer, _count);
+  _count = 0;
+}
+
+
+/***************************************************************************************
+** Function name:           size
+** Description:             Returns the number of bytes recorded
+***************************************************************************************/
+uint32_t TFT_eTrace::size(void)
+{
+  return _size;
+}
+
+
+/***************************************************************************************
+** Function name:           command, data, window, pixel, block, pixels, dma, read
+** Description:             Record a bus operation
+***************************************************************************************/
+void TFT_eTrace::command(uint16_t c)
+{
+  record(TRACE_COMMAND);
+  putVar(c);
+}
+
+void TFT_eTrace::data(uint8_t d)
+{
+  record(TRACE_DATA);
+  put8(d);
+}
+
+void TFT_eTrace::window(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint8_t flags)
+{
+  record(TRACE_WINDOW);
+  put8(flags);
+  putVar((uint16_t)x0);
+  putVar((uint16_t)y0);
+  putVar((uint16_t)x1);
+  putVar((uint16_t)y1);
+}
+
+void TFT_eTrace::pixel(int32_t x, int32_t y, uint16_t color, uint8_t flags)
+{
+  record(TRACE_PIXEL);
+  put8(flags);
+  putVar((uint16_t)x);
+  putVar((uint16_t)y);
+  put16(color);
+}
+
+void TFT_eTrace::block(uint16_t color, uint32_t len)
+{
+  record(TRACE_BLOCK);
+  put16(color);
+  putVar(len);
+}
+
+void TFT_eTrace::pixels(uint32_t len)
+{
+  record(TRACE_PIXELS);
+  putVar(len);
+}
+
+void TFT_eTrace::dma(uint32_t len)
+{
+  record(TRACE_DMA);
+  putVar(len);
+}
+
+void TFT_eTrace::read(uint32_t len)
+{
+  record(TRACE_READ);
+  putVar(len);
+}
+
+
+/***************************************************************************************
+** Function name:           record
+** Description:             Start a record with the time since the last record
+***************************************************************************************/
+void TFT_eTrace::record(uint8_t type)
+{
+  uint32_t now = micros();
+
+  // Keep a whole record in the buffer (largest is 1 + 5 + 1 + 4 * 3 bytes)
+  if (_count + 24 > _bufferSize) flush();
+
+  put8(type);
+  putVar(now - _time);
+  _time = now;
+}
+
+
+/***************************************************************************************
+** Function name:           put8, put16, putVar
+** Description:             Add a value to the buffer
+***************************************************************************************/
+void TFT_eTrace::put8(uint8_t val)
+{
+  if (_count >= _bufferSize) flush();
+  _buffer[_count++] = val;
+  _size++;
+}
+
+void TFT_eTrace::put16(uint16_t val)
+{
+  put8(val);
+  put8(val >> 8);
+}
+
+void TFT_eTrace::putVar(uint32_t val)
+{
+  while (val > 0x7F) {
+    put8((val & 0x7F) | 0x80);
+    val >>= 7;
+  }
+  put8(val);
+}
+
+#endif
@@ -0,0 +1,118 @@
+/***************************************************************************************
+// The following class records the commands and pixel data sent to the TFT so that a
+// sketch can be analysed offline (see Tools/Trace_analyzer). TFT_TRACE must be defined
+// in the setup file to compile the trace points in the library.
+//
+// Each bus operation is stored as a compact record with the time since the previous
+// record. Commands and data bytes are stored in full, address windows are stored with
+// flags showing if the column and row commands were sent, and pixel transfers are
+// stored as a pixel count (block fills also store the colour). Records are collected
+// in a buffer and written to a Print class sink such as Serial, a File or a network
+// client when the buffer is full or when frame() or flush() is called.
+//
+// The sink must not use the TFT SPI bus while a TFT transaction is open. For an SD
+// card on the same bus use a buffer large enough for a frame and call frame() at the
+// end of each frame, when no transaction is open.
+//
+// Trace format, all values are little endian:
+//   Header: "TFTT", version, rotation, width (16 bit), height (16 bit), SPI clock (32 bit)
+//   Record: type (8 bit), time since the previous record in microseconds (varint), then
+//     TRACE_COMMAND : command (varint)
+//     TRACE_DATA    : data (8 bit)
+//     TRACE_WINDOW  : flags (8 bit), x0, y0, x1, y1 (varint)
+//     TRACE_PIXEL   : flags (8 bit), x, y (varint), colour (16 bit)
+//     TRACE_BLOCK   : colour (16 bit), pixel count (varint)
+//     TRACE_PIXELS  : pixel count (varint)
+//     TRACE_DMA     : pixel count (varint)
+//     TRACE_READ    : pixel count (varint)
+//     TRACE_FRAME   : no data
+//   Window flags: bit 0 = column address sent, bit 1 = row address sent
+//   A varint holds 7 bits per byte, least significant first, bit 7 set if more follow
+***************************************************************************************/
+
+#define TRACE_VERSION 1
+
+// Record types
+#define TRACE_COMMAND 1
+#define TRACE_DATA    2
+#define TRACE_WINDOW  3
+#define TRACE_PIXEL   4
+#define TRACE_BLOCK   5
+#define TRACE_PIXELS  6
+#define TRACE_DMA     7
+#define TRACE_READ    8
+#define TRACE_FRAME   9
+
+#ifdef TFT_TRACE
+
+class TFT_eTrace {
+
+ public:
+
+  explicit TFT_eTrace(TFT_eSPI *tft);
+  ~TFT_eTrace(void);
+
+           // Start recording to out, records are collected in a buffer of size bytes.
+           // Returns false if the buffer cannot be allocated.
+  bool     begin(Print &out, uint16_t size = 512);
+
+           // Stop recording, buffered records are written to the sink
+  void     end(void);
+
+           // Mark the end of a frame and write the buffered records to the sink
+  void     frame(void);
+
+           // Write the buffered records to the sink
+  void     flush(void);
+
+           // Returns the number of trace bytes recorded
+  uint32_t size(void);
+
+           // Record functions called by TFT_eSPI
+  void     command(uint16_t c);
+  void     data(uint8_t d);
+  void     window(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint8_t flags);
+  void     pixel(int32_t x, int32_t y, uint16_t color, uint8_t flags);
+  void     block(uint16_t color, uint32_t len);
+  void     pixels(uint32_t len);
+  void     dma(uint32_t len);
+  void     read(uint32_t len);
+
+ private:
+
+  void     record(uint8_t type);    // Start a record
+  void     put8(uint8_t val);
+  void     put16(uint16_t val);
+  void     putVar(uint32_t val);
+
+  TFT_eSPI *_tft;
+  Print    *_out;                   // Sink
+  uint8_t  *_buffer;                // Record buffer
+  uint16_t  _bufferSize;
+  uint16_t  _count;                 // Bytes in the buffer
+  uint32_t  _size;                  // Bytes recorded
+  uint32_t  _time;                  // Time of the last record
+};
+
+// Trace points used by TFT_eSPI, coordinates are TFT RAM coordinates
+#define TRACE_CMD(C)              if (_trace) _trace->command(C)
+#define TRACE_DAT(D)              if (_trace) _trace->data(D)
+#define TRACE_WIN(X0, Y0, X1, Y1) if (_trace) _trace->window((X0) + colstart, (Y0) + rowstart, (X1) + colstart, (Y1) + rowstart, 3)
+#define TRACE_PIX(X, Y, C)        if (_trace) _trace->pixel(X, Y, C, (addr_col != (X)) | ((addr_row != (Y)) << 1))
+#define TRACE_BLK(C, L)           if (_trace) _trace->block(C, L)
+#define TRACE_PIXS(L)             if (_trace) _trace->pixels(L)
+#define TRACE_DMAS(L)             if (_trace) _trace->dma(L)
+#define TRACE_RD(L)               if (_trace) _trace->read(L)
+
+#else
+
+#define TRACE_CMD(C)
+#define TRACE_DAT(D)
+#define TRACE_WIN(X0, Y0, X1, Y1)
+#define TRACE_PIX(X, Y, C)
+#define TRACE_BLK(C, L)
+#define TRACE_PIXS(L)
+#define TRACE_DMAS(L)
+#define TRACE_RD(L)
+
+#endif
@@ -0,0 +1,39 @@
+// Smooth font tables compiled into a sketch, see Tools/Compile_font.
+// To use a font #include the header made by font2table.py after TFT_eSPI.h and pass
+// the smoothFont struct to loadFont(). The metrics are used in place, so loading the
+// font does not allocate memory or parse the font data.
+
+#ifndef _SMOOTHFONT_H_
+#define _SMOOTHFONT_H_
+
+#ifdef SMOOTH_FONT
+
+typedef struct { // Data stored for FONT AS A WHOLE, the glyph arrays are sorted by Unicode
+  uint16_t gCount;              // Number of glyphs
+  uint16_t yAdvance;            // Line advance
+  uint16_t spaceWidth;          // Width of a space character
+  int16_t  ascent;              // Height of top of 'd' above baseline
+  int16_t  descent;             // Offset to bottom of 'p'
+  uint16_t maxAscent;           // Maximum ascent found in font
+  uint16_t maxDescent;          // Maximum descent found in font
+
+  const uint16_t *unicode;      // Glyph Unicode, in ascending order
+  const uint8_t  *height;       // Glyph bitmap height
+  const uint8_t  *width;        // Glyph bitmap width
+  const uint8_t  *xAdvance;     // Cursor advance
+  const int16_t  *dY;           // Baseline to top of bitmap
+  const int8_t   *dX;           // Cursor to left of bitmap
+  const uint32_t *bitmapOffset; // Offset of glyph bitmap in bitmap
+  const uint8_t  *format;       // Glyph bitmap format (VLW_ALPHA_8, VLW_ALPHA_4 or VLW_ALPHA_RLE)
+  const uint8_t  *bitmap;       // Glyph bitmaps, concatenated (PROGMEM)
+  uint32_t bitmapSize;          // Size of bitmap in bytes
+
+  const uint8_t  *kerning;      // Kerning pairs in the vlw extended table format (PROGMEM)
+  uint16_t kerningCount;
+  const uint8_t  *ligature;     // Ligatures in the vlw extended table format (PROGMEM)
+  uint16_t ligatureCount;
+} smoothFont;
+
+#endif // SMOOTH_FONT
+
+#endif // _SMOOTHFONT_H_
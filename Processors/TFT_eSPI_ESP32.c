@@ -30,6 +30,19 @@
 #ifdef ESP32_DMA
   // DMA SPA handle
   spi_device_handle_t dmaHAL;
+  // Ring of queued transactions, a transaction is re-used after its result has been collected
+  spi_transaction_t dmaTrans[DMA_QUEUE_SIZE];
+  uint8_t dmaTransIndex = 0;
+  // Colour buffer for block fills, every fill transaction points at this buffer
+  uint16_t* dmaFillBuffer = nullptr;
+  uint16_t  dmaFillColor  = 0;
+  // Bounce buffers for images in PSRAM, allocated when first used
+  uint16_t* dmaBounce[DMA_BOUNCE_BUFFERS] = { nullptr };
+  uint32_t  dmaBounceSeq[DMA_BOUNCE_BUFFERS];  // Transaction that last read each buffer
+  uint8_t   dmaBounceNext = 0;                 // Next buffer to fill
+  // Number of transactions collected, a transaction queued when dmaDone + spiBusyCheck
+  // is n is complete when dmaDone reaches n
+  uint32_t  dmaDone = 0;
   #ifdef CONFIG_IDF_TARGET_ESP32
     #define DMA_CHANNEL 1
     #ifdef USE_HSPI_PORT
@@ -174,6 +187,7 @@ void TFT_eSPI::gpioMode(uint8_t gpio, uint8_t mode)
 ***************************************************************************************/
 void TFT_eSPI::pushBlock(uint16_t color, uint32_t len)
 {
+  TRACE_BLK(color, len);
   uint8_t colorBin[] = { (uint8_t) (color >> 8), (uint8_t) color };
   if(len) spi.writePattern(&colorBin[0], 2, 1); len--;
   while(len--) {WR_L; WR_H;}
@@ -185,6 +199,7 @@ void TFT_eSPI::pushBlock(uint16_t color, uint32_t len)
 ***************************************************************************************/
 void TFT_eSPI::pushPixels(const void* data_in, uint32_t len)
 {
+  TRACE_PIXS(len);
   uint8_t *data = (uint8_t*)data_in;
 
   if(_swapBytes) {
@@ -206,6 +221,7 @@ void TFT_eSPI::pushPixels(const void* data_in, uint32_t len)
 ***************************************************************************************/
 /*
 void TFT_eSPI::pushBlock(uint16_t color, uint32_t len){
+  TRACE_BLK(color, len);
 
   uint32_t color32 = (color<<8 | color >>8)<<16 | (color<<8 | color >>8);
   bool empty = true;
@@ -253,6 +269,7 @@ void TFT_eSPI::pushBlock(uint16_t color, uint32_t len){
 //*/
 //*
 void TFT_eSPI::pushBlock(uint16_t color, uint32_t len){
+  TRACE_BLK(color, len);
 
   volatile uint32_t* spi_w = _spi_w;
   uint32_t color32 = (color<<8 | color >>8)<<16 | (color<<8 | color >>8);
@@ -369,6 +386,7 @@ void TFT_eSPI::pushSwapBytePixels(const void* data_in, uint32_t len){
 ** Description:             Write a sequence of pixels
 ***************************************************************************************/
 void TFT_eSPI::pushPixels(const void* data_in, uint32_t len){
+  TRACE_PIXS(len);
 
   if(_swapBytes) {
     pushSwapBytePixels(data_in, len);
@@ -424,6 +442,7 @@ void TFT_eSPI::pushPixels(const void* data_in, uint32_t len){
 ***************************************************************************************/
 void TFT_eSPI::pushBlock(uint16_t color, uint32_t len)
 {
+  TRACE_BLK(color, len);
   // Split out the colours
   uint32_t r = (color & 0xF800)>>8;
   uint32_t g = (color & 0x07E0)<<5;
@@ -493,6 +512,7 @@ void TFT_eSPI::pushBlock(uint16_t color, uint32_t len)
 ** Description:             Write a sequence of pixels
 ***************************************************************************************/
 void TFT_eSPI::pushPixels(const void* data_in, uint32_t len){
+  TRACE_PIXS(len);
 
   uint16_t *data = (uint16_t*)data_in;
   // ILI9488 write macro is not endianess dependant, hence !_swapBytes
@@ -520,6 +540,7 @@ void TFT_eSPI::pushSwapBytePixels(const void* data_in, uint32_t len){
 ** Description:             Write a block of pixels of the same colour
 ***************************************************************************************/
 void TFT_eSPI::pushBlock(uint16_t color, uint32_t len){
+  TRACE_BLK(color, len);
   #if defined (SSD1963_DRIVER)
   if ( ((color & 0xF800)>> 8) == ((color & 0x07E0)>> 3) && ((color & 0xF800)>> 8)== ((color & 0x001F)<< 3) )
   #else
@@ -555,6 +576,7 @@ void TFT_eSPI::pushSwapBytePixels(const void* data_in, uint32_t len){
 ** Description:             Write a sequence of pixels
 ***************************************************************************************/
 void TFT_eSPI::pushPixels(const void* data_in, uint32_t len){
+  TRACE_PIXS(len);
 
   uint16_t *data = (uint16_t*)data_in;
   if(_swapBytes) { while ( len-- ) {tft_Write_16(*data); data++; } }
@@ -584,7 +606,7 @@ bool TFT_eSPI::dmaBusy(void)
   for (int i = 0; i < checks; ++i)
   {
     ret = spi_device_get_trans_result(dmaHAL, &rtrans, 0);
-    if (ret == ESP_OK) spiBusyCheck--;
+    if (ret == ESP_OK) { spiBusyCheck--; dmaDone++; }
   }
 
   //Serial.print("spiBusyCheck=");Serial.println(spiBusyCheck);
@@ -607,10 +629,207 @@ void TFT_eSPI::dmaWait(void)
     ret = spi_device_get_trans_result(dmaHAL, &rtrans, portMAX_DELAY);
     assert(ret == ESP_OK);
   }
+  dmaDone += spiBusyCheck;
   spiBusyCheck = 0;
 }
 
 
+/***************************************************************************************
+** Function name:           dmaNextTrans
+** Description:             Get the next free transaction in the queue ring
+***************************************************************************************/
+// If the queue is full this waits for the oldest transaction to complete
+static spi_transaction_t* dmaNextTrans(uint8_t* busy)
+{
+  if (*busy >= DMA_QUEUE_SIZE) {
+    spi_transaction_t *rtrans;
+    esp_err_t ret = spi_device_get_trans_result(dmaHAL, &rtrans, portMAX_DELAY);
+    assert(ret == ESP_OK);
+    (*busy)--;
+    dmaDone++;
+  }
+
+  spi_transaction_t *trans = &dmaTrans[dmaTransIndex];
+  if (++dmaTransIndex >= DMA_QUEUE_SIZE) dmaTransIndex = 0;
+
+  memset(trans, 0, sizeof(spi_transaction_t));
+
+  return trans;
+}
+
+
+/***************************************************************************************
+** Function name:           dmaQueueBytes
+** Description:             Queue up to 4 command or data bytes
+***************************************************************************************/
+// The bytes are held in the transaction, dc_callback() sets the DC line
+static void dmaQueueBytes(uint8_t* busy, bool dc, uint32_t data, uint8_t bytes)
+{
+  spi_transaction_t *trans = dmaNextTrans(busy);
+
+  trans->user = (void *)(uintptr_t)dc;
+  trans->flags = SPI_TRANS_USE_TXDATA;
+  trans->length = bytes * 8;
+  for (uint8_t i = 0; i < bytes; i++) trans->tx_data[i] = data >> (8 * (bytes - 1 - i));
+
+  esp_err_t ret = spi_device_queue_trans(dmaHAL, trans, portMAX_DELAY);
+  assert(ret == ESP_OK);
+
+  (*busy)++;
+}
+
+
+/***************************************************************************************
+** Function name:           dmaQueuePixels
+** Description:             Queue a block of pixels (len must be less than 32767)
+***************************************************************************************/
+static void dmaQueuePixels(uint8_t* busy, const uint16_t* image, uint32_t len)
+{
+  spi_transaction_t *trans = dmaNextTrans(busy);
+
+  trans->user = (void *)1;
+  trans->tx_buffer = image;  //Data pointer
+  trans->length = len * 16;  //Data length, in bits
+  trans->flags = 0;          //SPI_TRANS_USE_TXDATA flag
+
+  esp_err_t ret = spi_device_queue_trans(dmaHAL, trans, portMAX_DELAY);
+  assert(ret == ESP_OK);
+
+  (*busy)++;
+}
+
+
+/***************************************************************************************
+** Function name:           dmaWaitFor
+** Description:             Wait until transaction number seq is complete
+***************************************************************************************/
+static void dmaWaitFor(uint8_t* busy, uint32_t seq)
+{
+  spi_transaction_t *rtrans;
+
+  while (((int32_t)(seq - dmaDone) > 0) && *busy) {
+    esp_err_t ret = spi_device_get_trans_result(dmaHAL, &rtrans, portMAX_DELAY);
+    assert(ret == ESP_OK);
+    (*busy)--;
+    dmaDone++;
+  }
+}
+
+
+/***************************************************************************************
+** Function name:           dmaBounceAlloc
+** Description:             Allocate the bounce buffers, returns false on failure
+***************************************************************************************/
+static bool dmaBounceAlloc(void)
+{
+  if (dmaBounce[0]) return true;
+
+  for (uint8_t i = 0; i < DMA_BOUNCE_BUFFERS; i++) {
+    dmaBounce[i] = (uint16_t*)heap_caps_malloc(DMA_BOUNCE_SIZE * 2, MALLOC_CAP_DMA);
+    dmaBounceSeq[i] = dmaDone;
+    if (dmaBounce[i] == nullptr) {
+      while (i--) { heap_caps_free(dmaBounce[i]); dmaBounce[i] = nullptr; }
+      return false;
+    }
+  }
+
+  dmaBounceNext = 0;
+  return true;
+}
+
+
+/***************************************************************************************
+** Function name:           dmaQueueBounce
+** Description:             Queue an image through the bounce buffers
+***************************************************************************************/
+// The image rows are stride pixels apart. Each buffer is filled with the next pixels
+// once the transfer that last read it is complete, so the copy runs while the previous
+// buffer is being sent.
+static void dmaQueueBounce(uint8_t* busy, const uint16_t* image, int32_t w, int32_t h, int32_t stride, bool swap)
+{
+  uint8_t  b = dmaBounceNext;
+  uint32_t n = 0; // Pixels in buffer b
+
+  for (int32_t yb = 0; yb < h; yb++) {
+    const uint16_t* src = image + yb * stride;
+    int32_t xb = 0;
+
+    while (xb < w) {
+      if (n == 0) dmaWaitFor(busy, dmaBounceSeq[b]);
+
+      uint32_t run = w - xb;
+      if (run > DMA_BOUNCE_SIZE - n) run = DMA_BOUNCE_SIZE - n;
+
+      uint16_t* dst = dmaBounce[b] + n;
+      if (swap) {
+        for (uint32_t i = 0; i < run; i++) dst[i] = src[xb + i] << 8 | src[xb + i] >> 8;
+      }
+      else memcpy(dst, src + xb, run * 2);
+
+      n  += run;
+      xb += run;
+
+      if (n == DMA_BOUNCE_SIZE) {
+        dmaQueuePixels(busy, dmaBounce[b], n);
+        dmaBounceSeq[b] = dmaDone + *busy;
+        if (++b >= DMA_BOUNCE_BUFFERS) b = 0;
+        n = 0;
+      }
+    }
+  }
+
+  if (n) {
+    dmaQueuePixels(busy, dmaBounce[b], n);
+    dmaBounceSeq[b] = dmaDone + *busy;
+    if (++b >= DMA_BOUNCE_BUFFERS) b = 0;
+  }
+
+  dmaBounceNext = b;
+}
+
+
+/***************************************************************************************
+** Function name:           dmaQueueWindow
+** Description:             Queue the commands that set the window for the pixels
+***************************************************************************************/
+// Same as setAddrWindow() but the commands are sent by the SPI driver after any queued
+// transactions, so the CPU does not have to wait for DMA to complete
+void TFT_eSPI::dmaQueueWindow(int32_t x, int32_t y, int32_t w, int32_t h)
+{
+#if defined (ILI9225_DRIVER) || defined (SSD1351_DRIVER) || defined (RPI_DISPLAY_TYPE)
+  // Window commands for these displays are not queued
+  dmaWait();
+  setAddrWindow(x, y, w, h);
+#else
+  TRACE_WIN(x, y, x + w - 1, y + h - 1);
+  if (_shadowColor) shadowUnknown(x, y, x + w - 1, y + h - 1);
+
+  int32_t x0 = x, y0 = y, x1 = x + w - 1, y1 = y + h - 1;
+
+  #if defined (SSD1963_DRIVER)
+    if ((rotation & 0x1) == 0) { transpose(x0, y0); transpose(x1, y1); }
+  #endif
+
+  #ifdef CGRAM_OFFSET
+    x0+=colstart;
+    x1+=colstart;
+    y0+=rowstart;
+    y1+=rowstart;
+  #endif
+
+  dmaQueueBytes(&spiBusyCheck, false, TFT_CASET, 1);
+  dmaQueueBytes(&spiBusyCheck, true,  (uint32_t)x0 << 16 | x1, 4);
+  dmaQueueBytes(&spiBusyCheck, false, TFT_PASET, 1);
+  dmaQueueBytes(&spiBusyCheck, true,  (uint32_t)y0 << 16 | y1, 4);
+  dmaQueueBytes(&spiBusyCheck, false, TFT_RAMWR, 1);
+
+  // Window set by the CPU is no longer valid
+  addr_row = 0xFFFF;
+  addr_col = 0xFFFF;
+#endif
+}
+
+
 /***************************************************************************************
 ** Function name:           pushPixelsDMA
 ** Description:             Push pixels to TFT (len must be less than 32767)
@@ -626,20 +845,8 @@ void TFT_eSPI::pushPixelsDMA(uint16_t* image, uint32_t len)
     for (uint32_t i = 0; i < len; i++) (image[i] = image[i] << 8 | image[i] >> 8);
   }
 
-  esp_err_t ret;
-  static spi_transaction_t trans;
-
-  memset(&trans, 0, sizeof(spi_transaction_t));
-
-  trans.user = (void *)1;
-  trans.tx_buffer = image;  //finally send the line data
-  trans.length = len * 16;        //Data length, in bits
-  trans.flags = 0;                //SPI_TRANS_USE_TXDATA flag
-
-  ret = spi_device_queue_trans(dmaHAL, &trans, portMAX_DELAY);
-  assert(ret == ESP_OK);
-
-  spiBusyCheck++;
+  TRACE_DMAS(len);
+  dmaQueuePixels(&spiBusyCheck, image, len);
 }
 
 
@@ -654,24 +861,11 @@ void TFT_eSPI::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t
 
   uint32_t len = w*h;
 
-  dmaWait();
-
-  setAddrWindow(x, y, w, h);
-
-  esp_err_t ret;
-  static spi_transaction_t trans;
-
-  memset(&trans, 0, sizeof(spi_transaction_t));
-
-  trans.user = (void *)1;
-  trans.tx_buffer = image;   //Data pointer
-  trans.length = len * 16;   //Data length, in bits
-  trans.flags = 0;           //SPI_TRANS_USE_TXDATA flag
-
-  ret = spi_device_queue_trans(dmaHAL, &trans, portMAX_DELAY);
-  assert(ret == ESP_OK);
-
-  spiBusyCheck++;
+  // Window and pixels are queued, the last DMA is only waited for by default
+  if (!_dmaQueue) dmaWait();
+  dmaQueueWindow(x, y, w, h);
+  TRACE_DMAS(len);
+  dmaQueuePixels(&spiBusyCheck, image, len);
 }
 
 
@@ -684,6 +878,10 @@ void TFT_eSPI::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t
 {
   if ((x >= _vpW) || (y >= _vpH) || (!DMA_Enabled)) return;
 
+  // Only one image is in flight unless the sketch has asked for deep queuing, so the
+  // buffer of the last image can be re-used
+  if (!_dmaQueue) dmaWait();
+
   int32_t dx = 0;
   int32_t dy = 0;
   int32_t dw = w;
@@ -700,8 +898,40 @@ void TFT_eSPI::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t
   uint32_t len = dw*dh;
 
   if (buffer == nullptr) {
+    bool dmaImage = esp_ptr_dma_capable(image);
+
+    // Images with swapped bytes in internal RAM are altered in place below
+    if (!dmaImage || !_swapBytes) {
+      const uint16_t* start = image + dx + w * dy;
+
+      // Rows are sent in place if the DMA can read them, each row must start on a 4 byte
+      // boundary or the SPI driver makes a copy. Rows are contiguous if only the top or
+      // bottom is clipped.
+      if (dmaImage && !((uintptr_t)start & 3) && ((dw == w) || !(w & 1))) {
+        dmaQueueWindow(x, y, dw, dh);
+        TRACE_DMAS(len);
+        if (dw == w) dmaQueuePixels(&spiBusyCheck, start, len);
+        else {
+          for (int32_t yb = 0; yb < dh; yb++) dmaQueuePixels(&spiBusyCheck, start + w * yb, dw);
+        }
+        return;
+      }
+
+      // PSRAM and unaligned images are copied to internal RAM as they are sent
+      if (!dmaBounceAlloc()) {
+        dmaWait();
+        pushImage(x - dx - _xDatum, y - dy - _yDatum, w, h, image);
+        return;
+      }
+      dmaQueueWindow(x, y, dw, dh);
+      TRACE_DMAS(len);
+      dmaQueueBounce(&spiBusyCheck, start, dw, dh, w, _swapBytes);
+      return;
+    }
+
     buffer = image;
-    dmaWait();
+    // Wait if the image will be altered, a queued DMA may still be reading it
+    if ((dw != w) || (dh != h) || _swapBytes) dmaWait();
   }
 
   // If image is clipped, copy pixels into a contiguous block
@@ -730,24 +960,87 @@ void TFT_eSPI::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t
     }
   }
 
-  if (spiBusyCheck) dmaWait(); // In case we did not wait earlier
+  dmaQueueWindow(x, y, dw, dh);
+  TRACE_DMAS(len);
+  dmaQueuePixels(&spiBusyCheck, buffer, len);
+}
 
-  setAddrWindow(x, y, dw, dh);
+/***************************************************************************************
+** Function name:           setDMAQueue
+** Description:             Allow pushImageDMA() to queue images without waiting
+***************************************************************************************/
+void TFT_eSPI::setDMAQueue(bool queue)
+{
+  _dmaQueue = queue;
+}
 
-  esp_err_t ret;
-  static spi_transaction_t trans;
 
-  memset(&trans, 0, sizeof(spi_transaction_t));
+/***************************************************************************************
+** Function name:           pushBlockDMA
+** Description:             Push len pixels of one colour into a window using DMA
+***************************************************************************************/
+// The transactions all read the same colour buffer, so the buffer is only re-filled
+// (after waiting for queued transfers) when the colour changes
+void TFT_eSPI::pushBlockDMA(uint16_t color, uint32_t len)
+{
+  if ((len == 0) || (!DMA_Enabled)) return;
 
-  trans.user = (void *)1;
-  trans.tx_buffer = buffer;  //finally send the line data
-  trans.length = len * 16;   //Data length, in bits
-  trans.flags = 0;           //SPI_TRANS_USE_TXDATA flag
+  // Colour buffer could not be allocated, so fill with the CPU
+  if (dmaFillBuffer == nullptr) {
+    dmaWait();
+    pushBlock(color, len);
+    return;
+  }
 
-  ret = spi_device_queue_trans(dmaHAL, &trans, portMAX_DELAY);
-  assert(ret == ESP_OK);
+  uint16_t swapped = color << 8 | color >> 8;
+
+  if (dmaFillColor != swapped) {
+    dmaWait();
+    for (uint32_t i = 0; i < DMA_FILL_SIZE; i++) dmaFillBuffer[i] = swapped;
+    dmaFillColor = swapped;
+  }
+
+  TRACE_BLK(color, len);
 
-  spiBusyCheck++;
+  // If the queue is full dmaNextTrans() waits for the oldest transaction
+  while (len) {
+    uint32_t n = (len > DMA_FILL_SIZE) ? DMA_FILL_SIZE : len;
+    dmaQueuePixels(&spiBusyCheck, dmaFillBuffer, n);
+    len -= n;
+  }
+}
+
+
+/***************************************************************************************
+** Function name:           fillRectDMA
+** Description:             Fill a rectangle using DMA, returns before the fill is complete
+***************************************************************************************/
+void TFT_eSPI::fillRectDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color)
+{
+  if (_vpOoB || !DMA_Enabled) return;
+
+  x+= _xDatum;
+  y+= _yDatum;
+
+  // Clipping
+  if ((x >= _vpW) || (y >= _vpH)) return;
+
+  if (x < _vpX) { w += x - _vpX; x = _vpX; }
+  if (y < _vpY) { h += y - _vpY; y = _vpY; }
+
+  if ((x + w) > _vpW) w = _vpW - x;
+  if ((y + h) > _vpH) h = _vpH - y;
+
+  if ((w < 1) || (h < 1)) return;
+
+  // Only fill the tiles that are not known to be the colour
+  if (_shadowColor && !shadowFill(x, y, w, h, color)) return;
+
+  // Window and pixels are queued, so there is no need to wait for the last DMA
+  dmaQueueWindow(x, y, w, h);
+  pushBlockDMA(color, w * h);
+
+  if (_shadowColor) shadowSolid(x, y, w, h, color);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////
@@ -815,12 +1108,12 @@ bool TFT_eSPI::initDMA(bool ctrl_cs)
     .duty_cycle_pos = 0,
     .cs_ena_pretrans = 0,
     .cs_ena_posttrans = 0,
-    .clock_speed_hz = SPI_FREQUENCY,
+    .clock_speed_hz = (int)_spiWriteFreq,
     .input_delay_ns = 0,
     .spics_io_num = pin,
     .flags = SPI_DEVICE_NO_DUMMY, //0,
-    .queue_size = 1,
-    .pre_cb = 0, //dc_callback, //Callback to handle D/C line
+    .queue_size = DMA_QUEUE_SIZE,
+    .pre_cb = dc_callback, //Callback to handle D/C line
     #ifdef CONFIG_IDF_TARGET_ESP32
       .post_cb = 0
     #else
@@ -832,8 +1125,14 @@ bool TFT_eSPI::initDMA(bool ctrl_cs)
   ret = spi_bus_add_device(spi_host, &devcfg, &dmaHAL);
   ESP_ERROR_CHECK(ret);
 
+  // Fill buffer must be in DMA capable memory, pushBlockDMA() uses the CPU if this fails
+  dmaFillBuffer = (uint16_t*)heap_caps_malloc(DMA_FILL_SIZE * 2, MALLOC_CAP_DMA);
+  dmaFillColor = 0;
+  if (dmaFillBuffer) memset(dmaFillBuffer, 0, DMA_FILL_SIZE * 2);
+
   DMA_Enabled = true;
   spiBusyCheck = 0;
+  dmaTransIndex = 0;
   return true;
 }
 
@@ -844,8 +1143,15 @@ bool TFT_eSPI::initDMA(bool ctrl_cs)
 void TFT_eSPI::deInitDMA(void)
 {
   if (!DMA_Enabled) return;
+  dmaWait();
   spi_bus_remove_device(dmaHAL);
   spi_bus_free(spi_host);
+  if (dmaFillBuffer) heap_caps_free(dmaFillBuffer);
+  dmaFillBuffer = nullptr;
+  for (uint8_t i = 0; i < DMA_BOUNCE_BUFFERS; i++) {
+    if (dmaBounce[i]) heap_caps_free(dmaBounce[i]);
+    dmaBounce[i] = nullptr;
+  }
   DMA_Enabled = false;
 }
 
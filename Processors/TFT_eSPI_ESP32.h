@@ -11,6 +11,12 @@
 // Include processor specific header
 #include "soc/spi_reg.h"
 #include "driver/spi_master.h"
+#include "esp_heap_caps.h"
+#if __has_include("esp_memory_utils.h")
+  #include "esp_memory_utils.h"
+#else
+  #include "soc/soc_memory_layout.h"
+#endif
 #include "hal/gpio_ll.h"
 
 #if !defined(CONFIG_IDF_TARGET_ESP32C3) && !defined(CONFIG_IDF_TARGET_ESP32S2) && !defined(CONFIG_IDF_TARGET_ESP32)
@@ -119,8 +125,27 @@ SPI3_HOST = 2
 // Code to check if DMA is busy, used by SPI bus transaction transaction and endWrite functions
 #if !defined(TFT_PARALLEL_8_BIT) && !defined(SPI_18BIT_DRIVER)
   #define ESP32_DMA
+  // DMA block fills and queued transfers are available, see TFT_eSPI_ESP32.c
+  #define ESP32_DMA_QUEUE
   // Code to check if DMA is busy, used by SPI DMA + transaction + endWrite functions
   #define DMA_BUSY_CHECK  dmaWait()
+  // Number of SPI transactions that can be queued, each pushImageDMA() uses 6 (5 for the
+  // window commands and 1 for the pixels). Maximum 255.
+  #ifndef DMA_QUEUE_SIZE
+    #define DMA_QUEUE_SIZE 48
+  #endif
+  // Pixels in the colour buffer used by pushBlockDMA(), each fill transaction sends up to
+  // this many pixels, so a 320x480 screen fill uses 38 transactions with the default size
+  #ifndef DMA_FILL_SIZE
+    #define DMA_FILL_SIZE 4096
+  #endif
+  // Internal RAM buffers used to send images held in PSRAM, DMA_BOUNCE_SIZE pixels each
+  #ifndef DMA_BOUNCE_BUFFERS
+    #define DMA_BOUNCE_BUFFERS 2
+  #endif
+  #ifndef DMA_BOUNCE_SIZE
+    #define DMA_BOUNCE_SIZE 2048
+  #endif
 #else
   #define DMA_BUSY_CHECK
 #endif
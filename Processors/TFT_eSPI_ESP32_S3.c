@@ -157,6 +157,7 @@ void TFT_eSPI::gpioMode(uint8_t gpio, uint8_t mode)
 ***************************************************************************************/
 void TFT_eSPI::pushBlock(uint16_t color, uint32_t len)
 {
+  TRACE_BLK(color, len);
   uint8_t colorBin[] = { (uint8_t) (color >> 8), (uint8_t) color };
   if(len) spi.writePattern(&colorBin[0], 2, 1); len--;
   while(len--) {WR_L; WR_H;}
@@ -168,6 +169,7 @@ void TFT_eSPI::pushBlock(uint16_t color, uint32_t len)
 ***************************************************************************************/
 void TFT_eSPI::pushPixels(const void* data_in, uint32_t len)
 {
+  TRACE_PIXS(len);
   uint8_t *data = (uint8_t*)data_in;
 
   if(_swapBytes) {
@@ -189,6 +191,7 @@ void TFT_eSPI::pushPixels(const void* data_in, uint32_t len)
 ***************************************************************************************/
 /*
 void TFT_eSPI::pushBlock(uint16_t color, uint32_t len){
+  TRACE_BLK(color, len);
 
   uint32_t color32 = (color<<8 | color >>8)<<16 | (color<<8 | color >>8);
   bool empty = true;
@@ -236,6 +239,7 @@ void TFT_eSPI::pushBlock(uint16_t color, uint32_t len){
 //*/
 //*
 void TFT_eSPI::pushBlock(uint16_t color, uint32_t len){
+  TRACE_BLK(color, len);
 
   volatile uint32_t* spi_w = _spi_w;
   uint32_t color32 = (color<<8 | color >>8)<<16 | (color<<8 | color >>8);
@@ -372,6 +376,7 @@ void TFT_eSPI::pushSwapBytePixels(const void* data_in, uint32_t len){
 ** Description:             Write a sequence of pixels
 ***************************************************************************************/
 void TFT_eSPI::pushPixels(const void* data_in, uint32_t len){
+  TRACE_PIXS(len);
 
   if(_swapBytes) {
     pushSwapBytePixels(data_in, len);
@@ -435,6 +440,7 @@ void TFT_eSPI::pushPixels(const void* data_in, uint32_t len){
 ***************************************************************************************/
 void TFT_eSPI::pushBlock(uint16_t color, uint32_t len)
 {
+  TRACE_BLK(color, len);
   // Split out the colours
   uint32_t r = (color & 0xF800)>>8;
   uint32_t g = (color & 0x07E0)<<5;
@@ -511,6 +517,7 @@ void TFT_eSPI::pushBlock(uint16_t color, uint32_t len)
 ** Description:             Write a sequence of pixels
 ***************************************************************************************/
 void TFT_eSPI::pushPixels(const void* data_in, uint32_t len){
+  TRACE_PIXS(len);
 
   uint16_t *data = (uint16_t*)data_in;
   // ILI9488 write macro is not endianess dependant, hence !_swapBytes
@@ -538,6 +545,7 @@ void TFT_eSPI::pushSwapBytePixels(const void* data_in, uint32_t len){
 ** Description:             Write a block of pixels of the same colour
 ***************************************************************************************/
 void TFT_eSPI::pushBlock(uint16_t color, uint32_t len){
+  TRACE_BLK(color, len);
   if ( (color >> 8) == (color & 0x00FF) )
   { if (!len) return;
     tft_Write_16(color);
@@ -569,6 +577,7 @@ void TFT_eSPI::pushSwapBytePixels(const void* data_in, uint32_t len){
 ** Description:             Write a sequence of pixels
 ***************************************************************************************/
 void TFT_eSPI::pushPixels(const void* data_in, uint32_t len){
+  TRACE_PIXS(len);
 
   uint16_t *data = (uint16_t*)data_in;
   if(_swapBytes) { while ( len-- ) {tft_Write_16(*data); data++; } }
@@ -652,6 +661,8 @@ void TFT_eSPI::pushPixelsDMA(uint16_t* image, uint32_t len)
   }
   _swapBytes = temp;
 
+  TRACE_DMAS(len);
+
   esp_err_t ret;
   static spi_transaction_t trans;
 
@@ -696,6 +707,8 @@ void TFT_eSPI::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t
   }
   _swapBytes = temp;
 
+  TRACE_DMAS(len);
+
   esp_err_t ret;
   static spi_transaction_t trans;
 
@@ -784,6 +797,8 @@ void TFT_eSPI::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t
   }
   _swapBytes = temp;
 
+  TRACE_DMAS(len);
+
   esp_err_t ret;
   static spi_transaction_t trans;
 
@@ -863,7 +878,7 @@ bool TFT_eSPI::initDMA(bool ctrl_cs)
     .duty_cycle_pos = 0,
     .cs_ena_pretrans = 0,
     .cs_ena_posttrans = 0,
-    .clock_speed_hz = SPI_FREQUENCY,
+    .clock_speed_hz = (int)_spiWriteFreq,
     .input_delay_ns = 0,
     .spics_io_num = pin,
     .flags = SPI_DEVICE_NO_DUMMY, //0,
@@ -70,6 +70,16 @@
 #ifdef RP2040_DMA
   int32_t            dma_tx_channel;
   dma_channel_config dma_tx_config;
+
+  // Control channel, loads the data channel with the next image row from a list of
+  // control blocks (transfer count then read address) so a clipped image is not compacted
+  int32_t            dma_ctrl_channel;
+  uint32_t*          dma_ctrl_blocks = nullptr;
+  int32_t            dma_ctrl_rows   = 0;
+
+  // Set when a transfer starts, cleared by the DMA completion interrupt
+  volatile bool      dma_running  = false;
+  void             (*dma_callback)(void) = nullptr;
 #endif
 
 ////////////////////////////////////////////////////////////////////////////////////////
@@ -264,6 +274,7 @@ void pioinit(uint16_t clock_div, uint16_t fract_div) {
 // PIO handles pixel block fill writes
 void TFT_eSPI::pushBlock(uint16_t color, uint32_t len)
 {
+  TRACE_BLK(color, len);
 #if  defined (SPI_18BIT_DRIVER) || (defined (SSD1963_DRIVER) && defined (TFT_PARALLEL_8_BIT))
   uint32_t col = ((color & 0xF800)<<8) | ((color & 0x07E0)<<5) | ((color & 0x001F)<<3);
   if (len) {
@@ -286,6 +297,7 @@ void TFT_eSPI::pushBlock(uint16_t color, uint32_t len)
 
 #else
 void TFT_eSPI::pushBlock(uint16_t color, uint32_t len){
+  TRACE_BLK(color, len);
 
   while (len > 4) {
     // 5 seems to be the optimum for maximum transfer rate
@@ -312,6 +324,7 @@ void TFT_eSPI::pushBlock(uint16_t color, uint32_t len){
 ** Description:             Write a sequence of pixels
 ***************************************************************************************/
 void TFT_eSPI::pushPixels(const void* data_in, uint32_t len){
+  TRACE_PIXS(len);
 #if  defined (SPI_18BIT_DRIVER) || (defined (SSD1963_DRIVER) && defined (TFT_PARALLEL_8_BIT))
   uint16_t *data = (uint16_t*)data_in;
   if (_swapBytes) {
@@ -440,6 +453,7 @@ uint8_t TFT_eSPI::readByte(void)
 ** Description:             Write a block of pixels of the same colour
 ***************************************************************************************/
 void TFT_eSPI::pushBlock(uint16_t color, uint32_t len){
+  TRACE_BLK(color, len);
 
   if(len) { tft_Write_16(color); len--; }
   while(len--) {WR_L; WR_H;}
@@ -451,6 +465,7 @@ void TFT_eSPI::pushBlock(uint16_t color, uint32_t len){
 ***************************************************************************************/
 void TFT_eSPI::pushPixels(const void* data_in, uint32_t len)
 {
+  TRACE_PIXS(len);
   uint16_t *data = (uint16_t*)data_in;
 
   if (_swapBytes) while ( len-- ) {tft_Write_16S(*data); data++;}
@@ -467,6 +482,7 @@ void TFT_eSPI::pushPixels(const void* data_in, uint32_t len)
 ***************************************************************************************/
 void TFT_eSPI::pushBlock(uint16_t color, uint32_t len)
 {
+  TRACE_BLK(color, len);
   uint16_t r = (color & 0xF800)>>8;
   uint16_t g = (color & 0x07E0)>>3;
   uint16_t b = (color & 0x001F)<<3;
@@ -499,6 +515,7 @@ void TFT_eSPI::pushBlock(uint16_t color, uint32_t len)
 ** Description:             Write a sequence of pixels
 ***************************************************************************************/
 void TFT_eSPI::pushPixels(const void* data_in, uint32_t len){
+  TRACE_PIXS(len);
 
   uint16_t *data = (uint16_t*)data_in;
   if (_swapBytes) {
@@ -524,6 +541,7 @@ void TFT_eSPI::pushPixels(const void* data_in, uint32_t len){
 ** Description:             Write a block of pixels of the same colour
 ***************************************************************************************/
 void TFT_eSPI::pushBlock(uint16_t color, uint32_t len){
+  TRACE_BLK(color, len);
   while(len--)
   {
     while (!spi_is_writable(SPI_X)){};
@@ -536,6 +554,7 @@ void TFT_eSPI::pushBlock(uint16_t color, uint32_t len){
 ** Description:             Write a sequence of pixels
 ***************************************************************************************/
 void TFT_eSPI::pushPixels(const void* data_in, uint32_t len){
+  TRACE_PIXS(len);
   uint16_t *data = (uint16_t*)data_in;
   if (_swapBytes) {
     while(len--)
@@ -570,6 +589,30 @@ These are created in header file:
   dma_channel_config dma_tx_config;
 */
 
+/***************************************************************************************
+** Function name:           dma_irq_handler
+** Description:             DMA completion interrupt, clears the DMA run flag
+***************************************************************************************/
+// The data channel raises the interrupt at the end of a single transfer, or at the end
+// of a row chain (the channel is in IRQ quiet mode so rows do not interrupt)
+static void dma_irq_handler(void)
+{
+  if (!(dma_hw->ints0 & (1u << dma_tx_channel))) return; // Shared handler, not our channel
+  dma_hw->ints0 = 1u << dma_tx_channel;
+
+  dma_running = false;
+  if (dma_callback) dma_callback();
+}
+
+/***************************************************************************************
+** Function name:           setDMACallback
+** Description:             Set a function to be called when a DMA transfer completes
+***************************************************************************************/
+void TFT_eSPI::setDMACallback(void (*callback)(void))
+{
+  dma_callback = callback;
+}
+
 /***************************************************************************************
 ** Function name:           dmaBusy
 ** Description:             Check if DMA is busy
@@ -577,7 +620,7 @@ These are created in header file:
 bool TFT_eSPI::dmaBusy(void) {
   if (!DMA_Enabled) return false;
 
-  if (dma_channel_is_busy(dma_tx_channel)) return true;
+  if (dma_running) return true;
 
 #if !defined (RP2040_PIO_INTERFACE)
   // For SPI must also wait for FIFO to flush and reset format
@@ -594,7 +637,7 @@ bool TFT_eSPI::dmaBusy(void) {
 ***************************************************************************************/
 void TFT_eSPI::dmaWait(void)
 {
-  while (dma_channel_is_busy(dma_tx_channel));
+  while (dma_running) tight_loop_contents();
 
 #if !defined (RP2040_PIO_INTERFACE)
   // For SPI must also wait for FIFO to flush and reset format
@@ -615,6 +658,9 @@ void TFT_eSPI::pushPixelsDMA(uint16_t* image, uint32_t len)
 
   channel_config_set_bswap(&dma_tx_config, !_swapBytes);
 
+  TRACE_DMAS(len);
+
+  dma_running = true;
 #if !defined (RP2040_PIO_INTERFACE)
   dma_channel_configure(dma_tx_channel, &dma_tx_config, &spi_get_hw(SPI_X)->dr, (uint16_t*)image, len, true);
 #else
@@ -645,34 +691,72 @@ void TFT_eSPI::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t
   if (dw < 1 || dh < 1) return;
 
   uint32_t len = dw*dh;
+  uint16_t* src = image + dx + w * dy; // First pixel inside the viewport
+  bool rows = false;
 
   if (buffer == nullptr) {
-    buffer = image;
-    dmaWait();
+    dmaWait(); // Control blocks may still be in use
+
+    // Rows are contiguous if only the top and bottom are clipped
+    buffer = src;
+
+    // A clipped image is sent row by row, so it is not compacted
+    if (dw != w) {
+      if (dh <= dma_ctrl_rows) rows = true;
+      else {
+        // Not enough control blocks, so copy pixels into a contiguous block
+        for (int32_t yb = 0; yb < dh; yb++) {
+          memmove((uint8_t*) (image + yb * dw), (uint8_t*) (src + w * yb), dw << 1);
+        }
+        buffer = image;
+      }
+    }
   }
-
-  // If image is clipped, copy pixels into a contiguous block
-  if ( (dw != w) || (dh != h) ) {
+  // A buffer pointer has been provided, copy the image to the buffer
+  else if ( (dw != w) || (dh != h) ) {
     for (int32_t yb = 0; yb < dh; yb++) {
-      memmove((uint8_t*) (buffer + yb * dw), (uint8_t*) (image + dx + w * (yb + dy)), dw << 1);
+      memcpy((uint8_t*) (buffer + yb * dw), (uint8_t*) (src + w * yb), dw << 1);
     }
   }
-  // else, if a buffer pointer has been provided copy whole image to the buffer
-  else if (buffer != image) {
+  else {
     memcpy(buffer, image, len*2);
   }
 
   dmaWait(); // In case we did not wait earlier
 
   setAddrWindow(x, y, dw, dh);
+  TRACE_DMAS(dw * dh);
 
   channel_config_set_bswap(&dma_tx_config, !_swapBytes);
 
 #if !defined (RP2040_PIO_INTERFACE)
-  dma_channel_configure(dma_tx_channel, &dma_tx_config, &spi_get_hw(SPI_X)->dr, (uint16_t*)buffer, len, true);
+  volatile void* dst = &spi_get_hw(SPI_X)->dr;
 #else
-  dma_channel_configure(dma_tx_channel, &dma_tx_config, &tft_pio->txf[pio_sm], (uint16_t*)buffer, len, true);
+  volatile void* dst = &tft_pio->txf[pio_sm];
 #endif
+
+  dma_running = true;
+
+  if (rows) {
+    // One control block per row, a null block ends the chain
+    uint32_t* block = dma_ctrl_blocks;
+    for (int32_t yb = 0; yb < dh; yb++) {
+      *block++ = dw;
+      *block++ = (uintptr_t)(src + w * yb);
+    }
+    *block++ = 0;
+    *block   = 0;
+
+    // Data channel chains to the control channel at the end of each row, it only
+    // interrupts when the null block is loaded
+    dma_channel_config config = dma_tx_config;
+    channel_config_set_chain_to(&config, dma_ctrl_channel);
+    channel_config_set_irq_quiet(&config, true);
+    dma_channel_configure(dma_tx_channel, &config, dst, nullptr, 0, false);
+
+    dma_channel_set_read_addr(dma_ctrl_channel, dma_ctrl_blocks, true);
+  }
+  else dma_channel_configure(dma_tx_channel, &dma_tx_config, dst, buffer, len, true);
 }
 
 /***************************************************************************************
@@ -698,6 +782,33 @@ bool TFT_eSPI::initDMA(bool ctrl_cs)
   channel_config_set_dreq(&dma_tx_config, pio_get_dreq(tft_pio, pio_sm, true));
 #endif
 
+  // The control channel writes a transfer count and read address (which triggers the
+  // data channel), the write address wraps so every block goes to the same registers
+  dma_ctrl_channel = dma_claim_unused_channel(false);
+
+  if (dma_ctrl_channel < 0) {
+    dma_channel_unclaim(dma_tx_channel);
+    return false;
+  }
+
+  dma_channel_config ctrl_config = dma_channel_get_default_config(dma_ctrl_channel);
+  channel_config_set_transfer_data_size(&ctrl_config, DMA_SIZE_32);
+  channel_config_set_read_increment(&ctrl_config, true);
+  channel_config_set_write_increment(&ctrl_config, true);
+  channel_config_set_ring(&ctrl_config, true, 3); // 2 x 32-bit registers
+  dma_channel_configure(dma_ctrl_channel, &ctrl_config, &dma_hw->ch[dma_tx_channel].al3_transfer_count, nullptr, 2, false);
+
+  // Enough control blocks for a clipped image the height of the screen, if the
+  // allocation fails a clipped image is compacted instead
+  dma_ctrl_rows = (_init_width > _init_height) ? _init_width : _init_height;
+  dma_ctrl_blocks = (uint32_t*)malloc((dma_ctrl_rows + 1) * 2 * sizeof(uint32_t));
+  if (dma_ctrl_blocks == nullptr) dma_ctrl_rows = 0;
+
+  dma_running = false;
+  dma_channel_set_irq0_enabled(dma_tx_channel, true);
+  irq_add_shared_handler(DMA_IRQ_0, dma_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+  irq_set_enabled(DMA_IRQ_0, true);
+
   DMA_Enabled = true;
   return true;
 }
@@ -709,7 +820,14 @@ bool TFT_eSPI::initDMA(bool ctrl_cs)
 void TFT_eSPI::deInitDMA(void)
 {
   if (!DMA_Enabled) return;
+  dmaWait();
+  dma_channel_set_irq0_enabled(dma_tx_channel, false);
+  irq_remove_handler(DMA_IRQ_0, dma_irq_handler);
   dma_channel_unclaim(dma_tx_channel);
+  dma_channel_unclaim(dma_ctrl_channel);
+  free(dma_ctrl_blocks);
+  dma_ctrl_blocks = nullptr;
+  dma_ctrl_rows   = 0;
   DMA_Enabled = false;
 }
 
@@ -16,6 +16,7 @@
 
 // Required for both the official and community board packages
 #include "hardware/dma.h"
+#include "hardware/irq.h"
 #include "hardware/pio.h"
 #include "hardware/clocks.h"
 
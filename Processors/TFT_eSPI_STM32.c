@@ -81,6 +81,7 @@ void TFT_eSPI::end_SDA_Read(void)
 ** Description:             Write a block of pixels of the same colour
 ***************************************************************************************/
 void TFT_eSPI::pushBlock(uint16_t color, uint32_t len){
+  TRACE_BLK(color, len);
     // Loop unrolling improves speed dramatically graphics test  0.634s => 0.374s
     while (len>31) {
     #if !defined (SSD1963_DRIVER)
@@ -126,6 +127,7 @@ void TFT_eSPI::pushBlock(uint16_t color, uint32_t len){
 ** Description:             Write a sequence of pixels
 ***************************************************************************************/
 void TFT_eSPI::pushPixels(const void* data_in, uint32_t len){
+  TRACE_PIXS(len);
 
   uint16_t *data = (uint16_t*)data_in;
 
@@ -266,6 +268,7 @@ uint8_t TFT_eSPI::readByte(void)
 ***************************************************************************************/
 void TFT_eSPI::pushBlock(uint16_t color, uint32_t len)
 {
+  TRACE_BLK(color, len);
   if(len) { tft_Write_16(color); len--; }
   while(len--) {WR_L; WR_H;}
 }
@@ -276,6 +279,7 @@ void TFT_eSPI::pushBlock(uint16_t color, uint32_t len)
 ***************************************************************************************/
 void TFT_eSPI::pushPixels(const void* data_in, uint32_t len)
 {
+  TRACE_PIXS(len);
   uint16_t *data = (uint16_t*)data_in;
 
   if (_swapBytes) while ( len-- ) { tft_Write_16S(*data); data++;}
@@ -293,6 +297,7 @@ void TFT_eSPI::pushPixels(const void* data_in, uint32_t len)
 #define BUF_SIZE 240*3
 void TFT_eSPI::pushBlock(uint16_t color, uint32_t len)
 {
+  TRACE_BLK(color, len);
   //uint8_t col[BUF_SIZE];
   // Always using swapped bytes is a peculiarity of this function...
   //color = color>>8 | color<<8;
@@ -313,6 +318,7 @@ void TFT_eSPI::pushBlock(uint16_t color, uint32_t len)
 ***************************************************************************************/
 void TFT_eSPI::pushPixels(const void* data_in, uint32_t len)
 {
+  TRACE_PIXS(len);
   uint16_t *data = (uint16_t*)data_in;
 
   if(!_swapBytes) {
@@ -348,6 +354,7 @@ void TFT_eSPI::pushPixels(const void* data_in, uint32_t len)
 /*
 void TFT_eSPI::pushBlock(uint16_t color, uint32_t len)
 {
+  TRACE_BLK(color, len);
   uint16_t col[BUF_SIZE];
   // Always using swapped bytes is a peculiarity of this function...
   uint16_t swapColor = color>>8 | color<<8;
@@ -367,6 +374,7 @@ void TFT_eSPI::pushBlock(uint16_t color, uint32_t len)
 }
  //*/
 void TFT_eSPI::pushBlock(uint16_t color, uint32_t len){
+  TRACE_BLK(color, len);
     // Loop unrolling improves speed dramatically graphics test  0.634s => 0.374s
     while (len>31) {
     #if !defined (SSD1963_DRIVER)
@@ -413,6 +421,7 @@ void TFT_eSPI::pushBlock(uint16_t color, uint32_t len){
 ***************************************************************************************/
 void TFT_eSPI::pushPixels(const void* data_in, uint32_t len)
 {
+  TRACE_PIXS(len);
   uint16_t *data = (uint16_t*)data_in;
 
   if(_swapBytes) {
@@ -481,6 +490,7 @@ void TFT_eSPI::pushPixelsDMA(uint16_t* image, uint32_t len)
     for (uint32_t i = 0; i < len; i++) (image[i] = image[i] << 8 | image[i] >> 8);
   }
 
+  TRACE_DMAS(len);
   HAL_SPI_Transmit_DMA(&spiHal, (uint8_t*)image, len << 1);
 }
 
@@ -546,6 +556,7 @@ void TFT_eSPI::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t
   // small transfers are performed using a blocking call until DMA capacity is reached.
   // User sketch can prevent blocking by managing pixel count and splitting into blocks
   // of 32767 pixels maximum. (equivalent to an area of ~320 x 100 pixels)
+  TRACE_DMAS(len);
   while(len>0x7FFF) { // Transfer 16-bit pixels in blocks if len*2 over 65534 bytes
     HAL_SPI_Transmit(&spiHal, (uint8_t*)buffer, 0x800<<1, HAL_MAX_DELAY);
     len -= 0x800; buffer+= 0x800; // Arbitrarily send 1K pixel blocks (2Kbytes)
@@ -53,6 +53,14 @@
 #define TFT_RAMRD   0x2E
 #define TFT_IDXRD   0xDD // ILI9341 only, indexed control register read
 
+#define TFT_VSCRDEF  0x33 // Vertical scrolling definition
+#define TFT_VSCRSADD 0x37 // Vertical scrolling start address
+#if defined (ILI9342_DRIVER)
+  #define TFT_VSCR_LINES 240 // Lines in the controller scroll address range
+#else
+  #define TFT_VSCR_LINES 320
+#endif
+
 #define TFT_MADCTL  0x36
 #define TFT_MAD_MY  0x80
 #define TFT_MAD_MX  0x40
@@ -72,10 +72,12 @@
 ** Description:             Start SPI transaction for writes and select TFT
 ***************************************************************************************/
 inline void TFT_eSPI::begin_tft_write(void){
+  BUS_YIELD;        // Close a deferred transaction if another task needs the bus
   if (locked) {
+    BUS_ACQUIRE(BUS_TFT);
     locked = false; // Flag to show SPI access now unlocked
 #if defined (SPI_HAS_TRANSACTION) && defined (SUPPORT_TRANSACTIONS) && !defined(TFT_PARALLEL_8_BIT) && !defined(RP2040_PIO_INTERFACE)
-    spi.beginTransaction(SPISettings(SPI_FREQUENCY, MSBFIRST, TFT_SPI_MODE));
+    spi.beginTransaction(SPISettings(_spiWriteFreq, MSBFIRST, TFT_SPI_MODE));
 #endif
     CS_L;
     SET_BUS_WRITE_MODE;  // Some processors (e.g. ESP32) allow recycling the tx buffer when rx is not used
@@ -84,10 +86,12 @@ inline void TFT_eSPI::begin_tft_write(void){
 
 // Non-inlined version to permit override
 void TFT_eSPI::begin_nin_write(void){
+  BUS_YIELD;        // Close a deferred transaction if another task needs the bus
   if (locked) {
+    BUS_ACQUIRE(BUS_TFT);
     locked = false; // Flag to show SPI access now unlocked
 #if defined (SPI_HAS_TRANSACTION) && defined (SUPPORT_TRANSACTIONS) && !defined(TFT_PARALLEL_8_BIT) && !defined(RP2040_PIO_INTERFACE)
-    spi.beginTransaction(SPISettings(SPI_FREQUENCY, MSBFIRST, TFT_SPI_MODE));
+    spi.beginTransaction(SPISettings(_spiWriteFreq, MSBFIRST, TFT_SPI_MODE));
 #endif
     CS_L;
     SET_BUS_WRITE_MODE;  // Some processors (e.g. ESP32) allow recycling the tx buffer when rx is not used
@@ -100,7 +104,7 @@ void TFT_eSPI::begin_nin_write(void){
 ***************************************************************************************/
 inline void TFT_eSPI::end_tft_write(void){
   if(!inTransaction) {      // Flag to stop ending transaction during multiple graphics calls
-    if (!locked) {          // Locked when beginTransaction has been called
+    if (!locked && !BUS_KEEP_OPEN) { // Locked when beginTransaction has been called
       locked = true;        // Flag to show SPI access now locked
       SPI_BUSY_CHECK;       // Check send complete and clean out unused rx data
       CS_H;
@@ -108,6 +112,7 @@ inline void TFT_eSPI::end_tft_write(void){
 #if defined (SPI_HAS_TRANSACTION) && defined (SUPPORT_TRANSACTIONS) && !defined(TFT_PARALLEL_8_BIT) && !defined(RP2040_PIO_INTERFACE)
       spi.endTransaction();
 #endif
+      BUS_RELEASE(BUS_TFT);
     }
   }
 }
@@ -115,7 +120,7 @@ inline void TFT_eSPI::end_tft_write(void){
 // Non-inlined version to permit override
 inline void TFT_eSPI::end_nin_write(void){
   if(!inTransaction) {      // Flag to stop ending transaction during multiple graphics calls
-    if (!locked) {          // Locked when beginTransaction has been called
+    if (!locked && !BUS_KEEP_OPEN) { // Locked when beginTransaction has been called
       locked = true;        // Flag to show SPI access now locked
       SPI_BUSY_CHECK;       // Check send complete and clean out unused rx data
       CS_H;
@@ -123,6 +128,7 @@ inline void TFT_eSPI::end_nin_write(void){
 #if defined (SPI_HAS_TRANSACTION) && defined (SUPPORT_TRANSACTIONS) && !defined(TFT_PARALLEL_8_BIT) && !defined(RP2040_PIO_INTERFACE)
       spi.endTransaction();
 #endif
+      BUS_RELEASE(BUS_TFT);
     }
   }
 }
@@ -135,14 +141,16 @@ inline void TFT_eSPI::end_nin_write(void){
 inline void TFT_eSPI::begin_tft_read(void){
   DMA_BUSY_CHECK; // Wait for any DMA transfer to complete before changing SPI settings
 #if defined (SPI_HAS_TRANSACTION) && defined (SUPPORT_TRANSACTIONS) && !defined(TFT_PARALLEL_8_BIT) && !defined(RP2040_PIO_INTERFACE)
+  BUS_CLOSE_DEFERRED; // Reads use a different SPI clock
   if (locked) {
+    BUS_ACQUIRE(BUS_TFT);
     locked = false;
-    spi.beginTransaction(SPISettings(SPI_READ_FREQUENCY, MSBFIRST, TFT_SPI_MODE));
+    spi.beginTransaction(SPISettings(_spiReadFreq, MSBFIRST, TFT_SPI_MODE));
     CS_L;
   }
 #else
   #if !defined(TFT_PARALLEL_8_BIT) && !defined(RP2040_PIO_INTERFACE)
-    spi.setFrequency(SPI_READ_FREQUENCY);
+    spi.setFrequency(_spiReadFreq);
   #endif
    CS_L;
 #endif
@@ -160,17 +168,146 @@ inline void TFT_eSPI::end_tft_read(void){
       locked = true;
       CS_H;
       spi.endTransaction();
+      BUS_RELEASE(BUS_TFT);
     }
   }
 #else
   #if !defined(TFT_PARALLEL_8_BIT) && !defined(RP2040_PIO_INTERFACE)
-    spi.setFrequency(SPI_FREQUENCY);
+    spi.setFrequency(_spiWriteFreq);
   #endif
    if(!inTransaction) {CS_H;}
 #endif
   SET_BUS_WRITE_MODE;
 }
 
+/***************************************************************************************
+** Function name:           setSPIFrequency
+** Description:             Set the SPI write and read clocks
+***************************************************************************************/
+void TFT_eSPI::setSPIFrequency(uint32_t write, uint32_t read)
+{
+  if (write) _spiWriteFreq = write;
+  if (read)  _spiReadFreq  = read;
+
+#if !(defined (SPI_HAS_TRANSACTION) && defined (SUPPORT_TRANSACTIONS)) && !defined(TFT_PARALLEL_8_BIT) && !defined(TFT_PARALLEL_16_BIT) && !defined(RP2040_PIO_INTERFACE)
+  // Without transactions the write clock is only set at the end of a read
+  spi.setFrequency(_spiWriteFreq);
+#endif
+}
+
+/***************************************************************************************
+** Function name:           getSPIWriteFrequency, getSPIReadFrequency
+** Description:             Return the SPI clocks in use
+***************************************************************************************/
+uint32_t TFT_eSPI::getSPIWriteFrequency(void) { return _spiWriteFreq; }
+uint32_t TFT_eSPI::getSPIReadFrequency(void)  { return _spiReadFreq;  }
+
+/***************************************************************************************
+** Function name:           tuneCheck
+** Description:             Write and/or read back a test pattern, true if it matches
+***************************************************************************************/
+#define TUNE_W      32 // Test area
+#define TUNE_H      8
+#define TUNE_PASSES 3  // Patterns checked at each clock
+
+bool TFT_eSPI::tuneCheck(uint16_t *pattern, uint16_t *buffer, uint32_t seed, bool write)
+{
+  if (write) {
+    // Mix of bit transitions and pseudo random colours
+    for (uint32_t i = 0; i < TUNE_W * TUNE_H; i++) {
+      seed = seed * 1103515245 + 12345;
+      switch (i & 3) {
+        case 0:  pattern[i] = 0xFFFF; break;
+        case 1:  pattern[i] = (i & 4) ? 0xAAAA : 0x5555; break;
+        case 2:  pattern[i] = 0x0000; break;
+        default: pattern[i] = seed >> 16; break;
+      }
+    }
+    pushRect(0, 0, TUNE_W, TUNE_H, pattern);
+  }
+
+  memset(buffer, 0, TUNE_W * TUNE_H * 2);
+  readRect(0, 0, TUNE_W, TUNE_H, buffer);
+
+  return memcmp(pattern, buffer, TUNE_W * TUNE_H * 2) == 0;
+}
+
+/***************************************************************************************
+** Function name:           tuneSPIFrequency
+** Description:             Find the fastest reliable SPI write and read clocks
+***************************************************************************************/
+bool TFT_eSPI::tuneSPIFrequency(uint32_t maxFreq, uint8_t margin)
+{
+#if defined (TFT_PARALLEL_8_BIT) || defined (TFT_PARALLEL_16_BIT) || defined (RP2040_PIO_INTERFACE)
+  // Clock is not set by SPI settings
+  maxFreq = maxFreq; margin = margin; // Stop unused parameter warnings
+  return false;
+#else
+  if (margin > 90) margin = 90;
+
+  // Start with the setup file clocks, these are assumed to be reliable
+  _spiWriteFreq = SPI_FREQUENCY;
+  _spiReadFreq  = SPI_READ_FREQUENCY;
+  if (maxFreq < SPI_FREQUENCY) maxFreq = SPI_FREQUENCY;
+
+  uint16_t *save = (uint16_t*)malloc(TUNE_W * TUNE_H * 2 * 3);
+  if (save == nullptr) return false;
+  uint16_t *pattern = save + TUNE_W * TUNE_H;
+  uint16_t *buffer  = pattern + TUNE_W * TUNE_H;
+
+  // Patterns are written in screen coordinates
+  resetViewport();
+
+  readRect(0, 0, TUNE_W, TUNE_H, save);
+
+  // Check the pattern can be read back at all
+  bool ok = true;
+  for (uint8_t p = 0; ok && p < TUNE_PASSES; p++) ok = tuneCheck(pattern, buffer, p, true);
+
+  if (ok) {
+    // Read clock, pattern is written at the setup file clock
+    uint32_t good = _spiReadFreq;
+    for (uint32_t freq = good; freq < maxFreq; ) {
+      freq = freq + freq / 4;
+      if (freq > maxFreq) freq = maxFreq;
+      _spiReadFreq = freq;
+      bool pass = true;
+      for (uint8_t p = 0; pass && p < TUNE_PASSES; p++) pass = tuneCheck(pattern, buffer, p, false);
+      if (!pass) break;
+      good = freq;
+    }
+    uint32_t readFreq = good;
+
+    // Write clock, pattern is read at the setup file clock
+    _spiReadFreq = SPI_READ_FREQUENCY;
+    good = _spiWriteFreq;
+    for (uint32_t freq = good; freq < maxFreq; ) {
+      freq = freq + freq / 4;
+      if (freq > maxFreq) freq = maxFreq;
+      _spiWriteFreq = freq;
+      bool pass = true;
+      for (uint8_t p = 0; pass && p < TUNE_PASSES; p++) pass = tuneCheck(pattern, buffer, freq + p, true);
+      if (!pass) break;
+      good = freq;
+    }
+    uint32_t writeFreq = good;
+
+    // Back off by the margin, but not below the setup file clocks
+    writeFreq -= writeFreq / 100 * margin;
+    readFreq  -= readFreq  / 100 * margin;
+    _spiWriteFreq = (writeFreq > SPI_FREQUENCY) ? writeFreq : SPI_FREQUENCY;
+    _spiReadFreq  = (readFreq  > SPI_READ_FREQUENCY) ? readFreq : SPI_READ_FREQUENCY;
+  }
+
+  // A failed write may have left errors anywhere in the test area
+  pushRect(0, 0, TUNE_W, TUNE_H, save);
+
+  free(save);
+
+  return ok;
+#endif
+}
+
 /***************************************************************************************
 ** Function name:           setViewport
 ** Description:             Set the clipping region for the TFT screen
@@ -452,7 +589,8 @@ TFT_eSPI::TFT_eSPI(int16_t w, int16_t h)
   textbgcolor = bitmap_bg = 0x0000; // Black
   padX        = 0;                  // No padding
 
-  _fillbg    = false;   // Smooth font only at the moment, force text background fill
+  _fillbg    = false;   // Smooth and free fonts, force text background fill
+  _textStrip = false;   // Draw opaque strings via a strip Sprite
 
   isDigits   = false;   // No bounding box adjustment
   textwrapX  = true;    // Wrap text at end of line when using print stream
@@ -466,6 +604,14 @@ TFT_eSPI::TFT_eSPI(int16_t w, int16_t h)
   inTransaction = false;   // Flag to prevent multiple sequential functions to keep bus access open
   lockTransaction = false; // start/endWrite lock flag to allow sketch to keep SPI bus access open
 
+#if defined (ESP32)
+  _bus = nullptr;          // No shared bus arbiter
+#endif
+
+#ifdef TFT_TRACE
+  _trace = nullptr;        // Not recording
+#endif
+
   _booted   = true;     // Default attributes
   _cp437    = false;    // Legacy GLCD font bug fix disabled by default
   _utf8     = true;     // UTF8 decoding enabled
@@ -882,6 +1028,9 @@ void TFT_eSPI::setRotation(uint8_t m)
 
   // Reset the viewport to the whole screen
   resetViewport();
+
+  // Tile map layout has changed
+  invalidateShadow();
 }
 
 
@@ -967,6 +1116,7 @@ void TFT_eSPI::commandList (const uint8_t *addr)
 ***************************************************************************************/
 void TFT_eSPI::spiwrite(uint8_t c)
 {
+  TRACE_DAT(c);
   begin_tft_write();
   tft_Write_8(c);
   end_tft_write();
@@ -980,6 +1130,7 @@ void TFT_eSPI::spiwrite(uint8_t c)
 #ifndef RM68120_DRIVER
 void TFT_eSPI::writecommand(uint8_t c)
 {
+  TRACE_CMD(c);
   begin_tft_write();
 
   DC_C;
@@ -993,6 +1144,7 @@ void TFT_eSPI::writecommand(uint8_t c)
 #else
 void TFT_eSPI::writecommand(uint16_t c)
 {
+  TRACE_CMD(c);
   begin_tft_write();
 
   DC_C;
@@ -1006,6 +1158,7 @@ void TFT_eSPI::writecommand(uint16_t c)
 }
 void TFT_eSPI::writeRegister8(uint16_t c, uint8_t d)
 {
+  TRACE_CMD(c); TRACE_DAT(d);
   begin_tft_write();
 
   DC_C;
@@ -1021,6 +1174,7 @@ void TFT_eSPI::writeRegister8(uint16_t c, uint8_t d)
 }
 void TFT_eSPI::writeRegister16(uint16_t c, uint16_t d)
 {
+  TRACE_CMD(c); TRACE_DAT(d >> 8); TRACE_DAT(d);
   begin_tft_write();
 
   DC_C;
@@ -1043,6 +1197,7 @@ void TFT_eSPI::writeRegister16(uint16_t c, uint16_t d)
 ***************************************************************************************/
 void TFT_eSPI::writedata(uint8_t d)
 {
+  TRACE_DAT(d);
   begin_tft_write();
 
   DC_D;        // Play safe, but should already be in data mode
@@ -2922,7 +3077,8 @@ void TFT_eSPI::setTextColor(uint16_t c)
 ***************************************************************************************/
 // Smooth fonts use the background colour for anti-aliasing and by default the
 // background is not filled. If bgfill = true, then a smooth font background fill will
-// be used.
+// be used. Free font characters drawn by print() are also opaque if bgfill = true, each
+// character cell is filled from the end of the previous cell as the glyph is drawn.
 void TFT_eSPI::setTextColor(uint16_t c, uint16_t b, bool bgfill)
 {
   textcolor   = c;
@@ -3013,6 +3169,24 @@ uint16_t TFT_eSPI::getTextPadding(void)
   return padX;
 }
 
+/***************************************************************************************
+** Function name:           setTextStrip
+** Description:             Draw opaque strings as a single pixel window (TFT only)
+***************************************************************************************/
+void TFT_eSPI::setTextStrip(bool strip)
+{
+  _textStrip = strip;
+}
+
+/***************************************************************************************
+** Function name:           getTextStrip
+** Description:             Return true if opaque strings are drawn as a single window
+***************************************************************************************/
+bool TFT_eSPI::getTextStrip(void)
+{
+  return _textStrip;
+}
+
 /***************************************************************************************
 ** Function name:           getTextDatum
 ** Description:             Return the text datum value (as used by setTextDatum())
@@ -3076,22 +3250,48 @@ int16_t TFT_eSPI::textWidth(const char *string, uint8_t font)
   int32_t str_width = 0;
   uint16_t uniCode  = 0;
 
+#if defined (SMOOTH_FONT) || defined (LOAD_GFXFF)
+  // Decode the string in blocks
+  uint16_t unicode[32];
+  uint16_t bytes = strlen(string);
+  uint16_t n = 0;
+#endif
+
 #ifdef SMOOTH_FONT
   if(fontLoaded) {
-    while (*string) {
-      uniCode = decodeUTF8(*string++);
-      if (uniCode) {
-        if (uniCode == 0x20) str_width += gFont.spaceWidth;
+    uint16_t prevCode = 0;    // Previous character, for kerning and ligatures
+    int32_t  prevAdvance = 0; // Width added for the previous character
+    while (n < bytes) {
+      uint16_t count = decodeUTF8((const uint8_t*)string, &n, bytes, unicode, 32);
+      for (uint16_t i = 0; i < count; i++) {
+        uniCode = unicode[i];
+        if (!uniCode) continue;
+        bool more = (i + 1 < count) || (n < bytes); // Not the last character
+        if (prevCode) {
+          uint16_t ligature = getLigature(prevCode, uniCode);
+          // A ligature replaces the previous character
+          if (ligature) {
+            uniCode = ligature;
+            str_width -= prevAdvance;
+          }
+          else str_width += getKerning(prevCode, uniCode);
+        }
+        prevCode = uniCode;
+
+        if (uniCode == 0x20) prevAdvance = gFont.spaceWidth;
         else {
           uint16_t gNum = 0;
           bool found = getUnicodeIndex(uniCode, &gNum);
           if (found) {
-            if(str_width == 0 && gdX[gNum] < 0) str_width -= gdX[gNum];
-            if (*string || isDigits) str_width += gxAdvance[gNum];
-            else str_width += (gdX[gNum] + gWidth[gNum]);
+            glyphMetrics gm;
+            getGlyphMetrics(gNum, &gm);
+            if(str_width == 0 && gm.dX < 0) str_width -= gm.dX;
+            if (more || isDigits) prevAdvance = gm.xAdvance;
+            else prevAdvance = (gm.dX + gm.width);
           }
-          else str_width += gFont.spaceWidth + 1;
+          else prevAdvance = gFont.spaceWidth + 1;
         }
+        str_width += prevAdvance;
       }
     }
     isDigits = false;
@@ -3114,15 +3314,18 @@ int16_t TFT_eSPI::textWidth(const char *string, uint8_t font)
 
 #ifdef LOAD_GFXFF
     if(gfxFont) { // New font
-      while (*string) {
-        uniCode = decodeUTF8(*string++);
-        if ((uniCode >= pgm_read_word(&gfxFont->first)) && (uniCode <= pgm_read_word(&gfxFont->last ))) {
-          uniCode -= pgm_read_word(&gfxFont->first);
-          GFXglyph *glyph  = &(((GFXglyph *)pgm_read_dword(&gfxFont->glyph))[uniCode]);
-          // If this is not the  last character or is a digit then use xAdvance
-          if (*string  || isDigits) str_width += pgm_read_byte(&glyph->xAdvance);
-          // Else use the offset plus width since this can be bigger than xAdvance
-          else str_width += ((int8_t)pgm_read_byte(&glyph->xOffset) + pgm_read_byte(&glyph->width));
+      while (n < bytes) {
+        uint16_t count = decodeUTF8((const uint8_t*)string, &n, bytes, unicode, 32);
+        for (uint16_t i = 0; i < count; i++) {
+          uniCode = unicode[i];
+          if ((uniCode >= pgm_read_word(&gfxFont->first)) && (uniCode <= pgm_read_word(&gfxFont->last ))) {
+            uniCode -= pgm_read_word(&gfxFont->first);
+            GFXglyph *glyph  = &(((GFXglyph *)pgm_read_dword(&gfxFont->glyph))[uniCode]);
+            // If this is not the  last character or is a digit then use xAdvance
+            if ((i + 1 < count) || (n < bytes) || isDigits) str_width += pgm_read_byte(&glyph->xAdvance);
+            // Else use the offset plus width since this can be bigger than xAdvance
+            else str_width += ((int8_t)pgm_read_byte(&glyph->xOffset) + pgm_read_byte(&glyph->width));
+          }
         }
       }
     }
@@ -3139,6 +3342,192 @@ int16_t TFT_eSPI::textWidth(const char *string, uint8_t font)
 }
 
 
+/***************************************************************************************
+** Function name:           layoutString
+** Description:             Decode a string into a glyph run, find positions and width
+***************************************************************************************/
+bool TFT_eSPI::layoutString(TFT_eTextLayout *layout, const char *string, uint8_t font)
+{
+  bool digits = isDigits;
+  isDigits = false;
+
+  if (layout == nullptr || string == nullptr || font > 8) return false;
+
+  const void *fontRef = layoutFont(font);
+
+  // Hash the string (FNV-1a) so an unchanged layout is not decoded again
+  uint32_t hash  = 2166136261UL;
+  uint16_t bytes = 0;
+  const uint8_t *ptr = (const uint8_t *)string;
+  while (*ptr) {
+    hash = (hash ^ *ptr++) * 16777619UL;
+    bytes++;
+  }
+
+  if (layout->_valid && layout->_hash == hash && layout->_bytes == bytes &&
+      layout->_fontRef == fontRef && layout->_font == font && layout->_textsize == textsize &&
+      layout->_digits == digits && layout->_utf8 == _utf8) return true;
+
+  layout->invalidate();
+
+  uint8_t  scale = textsize; // Smooth fonts are not scaled
+  int32_t  str_width = 0;    // Width as found by textWidth(), before scaling
+  int32_t  xPos  = 0;        // Glyph position
+  uint16_t count = 0;        // Glyph count
+  uint16_t n = 0;            // String byte index
+
+  const uint8_t *widthtable = nullptr;
+  if (font > 1) widthtable = (const uint8_t *)pgm_read_dword( &(fontdata[font].widthtbl ) );
+
+  // drawChar() returns 0 for fonts that have not been loaded
+  bool fontDrawn = false;
+#ifdef LOAD_FONT2
+  if (font == 2) fontDrawn = true;
+#endif
+#ifdef LOAD_RLE
+  if (font > 2) fontDrawn = true;
+#endif
+
+#ifdef SMOOTH_FONT
+  if (fontLoaded) scale = 1;
+#endif
+
+  // Decode the string in blocks
+  uint16_t unicode[32];
+  uint16_t decoded = 0; // Unicode points in block
+  uint16_t next = 0;    // Next point in block
+
+  while (next < decoded || n < bytes) {
+    if (next == decoded) {
+      decoded = decodeUTF8((const uint8_t*)string, &n, bytes, unicode, 32);
+      next = 0;
+    }
+    uint16_t uniCode = unicode[next++];
+    if (!uniCode) continue;
+
+#if defined (SMOOTH_FONT) || defined (LOAD_GFXFF)
+    bool more = (next < decoded) || (n < bytes); // Not the last character
+#endif
+
+    if (count >= layout->_size) return false;
+
+    uint16_t index    = 0;
+    int32_t  xAdvance = 0;
+    int16_t  kern     = 0;
+
+#ifdef SMOOTH_FONT
+    if(fontLoaded) {
+      if (count) {
+        layoutGlyph *prev = &layout->_glyphs[count - 1];
+        uint16_t ligature = getLigature(prev->code, uniCode);
+        // A ligature replaces the previous glyph
+        if (ligature) {
+          uniCode = ligature;
+          count--;
+          xPos = prev->x;
+          kern = prev->kern;
+        }
+        else {
+          kern = getKerning(prev->code, uniCode);
+          xPos += kern;
+        }
+      }
+
+      int32_t extent = 0; // Width to the right edge of the glyph if it is the last
+      if (uniCode == 0x20) xAdvance = extent = gFont.spaceWidth;
+      else if (getUnicodeIndex(uniCode, &index)) {
+        glyphMetrics gm;
+        getGlyphMetrics(index, &gm);
+        if(xPos == 0 && gm.dX < 0) xPos -= gm.dX;
+        xAdvance = gm.xAdvance;
+        if (more || digits) extent = xAdvance;
+        else extent = (gm.dX + gm.width);
+      }
+      else xAdvance = extent = gFont.spaceWidth + 1;
+
+      str_width = xPos + extent;
+    }
+    else
+#endif
+    if (font > 1) {
+      if (uniCode > 31 && uniCode < 128) {
+        index = uniCode - 32;
+        str_width += pgm_read_byte(widthtable + index);
+        if (fontDrawn) xAdvance = pgm_read_byte(widthtable + index);
+      }
+      else str_width += pgm_read_byte(widthtable); // Set illegal character = space width
+    }
+    else {
+#ifdef LOAD_GFXFF
+      if(gfxFont) {
+        if ((uniCode >= pgm_read_word(&gfxFont->first)) && (uniCode <= pgm_read_word(&gfxFont->last ))) {
+          index = uniCode - pgm_read_word(&gfxFont->first);
+          GFXglyph *glyph = &(((GFXglyph *)pgm_read_dword(&gfxFont->glyph))[index]);
+          xAdvance = pgm_read_byte(&glyph->xAdvance);
+          // If this is not the last character or is a digit then use xAdvance
+          if (more || digits) str_width += xAdvance;
+          // Else use the offset plus width since this can be bigger than xAdvance
+          else str_width += ((int8_t)pgm_read_byte(&glyph->xOffset) + pgm_read_byte(&glyph->width));
+        }
+      }
+      else
+#endif
+      {
+#ifdef LOAD_GLCD
+        xAdvance = 6;
+        str_width += 6;
+#endif
+      }
+    }
+
+    layout->_glyphs[count].code  = uniCode;
+    layout->_glyphs[count].index = index;
+    layout->_glyphs[count].x     = xPos;
+    layout->_glyphs[count].kern  = kern;
+    count++;
+
+    xPos += xAdvance * scale;
+  }
+
+  layout->_count    = count;
+  layout->_width    = str_width * scale;
+  layout->_height   = fontHeight(font);
+  layout->_advance  = xPos;
+
+  layout->_hash     = hash;
+  layout->_bytes    = bytes;
+  layout->_fontRef  = fontRef;
+  layout->_font     = font;
+  layout->_textsize = textsize;
+  layout->_digits   = digits;
+  layout->_utf8     = _utf8;
+  layout->_valid    = true;
+
+  return true;
+}
+
+
+/***************************************************************************************
+** Function name:           layoutFont
+** Description:             Return a key that identifies the free or smooth font in use
+***************************************************************************************/
+const void* TFT_eSPI::layoutFont(uint8_t font)
+{
+#ifdef SMOOTH_FONT
+  // Each font load has a serial number, made odd so it never matches a free font pointer.
+  // gUnicode is not used as it is NULL for mapped fonts and a file font may reuse memory.
+  if (fontLoaded) return (const void*)(uintptr_t)((gFontId << 1) | 1);
+#endif
+
+#ifdef LOAD_GFXFF
+  if (font == 1) return gfxFont;
+#endif
+
+  font = font; // Stop warnings
+  return nullptr;
+}
+
+
 /***************************************************************************************
 ** Function name:           fontsLoaded
 ** Description:             return an encoded 16-bit value showing the fonts loaded
@@ -3213,6 +3602,7 @@ void TFT_eSPI::drawChar(int32_t x, int32_t y, uint16_t c, uint32_t color, uint32
     begin_tft_write();
 
     setWindow(xd, yd, xd+5, yd+7);
+    TRACE_PIXS(48);
 
     for (int8_t i = 0; i < 5; i++ ) column[i] = pgm_read_byte(&font[0] + (c * 5) + i);
     column[5] = 0;
@@ -3267,8 +3657,6 @@ void TFT_eSPI::drawChar(int32_t x, int32_t y, uint16_t c, uint32_t color, uint32
 #ifdef LOAD_GFXFF
     // Filter out bad characters not present in font
     if ((c >= pgm_read_word(&gfxFont->first)) && (c <= pgm_read_word(&gfxFont->last ))) {
-      //begin_tft_write();          // Sprite class can use this function, avoiding begin_tft_write()
-      inTransaction = true;
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>
 
       c -= pgm_read_word(&gfxFont->first);
@@ -3277,8 +3665,8 @@ void TFT_eSPI::drawChar(int32_t x, int32_t y, uint16_t c, uint32_t color, uint32
 
       uint32_t bo = pgm_read_word(&glyph->bitmapOffset);
       uint8_t  w  = pgm_read_byte(&glyph->width),
-               h  = pgm_read_byte(&glyph->height);
-               //xa = pgm_read_byte(&glyph->xAdvance);
+               h  = pgm_read_byte(&glyph->height),
+               xa = pgm_read_byte(&glyph->xAdvance);
       int8_t   xo = pgm_read_byte(&glyph->xOffset),
                yo = pgm_read_byte(&glyph->yOffset);
       uint8_t  xx, yy, bits=0, bit=0;
@@ -3289,6 +3677,88 @@ void TFT_eSPI::drawChar(int32_t x, int32_t y, uint16_t c, uint32_t color, uint32
         yo16 = yo;
       }
 
+      if (_fillbg && (bg != color)) {
+        // Opaque character cell, from the end of the previous cell to the end of the glyph
+        // or advance, and the font height above and below the baseline. The previous cell
+        // ends after its glyph, so overhanging glyphs are not erased, and any part of this
+        // glyph left of the cell is drawn transparent.
+        int32_t cx0 = 0;
+        int32_t cx1 = ((xo + w > xa) ? xo + w : xa) * size;
+        if ((last_cursor_x == x) && (bg_cursor_x > x)) cx0 = bg_cursor_x - x;
+        if (cx0 > cx1) cx1 = cx0;
+
+        last_cursor_x = x + xa * size; // Next character position if text continues
+        bg_cursor_x   = x + cx1;
+
+        int16_t cy0 = (yo < -glyph_ab) ? yo : -glyph_ab;
+        int16_t cy1 = (yo + h > glyph_bb) ? yo + h : glyph_bb;
+        if (h == 0) yo = cy0; // No bitmap rows, avoids a split fill
+
+        int32_t cw = cx1 - cx0;
+        int32_t ch = (cy1 - cy0) * size;
+        int32_t xd = x + _xDatum + cx0;
+        int32_t yd = y + _yDatum + cy0 * size;
+
+        // Glyph pixels left of the cell are drawn transparent after the cell
+        bool overhang = (xo * size < cx0) && (w > 0);
+
+        if ((cw > 0) && (ch > 0)) {
+          if ((xd >= _vpX) && (yd >= _vpY) && (xd + cw <= _vpW) && (yd + ch <= _vpH)) {
+            // Render each glyph line into a buffer and push the whole cell in one window
+            uint16_t lineBuf[cw];
+            bool swap = _swapBytes;
+            uint32_t bo0 = bo;
+
+            begin_tft_write();
+            inTransaction = true;
+
+            setWindow(xd, yd, xd + cw - 1, yd + ch - 1);
+
+            // Background above the glyph
+            if (yo > cy0) pushBlock(bg, (yo - cy0) * size * cw);
+
+            _swapBytes = true; // Buffer holds native colour values
+            for(yy=0; yy<h; yy++) {
+              for(int32_t i = 0; i < cw; i++) lineBuf[i] = bg;
+              int32_t px = xo * size - cx0; // Buffer position of the glyph pixel
+              for(xx=0; xx<w; xx++) {
+                if(bit == 0) {
+                  bits = pgm_read_byte(&bitmap[bo++]);
+                  bit  = 0x80;
+                }
+                if(bits & bit) {
+                  for (uint8_t s = 0; s < size; s++) if (px + s >= 0) lineBuf[px + s] = color;
+                }
+                px += size;
+                bit >>= 1;
+              }
+              for (uint8_t s = 0; s < size; s++) pushPixels(lineBuf, cw);
+            }
+            _swapBytes = swap;
+
+            // Background below the glyph
+            if (cy1 > yo + h) pushBlock(bg, (cy1 - yo - h) * size * cw);
+
+            inTransaction = lockTransaction;
+            end_tft_write();
+
+            if (!overhang) return;
+            bo = bo0; bits = 0; bit = 0; // Draw the glyph again transparent
+          }
+          // Clipped, so fill the cell then draw the glyph
+          else fillRect(x + cx0, y + cy0 * size, cw, ch, bg);
+        }
+      }
+
+      // Glyph runs inside the viewport are sent as a window and a block of colour
+      int32_t xd = x + _xDatum + xo * size;
+      int32_t yd = y + _yDatum + yo * size;
+      bool span = (xd >= _vpX) && (yd >= _vpY) && (xd + w * size <= _vpW) && (yd + h * size <= _vpH);
+
+      //begin_tft_write();          // Sprite class can use this function, avoiding begin_tft_write()
+      if (span) begin_tft_write();
+      inTransaction = true;
+
       // GFXFF rendering speed up
       uint16_t hpc = 0; // Horizontal foreground pixel count
       for(yy=0; yy<h; yy++) {
@@ -3300,7 +3770,12 @@ void TFT_eSPI::drawChar(int32_t x, int32_t y, uint16_t c, uint32_t color, uint32
           if(bits & bit) hpc++;
           else {
            if (hpc) {
-              if(size == 1) drawFastHLine(x+xo+xx-hpc, y+yo+yy, hpc, color);
+              if (span) {
+                int32_t xs = xd + (xx - hpc) * size;
+                setWindow(xs, yd + yy * size, xs + hpc * size - 1, yd + (yy + 1) * size - 1);
+                pushBlock(color, hpc * size * size);
+              }
+              else if(size == 1) drawFastHLine(x+xo+xx-hpc, y+yo+yy, hpc, color);
               else fillRect(x+(xo16+xx-hpc)*size, y+(yo16+yy)*size, size*hpc, size, color);
               hpc=0;
             }
@@ -3309,7 +3784,12 @@ void TFT_eSPI::drawChar(int32_t x, int32_t y, uint16_t c, uint32_t color, uint32
         }
         // Draw pixels for this line as we are about to increment yy
         if (hpc) {
-          if(size == 1) drawFastHLine(x+xo+xx-hpc, y+yo+yy, hpc, color);
+          if (span) {
+            int32_t xs = xd + (xx - hpc) * size;
+            setWindow(xs, yd + yy * size, xs + hpc * size - 1, yd + (yy + 1) * size - 1);
+            pushBlock(color, hpc * size * size);
+          }
+          else if(size == 1) drawFastHLine(x+xo+xx-hpc, y+yo+yy, hpc, color);
           else fillRect(x+(xo16+xx-hpc)*size, y+(yo16+yy)*size, size*hpc, size, color);
           hpc=0;
         }
@@ -3361,6 +3841,8 @@ void TFT_eSPI::setAddrWindow(int32_t x0, int32_t y0, int32_t w, int32_t h)
 void TFT_eSPI::setWindow(int32_t x0, int32_t y0, int32_t x1, int32_t y1)
 {
   //begin_tft_write(); // Must be called before setWindow
+  TRACE_WIN(x0, y0, x1, y1);
+  if (_shadowColor) shadowUnknown(x0, y0, x1, y1);
   addr_row = 0xFFFF;
   addr_col = 0xFFFF;
 
@@ -3505,6 +3987,9 @@ void TFT_eSPI::readAddrWindow(int32_t xs, int32_t ys, int32_t w, int32_t h)
   int32_t xe = xs + w - 1;
   int32_t ye = ys + h - 1;
 
+  TRACE_WIN(xs, ys, xe, ye);
+  TRACE_RD(w * h);
+
   addr_col = 0xFFFF;
   addr_row = 0xFFFF;
 
@@ -3590,6 +4075,9 @@ void TFT_eSPI::drawPixel(int32_t x, int32_t y, uint32_t color)
   // Range checking
   if ((x < _vpX) || (y < _vpY) ||(x >= _vpW) || (y >= _vpH)) return;
 
+  // Skip the pixel if the tile is known to be that colour
+  if (_shadowColor && shadowPixel(x, y, color)) return;
+
 #ifdef CGRAM_OFFSET
   x+=colstart;
   y+=rowstart;
@@ -3600,6 +4088,8 @@ void TFT_eSPI::drawPixel(int32_t x, int32_t y, uint32_t color)
   addr_col = 0xFFFF;
 #endif
 
+  TRACE_PIX(x, y, color);
+
   begin_tft_write();
 
 #if defined (ILI9225_DRIVER)
@@ -3790,6 +4280,7 @@ void TFT_eSPI::drawPixel(int32_t x, int32_t y, uint32_t color)
 ***************************************************************************************/
 void TFT_eSPI::pushColor(uint16_t color)
 {
+  TRACE_BLK(color, 1);
   begin_tft_write();
 
   SPI_BUSY_CHECK;
@@ -3835,6 +4326,50 @@ void TFT_eSPI::endWrite(void)
   end_tft_write();         // Release SPI bus
 }
 
+#if defined (ESP32)
+/***************************************************************************************
+** Function name:           setBus
+** Description:             Attach a shared bus arbiter
+***************************************************************************************/
+void TFT_eSPI::setBus(TFT_eBus *bus)
+{
+  // The bus must not be changed while a transaction is open
+  if (_bus) releaseBus();
+  if (!locked) return;
+  _bus = bus;
+}
+
+/***************************************************************************************
+** Function name:           releaseBus
+** Description:             Close a transaction kept open by deferred release
+***************************************************************************************/
+void TFT_eSPI::releaseBus(void)
+{
+  if (!_bus || !_bus->deferred(this)) return;
+
+  _bus->clearDeferred();
+  locked = true;
+  SPI_BUSY_CHECK;
+  CS_H;
+  SET_BUS_READ_MODE;
+#if defined (SPI_HAS_TRANSACTION) && defined (SUPPORT_TRANSACTIONS) && !defined(TFT_PARALLEL_8_BIT) && !defined(RP2040_PIO_INTERFACE)
+  spi.endTransaction();
+#endif
+  _bus->release(BUS_TFT);
+}
+#endif
+
+#ifdef TFT_TRACE
+/***************************************************************************************
+** Function name:           setTrace
+** Description:             Attach or detach a bus trace
+***************************************************************************************/
+void TFT_eSPI::setTrace(TFT_eTrace *trace)
+{
+  _trace = trace;
+}
+#endif
+
 /***************************************************************************************
 ** Function name:           writeColor (use startWrite() and endWrite() before & after)
 ** Description:             raw write of "len" pixels avoiding transaction check
@@ -4613,6 +5148,8 @@ void TFT_eSPI::drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color)
 
   if (h < 1) return;
 
+  if (_shadowColor) { int32_t w = 1; if (!shadowFill(x, y, w, h, color)) return; }
+
   begin_tft_write();
 
   setWindow(x, y, x, y + h - 1);
@@ -4643,6 +5180,8 @@ void TFT_eSPI::drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color)
 
   if (w < 1) return;
 
+  if (_shadowColor) { int32_t h = 1; if (!shadowFill(x, y, w, h, color)) return; }
+
   begin_tft_write();
 
   setWindow(x, y, x + w - 1, y);
@@ -4684,6 +5223,9 @@ void TFT_eSPI::fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t col
   //Serial.print(" x=");Serial.print( y);Serial.print(", y=");Serial.print( y);
   //Serial.print(", w=");Serial.print(w);Serial.print(", h=");Serial.println(h);
 
+  // Only fill the tiles that are not known to be the colour
+  if (_shadowColor && !shadowFill(x, y, w, h, color)) return;
+
   begin_tft_write();
 
   setWindow(x, y, x + w - 1, y + h - 1);
@@ -4691,6 +5233,8 @@ void TFT_eSPI::fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t col
   pushBlock(color, w * h);
 
   end_tft_write();
+
+  if (_shadowColor) shadowSolid(x, y, w, h, color);
 }
 
 
@@ -4847,6 +5391,56 @@ void TFT_eSPI::invertDisplay(bool i)
 }
 
 
+/***************************************************************************************
+** Function name:           setScrollArea
+** Description:             Define the hardware vertical scrolling area
+***************************************************************************************/
+// The display scrolls along the rotation 0 y axis. Lines in the controller memory that
+// are not visible are added to the bottom fixed area.
+bool TFT_eSPI::setScrollArea(uint16_t top, uint16_t bottom)
+{
+#if defined (TFT_VSCRDEF)
+  if ((top + bottom) >= _init_height) return false;
+
+  uint16_t tfa = rowstart + top;
+  uint16_t vsa = _init_height - top - bottom;
+  uint16_t bfa = TFT_VSCR_LINES - tfa - vsa;
+
+  begin_tft_write();
+  writecommand(TFT_VSCRDEF);
+  writedata(tfa >> 8); // Top fixed area
+  writedata(tfa);
+  writedata(vsa >> 8); // Vertical scrolling area
+  writedata(vsa);
+  writedata(bfa >> 8); // Bottom fixed area
+  writedata(bfa);
+  end_tft_write();
+
+  return true;
+#else
+  return false;
+#endif
+}
+
+
+/***************************************************************************************
+** Function name:           setScrollStart
+** Description:             Set the line shown at the top of the scrolling area
+***************************************************************************************/
+void TFT_eSPI::setScrollStart(uint16_t line)
+{
+#if defined (TFT_VSCRSADD)
+  line += rowstart;
+
+  begin_tft_write();
+  writecommand(TFT_VSCRSADD);
+  writedata(line >> 8);
+  writedata(line);
+  end_tft_write();
+#endif
+}
+
+
 /**************************************************************************
 ** Function name:           setAttribute
 ** Description:             Sets a control parameter of an attribute
@@ -4978,6 +5572,64 @@ uint16_t TFT_eSPI::decodeUTF8(uint8_t *buf, uint16_t *index, uint16_t remaining)
 }
 
 
+/***************************************************************************************
+** Function name:           decodeUTF8
+** Description:             String UTF-8 decoder with an ASCII fast path
+*************************************************************************************x*/
+// Decoding is the same as the line buffer decoder above
+uint16_t TFT_eSPI::decodeUTF8(const uint8_t *buf, uint16_t *index, uint16_t length, uint16_t *unicode, uint16_t size)
+{
+  uint16_t i = *index;
+  uint16_t count = 0;
+
+  if (!_utf8) {
+    while (i < length && count < size) unicode[count++] = buf[i++];
+    *index = i;
+    return count;
+  }
+
+  while (i < length && count < size) {
+    // Test 4 bytes at a time for the top bit, if none are set they are all ASCII
+    if (length - i >= 4 && size - count >= 4) {
+      uint32_t word;
+      memcpy(&word, buf + i, 4);
+      if ((word & 0x80808080) == 0) {
+        unicode[count++] = buf[i++];
+        unicode[count++] = buf[i++];
+        unicode[count++] = buf[i++];
+        unicode[count++] = buf[i++];
+        continue;
+      }
+    }
+    unicode[count++] = decodeUTF8((uint8_t*)buf, &i, length - i);
+  }
+
+  *index = i;
+  return count;
+}
+
+
+/***************************************************************************************
+** Function name:           completeUTF8
+** Description:             Return the length without an incomplete last UTF-8 character
+*************************************************************************************x*/
+uint16_t TFT_eSPI::completeUTF8(const uint8_t *buf, uint16_t length)
+{
+  if (!_utf8) return length;
+
+  // Look back for the lead byte of the last character
+  for (uint16_t back = 1; back <= 2 && back <= length; back++) {
+    uint8_t c = buf[length - back];
+    if ((c & 0xC0) == 0x80) continue; // Continuation byte
+    if (((c & 0xE0) == 0xC0) && back < 2) return length - back;
+    if ((c & 0xF0) == 0xE0) return length - back;
+    break;
+  }
+
+  return length;
+}
+
+
 /***************************************************************************************
 ** Function name:           alphaBlend
 ** Description:             Blend 16bit foreground and background
@@ -5033,25 +5685,45 @@ uint32_t TFT_eSPI::alphaBlend24(uint8_t alpha, uint32_t fgc, uint32_t bgc, uint8
   return (rxx & 0xFF0000) | (xgx & 0x00FF00) | (xxb & 0x0000FF);
 }
 
+#ifndef ARDUINO_ARCH_ESP8266 // Avoid ESP8266 board package bug
 /***************************************************************************************
 ** Function name:           write
-** Description:             draw characters piped through serial stream
+** Description:             draw a buffer of characters piped through serial stream
 ***************************************************************************************/
-/* // Not all processors support buffered write
-#ifndef ARDUINO_ARCH_ESP8266 // Avoid ESP8266 board package bug
 size_t TFT_eSPI::write(const uint8_t *buf, size_t len)
 {
-  inTransaction = true;
+  if (_vpOoB) return len;
 
-  uint8_t *lbuf = (uint8_t *)buf;
-  while(*lbuf !=0 && len--) write(*lbuf++);
+  size_t done = 0;
 
-  inTransaction = lockTransaction;
-  end_tft_write();
-  return 1;
+  // Finish any character started by an earlier write()
+  while (decoderState && done < len) write(buf[done++]);
+
+  uint16_t unicode[32];
+
+  while (done < len) {
+    uint16_t length = (len - done > 0x8000) ? 0x8000 : len - done;
+    const uint8_t *ptr = buf + done;
+
+    // A character split at the end of the buffer is completed by the serial decoder
+    uint16_t complete = completeUTF8(ptr, length);
+    if (complete == 0) {
+      while (length--) write(buf[done++]);
+      continue;
+    }
+
+    uint16_t index = 0;
+    while (index < complete) {
+      uint16_t count = decodeUTF8(ptr, &index, complete, unicode, 32);
+      for (uint16_t i = 0; i < count; i++) writeUnicode(unicode[i]);
+    }
+    done += complete;
+  }
+
+  return len;
 }
 #endif
-*/
+
 /***************************************************************************************
 ** Function name:           write
 ** Description:             draw characters piped through serial stream
@@ -5062,13 +5734,25 @@ size_t TFT_eSPI::write(uint8_t utf8)
 
   uint16_t uniCode = decodeUTF8(utf8);
 
+  return writeUnicode(uniCode);
+}
+
+
+/***************************************************************************************
+** Function name:           writeUnicode
+** Description:             draw a decoded character piped through serial stream
+***************************************************************************************/
+size_t TFT_eSPI::writeUnicode(uint16_t code)
+{
+  uint16_t uniCode = code;
+
   if (!uniCode) return 1;
 
-  if (utf8 == '\r') return 1;
+  if (code == '\r') return 1;
 
 #ifdef SMOOTH_FONT
   if(fontLoaded) {
-    if (uniCode < 32 && utf8 != '\n') return 1;
+    if (uniCode < 32 && code != '\n') return 1;
 
     drawGlyph(uniCode);
 
@@ -5130,7 +5814,7 @@ size_t TFT_eSPI::write(uint8_t utf8)
 
   cheight = cheight * textsize;
 
-  if (utf8 == '\n') {
+  if (code == '\n') {
     cursor_y += cheight;
     cursor_x  = 0;
   }
@@ -5147,8 +5831,9 @@ size_t TFT_eSPI::write(uint8_t utf8)
 #ifdef LOAD_GFXFF
   } // Custom GFX font
   else {
-    if(utf8 == '\n') {
+    if(code == '\n') {
       cursor_x  = 0;
+      bg_cursor_x = last_cursor_x = 0;
       cursor_y += (int16_t)textsize * (uint8_t)pgm_read_byte(&gfxFont->yAdvance);
     } else {
       if (uniCode > pgm_read_word(&gfxFont->last )) return 1;
@@ -5168,6 +5853,8 @@ size_t TFT_eSPI::write(uint8_t utf8)
         if (textwrapY && (cursor_y >= (int32_t) height())) cursor_y = 0;
         drawChar(cursor_x, cursor_y, uniCode, textcolor, textbgcolor, textsize);
       }
+      // Opaque free font, fill the background of a glyph without a bitmap (e.g. space)
+      else if (_fillbg && (textcolor != textbgcolor)) drawChar(cursor_x, cursor_y, uniCode, textcolor, textbgcolor, textsize);
       cursor_x += pgm_read_byte(&glyph->xAdvance) * (int16_t)textsize;
     }
   }
@@ -5317,6 +6004,7 @@ int16_t TFT_eSPI::drawChar(uint16_t uniCode, int32_t x, int32_t y, uint8_t font)
       begin_tft_write();
 
       setWindow(xd, yd, xd + width - 1, yd + height - 1);
+      TRACE_PIXS(width * height);
 
       uint8_t mask;
       for (int32_t i = 0; i < height; i++) {
@@ -5352,43 +6040,29 @@ int16_t TFT_eSPI::drawChar(uint16_t uniCode, int32_t x, int32_t y, uint8_t font)
     w *= height; // Now w is total number of pixels in the character
     if (textcolor == textbgcolor && !clip) {
 
-      int32_t px = 0, py = pY; // To hold character block start and end column and row values
+      int32_t px = 0, py = 0; // Run start column and row in the character
       int32_t pc = 0; // Pixel count
-      uint8_t np = textsize * textsize; // Number of pixels in a drawn pixel
-
-      uint8_t tnp = 0; // Temporary copy of np for while loop
-      uint8_t ts = textsize - 1; // Temporary copy of textsize
-      // 16-bit pixel count so maximum font size is equivalent to 180x180 pixels in area
-      // w is total number of pixels to plot to fill character block
+      int32_t rl = 0; // Run length
+      int32_t sl = 0; // Span length
+      // Runs of foreground pixels are split into horizontal spans at the character edge
+      // and each span is drawn with one address window and a block write
+      // w is total number of pixels in character block
       while (pc < w) {
         line = pgm_read_byte((uint8_t *)flash_address);
         flash_address++;
         if (line & 0x80) {
-          line &= 0x7F;
-          line++;
-          if (ts) {
-            px = xd + textsize * (pc % width); // Keep these px and py calculations outside the loop as they are slow
-            py = yd + textsize * (pc / width);
-          }
-          else {
-            px = xd + pc % width; // Keep these px and py calculations outside the loop as they are slow
-            py = yd + pc / width;
-          }
-          while (line--) { // In this case the while(line--) is faster
-            pc++; // This is faster than putting pc+=line before while()?
-            setWindow(px, py, px + ts, py + ts);
-
-            if (ts) {
-              tnp = np;
-              while (tnp--) {tft_Write_16(textcolor);}
-            }
-            else {tft_Write_16(textcolor);}
-            px += textsize;
-
-            if (px >= (xd + width * textsize)) {
-              px = xd;
-              py += textsize;
-            }
+          rl = (line & 0x7F) + 1;
+          px = pc % width; // Keep these px and py calculations outside the loop as they are slow
+          py = pc / width;
+          pc += rl;
+          while (rl > 0) {
+            sl = width - px;
+            if (sl > rl) sl = rl;
+            setWindow(xd + px * textsize, yd + py * textsize, xd + (px + sl) * textsize - 1, yd + (py + 1) * textsize - 1);
+            pushBlock(textcolor, sl * textsize * textsize);
+            rl -= sl;
+            px = 0;
+            py++;
           }
         }
         else {
@@ -5506,9 +6180,124 @@ int16_t TFT_eSPI::drawString(const char *string, int32_t poX, int32_t poY, uint8
 {
   if (font > 8) return 0;
 
+  // Decode the string once into a glyph run, then position and draw the run
+  layoutGlyph glyphs[DRAW_STRING_GLYPHS];
+  TFT_eTextLayout layout(glyphs, DRAW_STRING_GLYPHS);
+
+  size_t len = strlen(string);
+
+  // A string has no more glyphs than bytes
+  if (len <= DRAW_STRING_GLYPHS) {
+    if (!layoutString(&layout, string, font)) return 0;
+    return drawLayout(&layout, poX, poY);
+  }
+
+  // A long string is laid out and drawn in chunks, the datum and padding are found from
+  // the width of the whole string
+  bool digits = isDigits;
+  int16_t width = textWidth(string, font);
+
+  // Fill the padding with an empty run that has the width of the string
+  if ((padX > width) && (textcolor != textbgcolor)) {
+    layout._valid    = true;
+    layout._fontRef  = layoutFont(font);
+    layout._font     = font;
+    layout._textsize = textsize;
+    layout._width    = width;
+    layout._advance  = width;
+    drawLayout(&layout, poX, poY);
+    layout.invalidate();
+  }
+
+  // Draw the chunks with the left datum on the same line
+  uint8_t  datum = textdatum;
+  uint16_t pad   = padX;
+  uint8_t  h     = datum % 3; // 0 = left, 1 = centre, 2 = right
+
+  int32_t x = poX - ((h == 1) ? width / 2 : (h == 2) ? width : 0);
+  textdatum = datum - h;
+  padX = 0;
+
+  int16_t  sumX = 0;
+  char     chunk[DRAW_STRING_GLYPHS + 1];
+#ifdef SMOOTH_FONT
+  uint16_t last = 0; // Last glyph of the previous chunk, for kerning
+#endif
+
+  while (len) {
+    size_t n = (len > DRAW_STRING_GLYPHS) ? DRAW_STRING_GLYPHS : len;
+
+    // Do not split a UTF-8 character
+    while ((n < len) && (n > 1) && ((string[n] & 0xC0) == 0x80)) n--;
+
+#ifdef SMOOTH_FONT
+    // Do not split a ligature pair, the character before the split starts the next chunk
+    if (fontLoaded && (n < len)) {
+      uint16_t p = n - 1;
+      while (_utf8 && (p > 0) && ((string[p] & 0xC0) == 0x80)) p--;
+      uint16_t i = p, j = n;
+      uint16_t first  = decodeUTF8((uint8_t*)string, &i, n - p);
+      uint16_t second = decodeUTF8((uint8_t*)string, &j, (len - n > 3) ? 3 : len - n);
+      if ((p > 0) && getLigature(first, second)) n = p;
+    }
+#endif
+
+    memcpy(chunk, string, n);
+    chunk[n] = 0;
+    string += n;
+    len    -= n;
+
+    // The last glyph of a chunk is positioned by its advance if more chunks follow
+    isDigits = digits || (len > 0);
+    if (!layoutString(&layout, chunk, font)) {
+      isDigits = digits; // restore state
+      break;
+    }
+
+#ifdef SMOOTH_FONT
+    // Kerning between the last glyph of the previous chunk and the first of this chunk
+    if (fontLoaded && layout._count) {
+      if (last) {
+        int16_t kern = getKerning(last, layout._glyphs[0].code);
+        x    += kern;
+        sumX += kern;
+      }
+      last = layout._glyphs[layout._count - 1].code;
+    }
+#endif
+
+    int16_t advance = drawLayout(&layout, x, poY);
+#ifdef SMOOTH_FONT
+    if (fontLoaded) advance = cursor_x - x;
+#endif
+    x    += advance;
+    sumX += advance;
+  }
+
+  textdatum = datum;
+  padX = pad;
+
+  return sumX;
+}
+
+
+/***************************************************************************************
+** Function name:           drawLayout
+** Description :            draw a string decoded by layoutString() with datum and padding
+***************************************************************************************/
+int16_t TFT_eSPI::drawLayout(TFT_eTextLayout *layout, int32_t poX, int32_t poY)
+{
+  // Layout must have been set up for the current font and text size
+  if (layout == nullptr || !layout->_valid) return 0;
+  if (layout->_fontRef != layoutFont(layout->_font) || layout->_textsize != textsize) return 0;
+
+  uint8_t font = layout->_font;
+
+  int32_t x = poX, y = poY; // Position before datum adjustment, used for a text strip
+
   int16_t sumX = 0;
   uint8_t padding = 1, baseline = 0;
-  uint16_t cwidth = textWidth(string, font); // Find the pixel width of the string in the font
+  uint16_t cwidth = layout->_width; // Pixel width of the string in the font
   uint16_t cheight = 8 * textsize;
 
 #ifdef LOAD_GFXFF
@@ -5603,19 +6392,15 @@ int16_t TFT_eSPI::drawString(const char *string, int32_t poX, int32_t poY, uint8
 
 
   int8_t xo = 0;
+  bool fillText = false; // Fill free font text background
 #ifdef LOAD_GFXFF
   if (freeFont && (textcolor!=textbgcolor)) {
       cheight = (glyph_ab + glyph_bb) * textsize;
       // Get the offset for the first character only to allow for negative offsets
-      uint16_t c2 = 0;
-      uint16_t len = strlen(string);
-      uint16_t n = 0;
-
-      while (n < len && c2 == 0) c2 = decodeUTF8((uint8_t*)string, &n, len - n);
+      uint16_t c2 = layout->_count ? layout->_glyphs[0].code : 0;
 
       if((c2 >= pgm_read_word(&gfxFont->first)) && (c2 <= pgm_read_word(&gfxFont->last) )) {
-        c2 -= pgm_read_word(&gfxFont->first);
-        GFXglyph *glyph = &(((GFXglyph *)pgm_read_dword(&gfxFont->glyph))[c2]);
+        GFXglyph *glyph = &(((GFXglyph *)pgm_read_dword(&gfxFont->glyph))[layout->_glyphs[0].index]);
         xo = pgm_read_byte(&glyph->xOffset) * textsize;
         // Adjust for negative xOffset
         if (xo > 0) xo = 0;
@@ -5623,14 +6408,93 @@ int16_t TFT_eSPI::drawString(const char *string, int32_t poX, int32_t poY, uint8
         // Add 1 pixel of padding all round
         //cheight +=2;
         //fillRect(poX+xo-1, poY - 1 - glyph_ab * textsize, cwidth+2, cheight, textbgcolor);
-        fillRect(poX+xo, poY - glyph_ab * textsize, cwidth, cheight, textbgcolor);
+        fillText = true;
       }
       padding -=100;
     }
 #endif
 
-  uint16_t len = strlen(string);
-  uint16_t n = 0;
+  // Compose the text, background and padding in a strip Sprite and push it in one window
+  if (_textStrip && (textcolor != textbgcolor)) {
+    int32_t bx = poX + xo, by = poY, bw = cwidth;
+#ifdef LOAD_GFXFF
+    if (freeFont) by -= glyph_ab * textsize;
+#endif
+    // Extend the strip to include the padding areas
+    if (padX > cwidth) {
+      if (padding == 1) bw = padX;
+      else if (padding == 2) {
+        bx -= (padX - cwidth) >> 1;
+        bw += ((padX - cwidth) >> 1) << 1;
+      }
+      else if (padding == 3) {
+        int32_t padXc = poX + cwidth + xo;
+        if (padXc > padX) padXc = padX;
+        if (padXc > cwidth) {
+          bx += cwidth - padXc;
+          bw = padXc;
+        }
+      }
+    }
+
+    bool stripFont = true;
+#if defined (SMOOTH_FONT) && defined (FONT_FS_AVAILABLE)
+    if (fontLoaded && fs_font) stripFont = false; // Font file cannot be shared
+#endif
+
+    TFT_eSprite strip(this);
+    strip.setColorDepth(16);
+    if (stripFont && bw > 0 && strip.createSprite(bw, cheight)) {
+      strip.setTextColor(textcolor, textbgcolor, _fillbg);
+      strip.setTextSize(textsize);
+      strip.setTextDatum(textdatum);
+      strip.setTextPadding(padX);
+      strip.setTextWrap(false, false);
+#ifdef LOAD_GFXFF
+      strip.gfxFont  = gfxFont;
+      strip.glyph_ab = glyph_ab;
+      strip.glyph_bb = glyph_bb;
+#endif
+#ifdef SMOOTH_FONT
+      // Share the smooth font metrics, they are not freed by the strip
+      if (fontLoaded) {
+        strip.gFont      = gFont;
+        strip.gUnicode   = gUnicode;
+        strip.gHeight    = gHeight;
+        strip.gWidth     = gWidth;
+        strip.gxAdvance  = gxAdvance;
+        strip.gdY        = gdY;
+        strip.gdX        = gdX;
+        strip.gBitmap    = gBitmap;
+        strip.gFormat    = gFormat;
+        strip.gBitmapEnd = gBitmapEnd;
+        strip.gSorted    = gSorted;
+        strip.gMapped    = gMapped;
+        strip.gMap       = gMap;
+        strip.gFontId    = gFontId;
+        strip.fontLoaded = true;
+      }
+#endif
+      strip.fillSprite(textbgcolor);
+      sumX = strip.drawLayout(layout, x - bx, y - by);
+      strip.pushSprite(bx, by);
+
+#ifdef LOAD_GFXFF
+      if (freeFont && (padX > cwidth)) sumX += bx; // Strip returns position relative to strip
+#endif
+#ifdef SMOOTH_FONT
+      if (fontLoaded) {
+        setCursor(strip.cursor_x + bx, strip.cursor_y + by);
+        strip.fontLoaded = false;
+      }
+#endif
+      return sumX;
+    }
+  }
+
+  if (fillText) fillRect(poX+xo, poY - glyph_ab * textsize, cwidth, cheight, textbgcolor);
+
+  layoutGlyph *glyph = layout->_glyphs;
 
 #ifdef SMOOTH_FONT
   if(fontLoaded) {
@@ -5640,10 +6504,11 @@ int16_t TFT_eSPI::drawString(const char *string, int32_t poX, int32_t poY, uint8
     // If padding is requested then fill the text background
     if (padX && !_fillbg) _fillbg = true;
 
-    while (n < len) {
-      uint16_t uniCode = decodeUTF8((uint8_t*)string, &n, len - n);
-      drawGlyph(uniCode);
+    for (uint16_t i = 0; i < layout->_count; i++) {
+      cursor_x += glyph[i].kern;
+      drawGlyph(glyph[i].code);
     }
+
     _fillbg = fillbg; // restore state
     sumX += cwidth;
     //fontFile.close();
@@ -5651,10 +6516,14 @@ int16_t TFT_eSPI::drawString(const char *string, int32_t poX, int32_t poY, uint8
   else
 #endif
   {
-    while (n < len) {
-      uint16_t uniCode = decodeUTF8((uint8_t*)string, &n, len - n);
-      sumX += drawChar(uniCode, poX+sumX, poY, font);
-    }
+    // Free font glyphs are drawn transparent over the string background
+    bool fillbg = _fillbg;
+    _fillbg = false;
+
+    for (uint16_t i = 0; i < layout->_count; i++) drawChar(glyph[i].code, poX + glyph[i].x, poY, font);
+
+    _fillbg = fillbg; // restore state
+    sumX += layout->_advance;
   }
 
 //vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv DEBUG vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
@@ -6005,10 +6874,8 @@ void TFT_eSPI::getSetup(setup_t &tft_settings)
   tft_settings.tft_spi_freq = 0;
 #else
   tft_settings.serial = true;
-  tft_settings.tft_spi_freq = SPI_FREQUENCY/100000;
-  #ifdef SPI_READ_FREQUENCY
-    tft_settings.tft_rd_freq = SPI_READ_FREQUENCY/100000;
-  #endif
+  tft_settings.tft_spi_freq = _spiWriteFreq/100000;
+  tft_settings.tft_rd_freq  = _spiReadFreq/100000;
   #ifndef GENERIC_PROCESSOR
     #ifdef TFT_SPI_PORT
       tft_settings.port = TFT_SPI_PORT;
@@ -6146,10 +7013,31 @@ void TFT_eSPI::getSetup(setup_t &tft_settings)
 
 #include "Extensions/Button.cpp"
 
+#include "Extensions/Sprite_pool.cpp"
+
 #include "Extensions/Sprite.cpp"
 
+#include "Extensions/Sprite_atlas.cpp"
+
+#include "Extensions/Animation.cpp"
+
+#include "Extensions/Terminal.cpp"
+
+#include "Extensions/Text_layout.cpp"
+
+#include "Extensions/Band_render.cpp"
+
+#include "Extensions/Bus_arbiter.cpp"
+
+#include "Extensions/Trace.cpp"
+
+#include "Extensions/Shadow.cpp"
+
+#include "Extensions/Multi_TFT.cpp"
+
 #ifdef SMOOTH_FONT
   #include "Extensions/Smooth_font.cpp"
+  #include "Extensions/Font.cpp"
 #endif
 
 #ifdef AA_GRAPHICS
@@ -213,6 +213,11 @@ extern "C" uint8_t external_psram_size __attribute__((weak));
   #endif
 #endif
 
+#ifdef SMOOTH_FONT
+  // Structure for smooth font tables compiled into the sketch
+  #include <Fonts/Smooth/smoothfont.h>
+#endif
+
 #ifdef LOAD_GFXFF
   // We can include all the free fonts and they will only be built into
   // the sketch if they are used
@@ -427,8 +432,21 @@ int16_t tch_spi_freq;// Touch controller read/write SPI frequency
 // Callback prototype for smooth font pixel colour read
 typedef uint16_t (*getColorCallback)(uint16_t x, uint16_t y);
 
+// Text layout glyph run, see Extensions/Text_layout.h
+class TFT_eTextLayout;
+
+// Smooth font handle, see Extensions/Font.h
+class TFT_eFont;
+
+// Shared SPI bus arbiter, see Extensions/Bus_arbiter.h
+class TFT_eBus;
+
+// Bus trace capture, see Extensions/Trace.h
+class TFT_eTrace;
+
 // Class functions and variables
 class TFT_eSPI : public Print { friend class TFT_eSprite; // Sprite class has access to protected members
+                               friend class TFT_eMulti;  // Multi panel scheduler keeps a window cache per panel
 
  //--------------------------------------- public ------------------------------------//
  public:
@@ -475,6 +493,13 @@ class TFT_eSPI : public Print { friend class TFT_eSprite; // Sprite class has ac
 
   void     invertDisplay(bool i);  // Tell TFT to invert all displayed colours
 
+           // Hardware vertical scrolling (ILI9341, ST7789 and ST7796), use in rotation 0
+           // Define the scrolling area between top and bottom fixed areas (in lines),
+           // returns false if the display driver does not support hardware scrolling
+  bool     setScrollArea(uint16_t top, uint16_t bottom);
+           // Set the screen line shown at the top of the scrolling area
+  void     setScrollStart(uint16_t line);
+
 
   // The TFT_eSprite class inherits the following functions (not all are useful to Sprite class
   void     setAddrWindow(int32_t xs, int32_t ys, int32_t w, int32_t h); // Note: start coordinates + width and height
@@ -653,6 +678,14 @@ class TFT_eSPI : public Print { friend class TFT_eSprite; // Sprite class has ac
            drawCentreString(const String& string, int32_t x, int32_t y, uint8_t font),// Deprecated, use setTextDatum() and drawString()
            drawRightString(const String& string, int32_t x, int32_t y, uint8_t font); // Deprecated, use setTextDatum() and drawString()
 
+           // Draw a string decoded by layoutString(), uses the text datum and padding settings
+  int16_t  drawLayout(TFT_eTextLayout *layout, int32_t x, int32_t y);
+
+           // Decode a string once into a glyph run with glyph positions and string width.
+           // The string is not decoded again if the string, font and text size are unchanged.
+           // Returns false if the layout buffer is too small.
+  bool     layoutString(TFT_eTextLayout *layout, const char *string, uint8_t font);
+
 
   // Text rendering and font handling support functions
   void     setCursor(int16_t x, int16_t y),                 // Set cursor for tft.print()
@@ -662,7 +695,7 @@ class TFT_eSPI : public Print { friend class TFT_eSprite; // Sprite class has ac
            getCursorY(void);                                // Read current cursor y position
 
   void     setTextColor(uint16_t color),                    // Set character (glyph) color only (background not over-written)
-           setTextColor(uint16_t fgcolor, uint16_t bgcolor, bool bgfill = false),  // Set character (glyph) foreground and background colour, optional background fill for smooth fonts
+           setTextColor(uint16_t fgcolor, uint16_t bgcolor, bool bgfill = false),  // Set character (glyph) foreground and background colour, optional background fill for smooth and free fonts
            setTextSize(uint8_t size);                       // Set character size multiplier (this increases pixel size)
 
   void     setTextWrap(bool wrapX, bool wrapY = false);     // Turn on/off wrapping of text in TFT width and/or height
@@ -673,6 +706,10 @@ class TFT_eSPI : public Print { friend class TFT_eSprite; // Sprite class has ac
   void     setTextPadding(uint16_t x_width);                // Set text padding (background blanking/over-write) width in pixels
   uint16_t getTextPadding(void);                            // Get text padding
 
+                                                            // Compose opaque strings (text, background and padding) in a
+  void     setTextStrip(bool strip);                        // 16 bit Sprite and push it in one window, avoids flicker (TFT only)
+  bool     getTextStrip(void);
+
 #ifdef LOAD_GFXFF
   void     setFreeFont(const GFXfont *f = NULL),            // Select the GFX Free Font
            setTextFont(uint8_t font);                       // Set the font number to use in future
@@ -691,10 +728,16 @@ class TFT_eSPI : public Print { friend class TFT_eSprite; // Sprite class has ac
            // Used by library and Smooth font class to extract Unicode point codes from a UTF8 encoded string
   uint16_t decodeUTF8(uint8_t *buf, uint16_t *index, uint16_t remaining),
            decodeUTF8(uint8_t c);
+           // Decode a string of length bytes from index into up to size Unicode points, index is
+           // updated and the number of points is returned. ASCII is decoded 4 bytes at a time.
+  uint16_t decodeUTF8(const uint8_t *buf, uint16_t *index, uint16_t length, uint16_t *unicode, uint16_t size);
 
            // Support function to UTF8 decode and draw characters piped through print stream
   size_t   write(uint8_t);
-           // size_t   write(const uint8_t *buf, size_t len);
+#ifndef ARDUINO_ARCH_ESP8266 // Avoid ESP8266 board package bug
+           // Decodes the whole buffer in one pass, used by print()
+  size_t   write(const uint8_t *buf, size_t len);
+#endif
 
            // Used by Smooth font class to fetch a pixel colour for the anti-aliasing
   void     setCallback(getColorCallback getCol);
@@ -783,15 +826,43 @@ class TFT_eSPI : public Print { friend class TFT_eSprite; // Sprite class has ac
            //
            // Note 2: If part of the image will be off screen or outside of a set viewport, then the the original
            // image buffer content will be altered to a correctly clipped image before DMA is initiated.
+           // The RP2040 sends the rows of a clipped image in place, so the image is not altered. The ESP32
+           // also sends the rows in place unless the bytes are swapped (Note 1), rows that do not start on a
+           // 4 byte boundary are sent through the bounce buffers (Note 4).
            //
            // The function will wait for the last DMA to complete if it is called while a previous DMA is still
            // in progress, this simplifies the sketch and helps avoid "gotchas".
+           //
+           // Note 3: On the ESP32 the window commands are queued with the image. After setDMAQueue(true) the
+           // function does not wait for the last DMA unless the original image buffer must be altered (Note 1
+           // and 2), up to DMA_QUEUE_SIZE/6 images can then be queued. A clipped image sends one transfer per
+           // row, so it waits for the earlier rows if it has more rows than the queue holds.
+           //
+           // Note 4: The original ESP32 cannot DMA from PSRAM, an image in PSRAM (without a buffer) is copied
+           // (and byte swapped if required) to DMA_BOUNCE_BUFFERS internal RAM buffers as it is sent, each
+           // buffer is refilled when its transfer is complete. The image is not altered.
   void     pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* data, uint16_t* buffer = nullptr);
 
 #if defined (ESP32) // ESP32 only at the moment
            // For case where pointer is a const and the image data must not be modified (clipped or byte swapped)
   void     pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t const* data);
 #endif
+
+#if defined (ESP32_DMA_QUEUE) // Original ESP32 and ESP32-S2 SPI only
+           // Queue images without waiting for the last DMA (see Note 3 above). The sketch must not change
+           // a buffer or image that was pushed until dmaBusy() returns false. Default is false.
+  void     setDMAQueue(bool queue);
+
+           // Fill a rectangle using DMA, the function returns when the transfers are queued so
+           // the CPU is free during large fills such as a screen clear. The transfers all read one
+           // colour buffer of DMA_FILL_SIZE pixels, a fill with a new colour waits for queued
+           // transfers to complete before the buffer is changed. Call dmaWait() before other
+           // (non DMA) TFT functions are used.
+  void     fillRectDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color);
+
+           // Push len pixels of one colour into a window set up using setAddrWindow()
+  void     pushBlockDMA(uint16_t color, uint32_t len);
+#endif
            // Push a block of pixels into a window set up using setAddrWindow()
   void     pushPixelsDMA(uint16_t* image, uint32_t len);
 
@@ -799,6 +870,13 @@ class TFT_eSPI : public Print { friend class TFT_eSprite; // Sprite class has ac
   bool     dmaBusy(void); // returns true if DMA is still in progress
   void     dmaWait(void); // wait until DMA is complete
 
+#if defined (RP2040_DMA)
+           // Set a function to be called when a DMA transfer completes. The function is called from an
+           // interrupt, so must be short. The last pixels may still be in the SPI FIFO, call dmaWait()
+           // before other TFT functions are used.
+  void     setDMACallback(void (*callback)(void));
+#endif
+
   bool     DMA_Enabled = false;   // Flag for DMA enabled state
   uint8_t  spiBusyCheck = 0;      // Number of ESP32 transfer buffers to check
 
@@ -807,6 +885,35 @@ class TFT_eSPI : public Print { friend class TFT_eSprite; // Sprite class has ac
   void     writeColor(uint16_t color, uint32_t len); // Deprecated, use pushBlock()
   void     endWrite(void);                           // End SPI transaction
 
+#if defined (ESP32)
+           // Share the SPI bus with other tasks and devices, see Extensions/Bus_arbiter.h.
+           // Use nullptr to detach the bus.
+  void     setBus(TFT_eBus *bus);
+           // Close a transaction kept open by the bus deferred release option
+  void     releaseBus(void);
+#endif
+
+           // Set the SPI write and read clocks at run time, 0 leaves a clock unchanged. The
+           // clocks are used from the next transaction, DMA uses the write clock set when
+           // initDMA() is called.
+  void     setSPIFrequency(uint32_t write, uint32_t read = 0);
+  uint32_t getSPIWriteFrequency(void);
+  uint32_t getSPIReadFrequency(void);
+
+           // Find the fastest reliable SPI clocks. Test patterns are written to the top left
+           // corner of the screen and read back with readRect(). Each clock is raised in 25%
+           // steps from the setup file value up to maxFreq until an error is seen, then the
+           // last good clock is reduced by margin percent. The screen area is restored and the
+           // viewport is reset. Returns false if the pattern cannot be read back at the setup
+           // file clocks (e.g. MISO not connected), the setup file clocks are then used.
+           // The result can be saved (e.g. with Preferences) and set with setSPIFrequency().
+  bool     tuneSPIFrequency(uint32_t maxFreq = 80000000, uint8_t margin = 20);
+
+#ifdef TFT_TRACE
+           // Record bus operations, called by TFT_eTrace::begin() and end()
+  void     setTrace(TFT_eTrace *trace);
+#endif
+
   // Set/get an arbitrary library configuration attribute or option
   //       Use to switch ON/OFF capabilities such as UTF8 decoding - each attribute has a unique ID
   //       id = 0: reserved - may be used in future to reset all attributes to a default state
@@ -839,6 +946,9 @@ class TFT_eSPI : public Print { friend class TFT_eSprite; // Sprite class has ac
   uint8_t  decoderState = 0;   // UTF8 decoder state        - not for user access
   uint16_t decoderBuffer;      // Unicode code-point buffer - not for user access
 
+  size_t   writeUnicode(uint16_t code);                   // Draw a decoded print stream character
+  uint16_t completeUTF8(const uint8_t *buf, uint16_t length); // Length without a split last character
+
  //--------------------------------------- private ------------------------------------//
  private:
            // Legacy begin and end prototypes - deprecated TODO: delete
@@ -883,6 +993,14 @@ class TFT_eSPI : public Print { friend class TFT_eSprite; // Sprite class has ac
            // Helper function: calculate distance of a point from a finite length line between two points
   float    wedgeLineDistance(float pax, float pay, float bax, float bay, float dr);
 
+           // Text layout helper: returns a key that identifies the free or smooth font in use
+  const void* layoutFont(uint8_t font);
+
+#if defined (ESP32)
+           // DMA queue helper: queue the window commands so they are sent without CPU involvement
+  void     dmaQueueWindow(int32_t x, int32_t y, int32_t w, int32_t h);
+#endif
+
            // Display variant settings
   uint8_t  tabcolor,                   // ST7735 screen protector "tab" colour (now invalid)
            colstart = 0, rowstart = 0; // Screen display area to CGRAM area coordinate offsets
@@ -906,9 +1024,27 @@ class TFT_eSPI : public Print { friend class TFT_eSprite; // Sprite class has ac
 
   bool     locked, inTransaction, lockTransaction; // SPI transaction and mutex lock flags
 
+#if defined (ESP32)
+  TFT_eBus *_bus;                 // Shared bus arbiter, nullptr if not used
+#endif
+
+#ifdef TFT_TRACE
+  TFT_eTrace *_trace;             // Bus trace, nullptr if not recording
+#endif
+
  //-------------------------------------- protected ----------------------------------//
  protected:
 
+  uint32_t _spiWriteFreq = SPI_FREQUENCY;      // SPI clocks, see setSPIFrequency()
+  uint32_t _spiReadFreq  = SPI_READ_FREQUENCY;
+
+#if defined (ESP32_DMA_QUEUE)
+  bool     _dmaQueue = false;                   // Deep DMA image queue, see setDMAQueue()
+#endif
+
+           // Write and/or read back a tuneSPIFrequency() test pattern, true if it matches
+  bool     tuneCheck(uint16_t *pattern, uint16_t *buffer, uint32_t seed, bool write);
+
   //int32_t  win_xe, win_ye;          // Window end coords - not needed
 
   int32_t  _init_width, _init_height; // Display w/h as input, used by setRotation()
@@ -949,7 +1085,8 @@ class TFT_eSPI : public Print { friend class TFT_eSprite; // Sprite class has ac
 
   uint32_t _lastColor; // Buffered value of last colour used
 
-  bool     _fillbg;    // Fill background flag (just for for smooth fonts at the moment)
+  bool     _fillbg;    // Fill background flag (smooth and free fonts)
+  bool     _textStrip; // Draw opaque strings via a strip Sprite
 
 #if defined (SSD1963_DRIVER)
   uint16_t Cswap;      // Swap buffer for SSD1963
@@ -983,6 +1120,9 @@ class TFT_eSPI : public Print { friend class TFT_eSprite; // Sprite class has ac
   #include "Extensions/Smooth_font.h"  // Loaded if SMOOTH_FONT is defined by user
 #endif
 
+// Load the shadow content map extension
+#include "Extensions/Shadow.h"
+
 }; // End of class TFT_eSPI
 
 // Swap any type
@@ -1009,7 +1149,39 @@ fastBlend(A alpha, F fgc, B bgc)
 // Load the Button Class
 #include "Extensions/Button.h"
 
+// Load the Sprite memory pool Class
+#include "Extensions/Sprite_pool.h"
+
 // Load the Sprite Class
 #include "Extensions/Sprite.h"
 
+// Load the Sprite atlas Class
+#include "Extensions/Sprite_atlas.h"
+
+// Load the animation player Class
+#include "Extensions/Animation.h"
+
+// Load the text terminal Class
+#include "Extensions/Terminal.h"
+
+// Load the text layout Class
+#include "Extensions/Text_layout.h"
+
+// Load the dual core band renderer Class
+#include "Extensions/Band_render.h"
+
+// Load the shared bus arbiter Class
+#include "Extensions/Bus_arbiter.h"
+
+// Load the bus trace Class
+#include "Extensions/Trace.h"
+
+// Load the multi panel scheduler Class
+#include "Extensions/Multi_TFT.h"
+
+// Load the smooth font handle Class
+#ifdef SMOOTH_FONT
+  #include "Extensions/Font.h"
+#endif
+
 #endif // ends #ifndef _TFT_eSPIH_
@@ -0,0 +1,385 @@
+'''
+
+    This script compiles a smooth font into C++ constexpr tables that
+    TFT_eSPI can use in place with loadFont(const smoothFont &font).
+
+    The glyphs are sorted by Unicode so the library can use a binary
+    search, and all metrics are ready to use. Loading the font does not
+    allocate memory or parse the font data, which speeds up boot.
+
+    Input can be:
+      .vlw  a font made by the Create_font Processing sketch
+      .bdf  a bitmap font (pixels are fully opaque)
+      .ttf  or .otf, rasterised with anti-aliasing at the size given by -s
+
+    You'll need python 3.6, and for .ttf/.otf input the Pillow library
+    version 8 or later (pip install pillow)
+
+    usage: python font2table.py [-v] NotoSans-Bold.vlw [-o NotoSansBold15.h]
+           python font2table.py -s 28 -r 0x20-0x7E -r 0xA0-0xFF Roboto.ttf -k
+           python font2table.py -e 0 -n Terminus font.bdf
+
+'''
+
+import sys
+import argparse
+import os
+import struct
+
+VLW_EXT_MAGIC = 0x54465458
+
+VLW_ALPHA_8   = 0
+VLW_ALPHA_4   = 1
+VLW_ALPHA_RLE = 2
+
+debug = None
+
+def debugOut(s):
+    if debug:
+        print(s)
+
+class Glyph:
+    def __init__(self, code, width, height, xAdvance, dY, dX, alpha):
+        self.code = code
+        self.width = width
+        self.height = height
+        self.xAdvance = xAdvance
+        self.dY = dY
+        self.dX = dX
+        self.alpha = alpha  # 8-bit alpha, width * height bytes
+
+class Font:
+    def __init__(self):
+        self.glyphs = []
+        self.ascent = 0
+        self.descent = 0
+        self.kerning = []   # (first, second, adjust)
+        self.ligatures = [] # (first, second, ligature)
+
+def decodeAlpha(data, fmt, w, h):
+    # Convert a compressed vlw glyph bitmap to 8-bit alpha
+    if fmt == VLW_ALPHA_8:
+        return bytes(data[:w * h])
+    if fmt == VLW_ALPHA_4:
+        alpha = bytearray()
+        for i in range(w * h):
+            nibble = data[i >> 1] >> 4 if (i & 1) == 0 else data[i >> 1] & 0x0F
+            alpha.append(nibble * 17)
+        return bytes(alpha)
+    alpha = bytearray()
+    i = 0
+    while len(alpha) < w * h:
+        n = data[i]
+        i += 1
+        if n & 0x80:
+            count = (n & 0x7F) + 1
+            alpha += data[i:i + count]
+            i += count
+        else:
+            alpha += bytes([0xFF if n & 0x40 else 0]) * ((n & 0x3F) + 1)
+    return bytes(alpha)
+
+def readVlw(name):
+    with open(name, "rb") as f:
+        data = f.read()
+    font = Font()
+    gCount, version, size, extOffset, font.ascent, font.descent = struct.unpack_from(">6I", data, 0)
+    bitmapPtr = 24 + gCount * 28
+    for g in range(gCount):
+        code, h, w, adv, dy, dx, fmt = struct.unpack_from(">7i", data, 24 + g * 28)
+        fmt &= 0xFFFFFFFF
+        bytesUsed = fmt & 0xFFFFFF if fmt else w * h
+        alpha = decodeAlpha(data[bitmapPtr:bitmapPtr + bytesUsed], fmt >> 24, w, h)
+        bitmapPtr += bytesUsed
+        font.glyphs.append(Glyph(code, w, h, adv, dy, dx, alpha))
+    if extOffset and extOffset + 12 <= len(data):
+        magic, kCount, lCount = struct.unpack_from(">3I", data, extOffset)
+        if magic == VLW_EXT_MAGIC:
+            p = extOffset + 12
+            for i in range(kCount):
+                font.kerning.append(struct.unpack_from(">HHh", data, p))
+                p += 6
+            for i in range(lCount):
+                font.ligatures.append(struct.unpack_from(">HHH", data, p))
+                p += 6
+    return font
+
+def readBdf(name):
+    font = Font()
+    fontAscent = None
+    fontDescent = None
+    with open(name, "r", encoding="latin-1") as f:
+        lines = f.read().splitlines()
+    i = 0
+    while i < len(lines):
+        words = lines[i].split()
+        i += 1
+        if not words:
+            continue
+        if words[0] == "FONT_ASCENT":
+            fontAscent = int(words[1])
+        elif words[0] == "FONT_DESCENT":
+            fontDescent = int(words[1])
+        elif words[0] == "STARTCHAR":
+            code = -1
+            adv = 0
+            w = h = xo = yo = 0
+            rows = []
+            while i < len(lines):
+                words = lines[i].split()
+                i += 1
+                if not words:
+                    continue
+                if words[0] == "ENCODING":
+                    code = int(words[1])
+                elif words[0] == "DWIDTH":
+                    adv = int(words[1])
+                elif words[0] == "BBX":
+                    w, h, xo, yo = [int(v) for v in words[1:5]]
+                elif words[0] == "BITMAP":
+                    while i < len(lines) and lines[i].strip() != "ENDCHAR":
+                        rows.append(int(lines[i].strip(), 16))
+                        i += 1
+                elif words[0] == "ENDCHAR":
+                    break
+            if code < 0 or code > 0xFFFF:
+                continue
+            rowBits = ((w + 7) // 8) * 8
+            alpha = bytearray()
+            for y in range(h):
+                bits = rows[y] if y < len(rows) else 0
+                for x in range(w):
+                    alpha.append(0xFF if bits & (1 << (rowBits - 1 - x)) else 0)
+            font.glyphs.append(Glyph(code, w, h, adv, h + yo, xo, bytes(alpha)))
+    metricsFromGlyphs(font)
+    if fontAscent is not None and font.ascent == 0:
+        font.ascent = fontAscent
+    if fontDescent is not None and font.descent == 0:
+        font.descent = fontDescent
+    return font
+
+def parseRanges(ranges):
+    codes = []
+    for r in ranges:
+        for part in r.split(","):
+            if "-" in part:
+                first, last = part.split("-")
+                codes += range(int(first, 0), int(last, 0) + 1)
+            else:
+                codes.append(int(part, 0))
+    return codes
+
+def readTtf(name, size, codes, kerning):
+    try:
+        from PIL import Image, ImageDraw, ImageFont
+    except ImportError:
+        print("The Pillow library is needed for TrueType fonts: pip install pillow")
+        sys.exit(1)
+    ttf = ImageFont.truetype(name, size)
+    font = Font()
+    for code in codes:
+        ch = chr(code)
+        left, top, right, bottom = ttf.getbbox(ch, anchor="ls")
+        w = max(0, right - left)
+        h = max(0, bottom - top)
+        img = Image.new("L", (max(1, w), max(1, h)), 0)
+        ImageDraw.Draw(img).text((-left, -top), ch, font=ttf, fill=255, anchor="ls")
+        alpha = img.tobytes()[:w * h] if w and h else b""
+        adv = int(round(ttf.getlength(ch)))
+        font.glyphs.append(Glyph(code, w, h, adv, -top, left, alpha))
+    metricsFromGlyphs(font)
+    if kerning:
+        chars = [chr(g.code) for g in font.glyphs]
+        if len(chars) > 256:
+            print("More than 256 characters, kerning not added")
+        else:
+            advance = {c: ttf.getlength(c) for c in chars}
+            for a in chars:
+                for b in chars:
+                    kern = int(round(ttf.getlength(a + b) - advance[a] - advance[b]))
+                    if kern:
+                        font.kerning.append((ord(a), ord(b), kern))
+    return font
+
+def metricsFromGlyphs(font):
+    # As for the Create_font sketch, ascent is the top of "d" and descent the bottom of "p"
+    for g in font.glyphs:
+        if g.code == ord("d"):
+            font.ascent = g.dY
+        if g.code == ord("p"):
+            font.descent = g.height - g.dY
+
+def encodeAlpha4(alpha):
+    data = bytearray((len(alpha) + 1) // 2)
+    for i, a in enumerate(alpha):
+        nibble = int(a / 17.0 + 0.5)
+        if (i & 1) == 0:
+            data[i >> 1] = nibble << 4
+        else:
+            data[i >> 1] |= nibble
+    return bytes(data)
+
+def encodeRle(alpha, w, h):
+    # Runs end at the end of each row, see loadFont() in Smooth_font.cpp
+    data = bytearray()
+    for y in range(h):
+        row = alpha[y * w:(y + 1) * w]
+        x = 0
+        while x < w:
+            a = row[x]
+            n = 1
+            if a == 0 or a == 0xFF:
+                while x + n < w and n < 64 and row[x + n] == a:
+                    n += 1
+                data.append((0x00 if a == 0 else 0x40) | (n - 1))
+            else:
+                while x + n < w and n < 128 and row[x + n] not in (0, 0xFF):
+                    n += 1
+                data.append(0x80 | (n - 1))
+                data += row[x:x + n]
+            x += n
+    return bytes(data)
+
+def encodeGlyph(g, encoding):
+    if encoding == VLW_ALPHA_4:
+        data = encodeAlpha4(g.alpha)
+    elif encoding == VLW_ALPHA_RLE:
+        data = encodeRle(g.alpha, g.width, g.height)
+    else:
+        return VLW_ALPHA_8, g.alpha
+    # Keep 8-bit alpha if encoding does not make the bitmap smaller
+    if len(data) < len(g.alpha):
+        return encoding, data
+    return VLW_ALPHA_8, g.alpha
+
+def checkGlyph(g):
+    if not (0 <= g.width <= 255 and 0 <= g.height <= 255 and 0 <= g.xAdvance <= 255 and -128 <= g.dX <= 127):
+        print("Glyph 0x{:04X} is too large for the font tables".format(g.code))
+        sys.exit(1)
+
+def writeArray(out, decl, values, fmt, perLine=16):
+    out.write("{} = {{\n".format(decl))
+    for i in range(0, len(values), perLine):
+        out.write("  " + ", ".join(fmt.format(v) for v in values[i:i + perLine]) + ",\n")
+    out.write("};\n\n")
+
+def writeTable(out, name, entries):
+    data = []
+    for e in sorted(entries, key=lambda e: (e[0], e[1])):
+        for v in e:
+            v &= 0xFFFF
+            data += [v >> 8, v & 0xFF]
+    writeArray(out, "static const uint8_t {}[] PROGMEM".format(name), data, "0x{:02X}")
+
+# look at arguments
+parser = argparse.ArgumentParser(description="Compile a vlw, bdf or TrueType font into TFT_eSPI smooth font tables")
+parser.add_argument("-v", "--verbose", help="debug output", action="store_true")
+parser.add_argument("input", help="input .vlw, .bdf, .ttf or .otf font file")
+parser.add_argument("-o", "--output", help="output file name")
+parser.add_argument("-n", "--name", help="font name used in the sketch")
+parser.add_argument("-e", "--encoding", type=int, choices=[0, 1, 2], default=2,
+                    help="glyph bitmaps: 0 = 8-bit alpha, 1 = 4-bit alpha, 2 = run length encoded (default)")
+parser.add_argument("-s", "--size", type=int, default=20, help="TrueType font size in pixels")
+parser.add_argument("-r", "--range", action="append",
+                    help="TrueType Unicode range(s) e.g. 0x20-0x7E,0xB0 (default 0x20-0x7E)")
+parser.add_argument("-k", "--kerning", help="add TrueType kerning pairs", action="store_true")
+args = parser.parse_args()
+
+debug = args.verbose
+
+if not os.path.exists(args.input):
+    parser.print_help()
+    print("The input file {} does not exist".format(args.input))
+    sys.exit(1)
+
+ext = os.path.splitext(args.input)[1].lower()
+if ext == ".vlw":
+    font = readVlw(args.input)
+elif ext == ".bdf":
+    font = readBdf(args.input)
+elif ext in (".ttf", ".otf"):
+    font = readTtf(args.input, args.size, parseRanges(args.range or ["0x20-0x7E"]), args.kerning)
+else:
+    print("Unknown font file type {}".format(ext))
+    sys.exit(1)
+
+# Sort by Unicode for the binary search, the first of any duplicates is kept
+glyphs = []
+for g in sorted(font.glyphs, key=lambda g: g.code):
+    if glyphs and glyphs[-1].code == g.code:
+        continue
+    checkGlyph(g)
+    glyphs.append(g)
+
+if not glyphs:
+    print("No glyphs found")
+    sys.exit(1)
+
+# Font metrics as calculated by loadMetrics() in Smooth_font.cpp
+maxAscent = font.ascent
+maxDescent = font.descent
+for g in glyphs:
+    if g.height - g.dY > maxDescent:
+        if (0x20 < g.code < 0xA0 and g.code != 0x7F) or g.code > 0xFF:
+            maxDescent = g.height - g.dY
+yAdvance = maxAscent + maxDescent
+spaceWidth = (font.ascent + font.descent) * 2 // 7
+
+bitmap = bytearray()
+offsets = []
+formats = []
+for g in glyphs:
+    fmt, data = encodeGlyph(g, args.encoding)
+    offsets.append(len(bitmap))
+    formats.append(fmt)
+    bitmap += data
+    debugOut("0x{:04X}: {} x {}, {} bytes".format(g.code, g.width, g.height, len(data)))
+
+# Only keep ligatures where the replacement glyph is in the font
+codes = set(g.code for g in glyphs)
+ligatures = [l for l in font.ligatures if l[2] in codes]
+
+if args.output is None:
+    output = os.path.splitext(os.path.basename(args.input))[0] + ".h"
+else:
+    output = args.output
+
+fontName = args.name if args.name else os.path.splitext(os.path.basename(output))[0]
+fontName = "".join(c if c.isalnum() else "_" for c in fontName)
+if fontName[0].isdigit():
+    fontName = "_" + fontName
+
+with open(output, "w") as out:
+    out.write("// Smooth font compiled by font2table.py from {}\n".format(os.path.basename(args.input)))
+    out.write("// {} glyphs, {} bytes of bitmaps, line advance {} pixels\n".format(len(glyphs), len(bitmap), yAdvance))
+    out.write("// #include this file after TFT_eSPI.h and use: tft.loadFont({});\n\n".format(fontName))
+    out.write("#include <pgmspace.h>\n\n")
+
+    writeArray(out, "static constexpr uint16_t {}_unicode[]".format(fontName), [g.code for g in glyphs], "0x{:04X}", 12)
+    writeArray(out, "static constexpr uint8_t {}_height[]".format(fontName), [g.height for g in glyphs], "{}")
+    writeArray(out, "static constexpr uint8_t {}_width[]".format(fontName), [g.width for g in glyphs], "{}")
+    writeArray(out, "static constexpr uint8_t {}_xAdvance[]".format(fontName), [g.xAdvance for g in glyphs], "{}")
+    writeArray(out, "static constexpr int16_t {}_dY[]".format(fontName), [g.dY for g in glyphs], "{}")
+    writeArray(out, "static constexpr int8_t {}_dX[]".format(fontName), [g.dX for g in glyphs], "{}")
+    writeArray(out, "static constexpr uint32_t {}_bitmapOffset[]".format(fontName), offsets, "{}", 12)
+    writeArray(out, "static constexpr uint8_t {}_format[]".format(fontName), formats, "{}")
+    writeArray(out, "static const uint8_t {}_bitmap[] PROGMEM".format(fontName), list(bitmap) or [0], "0x{:02X}")
+
+    kerning = "nullptr"
+    if font.kerning:
+        writeTable(out, fontName + "_kerning", font.kerning)
+        kerning = fontName + "_kerning"
+    ligature = "nullptr"
+    if ligatures:
+        writeTable(out, fontName + "_ligature", ligatures)
+        ligature = fontName + "_ligature"
+
+    out.write("static constexpr smoothFont {} = {{\n".format(fontName))
+    out.write("  {}, {}, {}, {}, {}, {}, {},\n".format(len(glyphs), yAdvance, spaceWidth,
+                                                      font.ascent, font.descent, maxAscent, maxDescent))
+    out.write("  {0}_unicode, {0}_height, {0}_width, {0}_xAdvance, {0}_dY, {0}_dX,\n".format(fontName))
+    out.write("  {0}_bitmapOffset, {0}_format, {0}_bitmap, {1},\n".format(fontName, len(bitmap)))
+    out.write("  {}, {}, {}, {}\n".format(kerning, len(font.kerning), ligature, len(ligatures)))
+    out.write("};\n")
+
+print("Written {} ({} glyphs, {} bytes of bitmaps)".format(output, len(glyphs), len(bitmap)))
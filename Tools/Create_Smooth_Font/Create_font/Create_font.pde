@@ -111,6 +111,16 @@ Software License Agreement (FreeBSD License)
 
 
 import java.awt.Desktop; // Required to allow sketch to open file windows
+import java.awt.font.FontRenderContext; // Required for kerning
+import java.awt.font.TextAttribute;
+import java.awt.font.TextLayout;
+import java.io.ByteArrayOutputStream;
+import java.nio.ByteBuffer;
+import java.io.DataOutputStream;
+import java.util.Arrays;
+import java.util.Collections;
+import java.util.Comparator;
+import java.util.Map;
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -145,6 +155,41 @@ boolean createHeaderFile = true;
 // Automaticely open the folder with created files when done
 boolean openFolder = true;
 
+// Glyph bitmap encoding, older versions of TFT_eSPI and other vlw readers cannot draw
+// fonts using 1 or 2:
+//   0 = 8-bit alpha, the original Processing format
+//   1 = 4-bit alpha, half the size of 0 but with 16 levels of anti-aliasing
+//   2 = run length encoded 8-bit alpha, only smaller than 1 for large glyphs with few
+//       anti-aliased edge pixels (e.g. NotoSansBold15 is 2% smaller than 0, NotoSansBold36
+//       is 47% smaller than 0 but larger than 1)
+// Use 1 where a smaller font is needed, 0 keeps the font readable by any vlw reader.
+int glyphEncoding = 0;
+
+// Add kerning pairs for the characters in the font. The kerning and ligature tables are
+// added at the end of the vlw file, older versions of TFT_eSPI ignore them.
+boolean addKerning = true;
+
+// Add a glyph map to the extended table, so the library can use the font metrics in place
+// from a FLASH array without allocating memory, see loadFont(array, true) in TFT_eSPI.
+// Older versions of TFT_eSPI and other vlw readers cannot read a font with a glyph map.
+boolean addGlyphMap = false;
+
+// Kerning is only calculated if the font has up to this number of characters, as every
+// pair of characters is measured
+int kerningMaxChars = 256;
+
+// Ligatures: a pair of Unicodes that is replaced by a single glyph. The ligature glyph
+// must be included in the font (e.g. add 0xFB01 and 0xFB02 to the specificUnicodes).
+// A ligature can be the first of a pair, so "ffi" can be made from "ff" and "i".
+static final int[] ligatures = {
+  // first,  second, ligature
+  //0x0066, 0x0069, 0xFB01, // fi
+  //0x0066, 0x006C, 0xFB02, // fl
+  //0x0066, 0x0066, 0xFB00, // ff
+  //0xFB00, 0x0069, 0xFB03, // ffi
+  //0xFB00, 0x006C, 0xFB04, // ffl
+};
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Next we specify which unicode blocks from the the Basic Multilingual Plane (BMP) are included in the final font file. //
 // Note: The ttf/otf font file MAY NOT contain all possible Unicode characters, refer to the fonts online documentation. //
@@ -511,8 +556,11 @@ void setup() {
   try {
     print("Saving to sketch FontFiles folder... ");
 
+    ByteArrayOutputStream vlw = new ByteArrayOutputStream();
+    font.save(vlw);
+
     OutputStream output = createOutput(fontFileName);
-    font.save(output);
+    output.write(addExtendedTable(encodeGlyphs(vlw.toByteArray()), font, charset));
     output.close();
 
     println("OK!");
@@ -568,3 +616,214 @@ void setup() {
     println("Failed to create C header file");
   }
 }
+
+
+// Re-encode the glyph bitmaps in the vlw file data using the glyphEncoding setting. The
+// bitmap format and size are put in glyph parameter 7, see Smooth_font.cpp in TFT_eSPI.
+byte[] encodeGlyphs(byte[] vlw) throws IOException {
+  if (glyphEncoding == 0) return vlw;
+
+  ByteBuffer in = ByteBuffer.wrap(vlw);
+  int gCount = in.getInt(0);
+  int bitmapPtr = 24 + gCount * 28;
+
+  ByteArrayOutputStream bitmaps = new ByteArrayOutputStream();
+  int[] format = new int[gCount];
+  int oldSize = 0;
+
+  for (int g = 0; g < gCount; g++) {
+    int h = in.getInt(24 + g * 28 + 4);
+    int w = in.getInt(24 + g * 28 + 8);
+    byte[] alpha = Arrays.copyOfRange(vlw, bitmapPtr, bitmapPtr + w * h);
+    bitmapPtr += w * h;
+    oldSize += w * h;
+
+    byte[] encoded = (glyphEncoding == 1) ? encodeAlpha4(alpha) : encodeRLE(alpha, w, h);
+
+    // Keep the 8-bit bitmap if encoding does not make it smaller
+    if (encoded.length < alpha.length) {
+      format[g] = (glyphEncoding << 24) | encoded.length;
+      bitmaps.write(encoded);
+    } else {
+      bitmaps.write(alpha);
+    }
+  }
+
+  ByteArrayOutputStream bytes = new ByteArrayOutputStream();
+  bytes.write(vlw, 0, 24 + gCount * 28);
+  bytes.write(bitmaps.toByteArray());
+  bytes.write(vlw, bitmapPtr, vlw.length - bitmapPtr); // Processing font name data
+
+  byte[] data = bytes.toByteArray();
+  ByteBuffer out = ByteBuffer.wrap(data);
+  for (int g = 0; g < gCount; g++) out.putInt(24 + g * 28 + 24, format[g]);
+
+  println("Glyph bitmaps = " + bitmaps.size() + " bytes, 8-bit alpha = " + oldSize + " bytes");
+
+  return data;
+}
+
+
+// 4-bit alpha, 2 pixels per byte with the first pixel in the high nibble
+byte[] encodeAlpha4(byte[] alpha) {
+  byte[] data = new byte[(alpha.length + 1) / 2];
+  for (int i = 0; i < alpha.length; i++) {
+    int nibble = round((alpha[i] & 0xFF) / 17.0);
+    if ((i & 1) == 0) data[i / 2] = (byte)(nibble << 4);
+    else data[i / 2] |= (byte)nibble;
+  }
+  return data;
+}
+
+
+// Run length encoding, runs end at the end of each row:
+//   0x00-0x3F = n + 1 transparent pixels
+//   0x40-0x7F = (n & 0x3F) + 1 opaque pixels
+//   0x80-0xFF = (n & 0x7F) + 1 alpha bytes follow
+byte[] encodeRLE(byte[] alpha, int w, int h) {
+  ByteArrayOutputStream data = new ByteArrayOutputStream();
+  for (int y = 0; y < h; y++) {
+    int x = 0;
+    while (x < w) {
+      int a = alpha[y * w + x] & 0xFF;
+      int n = 1;
+      if (a == 0 || a == 0xFF) {
+        while (x + n < w && n < 64 && (alpha[y * w + x + n] & 0xFF) == a) n++;
+        data.write((a == 0 ? 0x00 : 0x40) | (n - 1));
+      } else {
+        while (x + n < w && n < 128) {
+          int b = alpha[y * w + x + n] & 0xFF;
+          if (b == 0 || b == 0xFF) break;
+          n++;
+        }
+        data.write(0x80 | (n - 1));
+        data.write(alpha, y * w + x, n);
+      }
+      x += n;
+    }
+  }
+  return data.toByteArray();
+}
+
+
+// Add the kerning pair and ligature tables to the end of the vlw file data and set
+// the table offset in the file header, see Smooth_font.cpp in TFT_eSPI for the format
+byte[] addExtendedTable(byte[] vlw, PFont font, char[] charset) throws IOException {
+  ArrayList<int[]> kerning = new ArrayList<int[]>();
+  ArrayList<int[]> ligature = new ArrayList<int[]>();
+
+  if (addKerning) {
+    java.awt.Font awtFont = (java.awt.Font) font.getNative();
+    if (charset.length > kerningMaxChars) {
+      println("More than " + kerningMaxChars + " characters, kerning not added");
+    } else if (awtFont == null) {
+      println("Font outline not available, kerning not added");
+    } else {
+      Map<TextAttribute, Object> attributes = new HashMap<TextAttribute, Object>();
+      attributes.put(TextAttribute.KERNING, TextAttribute.KERNING_ON);
+      java.awt.Font kernFont = awtFont.deriveFont((float)fontSize).deriveFont(attributes);
+      FontRenderContext frc = new FontRenderContext(null, true, true);
+
+      // The kerning is the difference between the pair advance and the sum of the advances
+      float[] advance = new float[charset.length];
+      for (int i = 0; i < charset.length; i++) {
+        advance[i] = new TextLayout(String.valueOf(charset[i]), kernFont, frc).getAdvance();
+      }
+      for (int i = 0; i < charset.length; i++) {
+        for (int j = 0; j < charset.length; j++) {
+          String pair = String.valueOf(charset[i]) + String.valueOf(charset[j]);
+          int kern = round(new TextLayout(pair, kernFont, frc).getAdvance() - advance[i] - advance[j]);
+          if (kern != 0) kerning.add(new int[] { charset[i], charset[j], kern });
+        }
+      }
+    }
+  }
+
+  for (int i = 0; i + 2 < ligatures.length; i += 3) {
+    boolean found = false;
+    for (int c = 0; c < charset.length; c++) if (charset[c] == ligatures[i + 2]) found = true;
+    if (found) ligature.add(new int[] { ligatures[i], ligatures[i + 1], ligatures[i + 2] });
+    else println("Ligature 0x" + hex(ligatures[i + 2], 4) + " is not in the font, not added");
+  }
+
+  println("Kerning pairs = " + kerning.size() + ", ligatures = " + ligature.size());
+
+  if (kerning.size() == 0 && ligature.size() == 0 && !addGlyphMap) return vlw;
+
+  // Tables are sorted for a binary search by the library
+  Comparator<int[]> pairOrder = new Comparator<int[]>() {
+    public int compare(int[] a, int[] b) {
+      if (a[0] != b[0]) return a[0] - b[0];
+      return a[1] - b[1];
+    }
+  };
+  Collections.sort(kerning, pairOrder);
+  Collections.sort(ligature, pairOrder);
+
+  ByteArrayOutputStream bytes = new ByteArrayOutputStream();
+  DataOutputStream table = new DataOutputStream(bytes);
+
+  table.write(vlw);
+  table.writeInt(0x54465458); // "TFTX"
+  table.writeInt(kerning.size());
+  table.writeInt(ligature.size());
+  for (int[] k : kerning) {
+    table.writeShort(k[0]);
+    table.writeShort(k[1]);
+    table.writeShort(k[2]);
+  }
+  for (int[] l : ligature) {
+    table.writeShort(l[0]);
+    table.writeShort(l[1]);
+    table.writeShort(l[2]);
+  }
+  if (addGlyphMap) writeGlyphMap(table, vlw);
+  table.flush();
+
+  // Header parameter 4 (unused by Processing) is the offset to the table
+  byte[] data = bytes.toByteArray();
+  int offset = vlw.length;
+  data[12] = (byte)(offset >> 24);
+  data[13] = (byte)(offset >> 16);
+  data[14] = (byte)(offset >> 8);
+  data[15] = (byte)offset;
+
+  return data;
+}
+
+
+// The glyph map has the bitmap offsets and the values loadMetrics() in TFT_eSPI would
+// otherwise find by reading every glyph
+void writeGlyphMap(DataOutputStream table, byte[] vlw) throws IOException {
+  ByteBuffer in = ByteBuffer.wrap(vlw);
+  int gCount = in.getInt(0);
+  int maxDescent = in.getInt(20);
+  int bitmapPtr = 24 + gCount * 28;
+  boolean sorted = true;
+  int[] offset = new int[gCount];
+
+  for (int g = 0; g < gCount; g++) {
+    int p = 24 + g * 28;
+    int code = in.getInt(p);
+    int h = in.getInt(p + 4);
+    int w = in.getInt(p + 8);
+    int dY = in.getInt(p + 16);
+    int format = in.getInt(p + 24);
+
+    if (g > 0 && code <= in.getInt(p - 28)) sorted = false;
+
+    // Same character filter as loadMetrics()
+    if (h - dY > maxDescent && ((code > 0x20 && code < 0xA0 && code != 0x7F) || code > 0xFF)) {
+      maxDescent = h - dY;
+    }
+
+    offset[g] = bitmapPtr;
+    if (format != 0) bitmapPtr += format & 0xFFFFFF;
+    else bitmapPtr += w * h;
+  }
+
+  table.writeInt(0x5446544D); // "TFTM"
+  table.writeInt(sorted ? 1 : 0);
+  table.writeInt(maxDescent);
+  for (int g = 0; g < gCount; g++) table.writeInt(offset[g]);
+}
@@ -0,0 +1,184 @@
+'''
+
+    This script converts a sequence of images (or an animated GIF) into
+    a keyframe + delta frame animation array for the TFT_eAnimation class.
+
+    The first frame is stored complete. Each following frame only stores
+    the horizontal spans of pixels that changed since the previous frame,
+    and runs of one colour are stored as a single fill value.
+
+    You'll need python 3.6 and the Pillow library (pip install pillow)
+
+    usage: python animation2array.py [-v] [-p 40] [-n name] frame*.png [-o anim.h]
+           python animation2array.py boot.gif -o boot.h
+
+    Data format (16-bit words, see Extensions/Animation.h):
+
+      Header: 0x4E41, width, height, frame count, frame period ms
+      Frame:  span count, then per span: y, x, n, pixel values
+              (if bit 15 of n is set: y, x, 0x8000 | count, fill colour)
+
+'''
+
+import sys
+import argparse
+import os
+
+try:
+    from PIL import Image, ImageSequence
+except ImportError:
+    print("The Pillow library is needed: pip install pillow")
+    sys.exit(1)
+
+ANIM_MAGIC = 0x4E41
+FILL_SPAN  = 0x8000
+MAX_SPAN   = 0x7FFF
+
+# Unchanged pixels between two changed spans are included in one span if the gap
+# is shorter than this, as each span costs 3 header words
+MERGE_GAP  = 4
+
+# Shortest run of one colour that is stored as a fill span
+MIN_FILL   = 4
+
+debug = None
+
+def debugOut(s):
+    if debug:
+        print(s)
+
+def rgb565(r, g, b):
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3)
+
+def loadFrames(files):
+    frames = []
+    period = None
+    for name in files:
+        img = Image.open(name)
+        if period is None:
+            period = img.info.get("duration")
+        for f in ImageSequence.Iterator(img):
+            rgb = f.convert("RGB")
+            w, h = rgb.size
+            px = rgb.load()
+            frames.append([[rgb565(*px[x, y]) for x in range(w)] for y in range(h)])
+    return frames, period
+
+def encodeSpan(words, y, x, line):
+    # Split the span into pixel data and single colour fills
+    start = 0
+    i = 0
+    n = len(line)
+    while i < n:
+        j = i
+        while j < n and line[j] == line[i] and j - i < MAX_SPAN:
+            j += 1
+        if j - i >= MIN_FILL:
+            if start < i:
+                words += [y, x + start, i - start] + line[start:i]
+            words += [y, x + i, FILL_SPAN | (j - i), line[i]]
+            start = j
+        i = j
+    if start < n:
+        words += [y, x + start, n - start] + line[start:n]
+
+def countSpans(words, first):
+    # Walk the encoded words to count the spans added since first
+    spans = 0
+    i = first
+    while i < len(words):
+        n = words[i + 2]
+        i += 4 if n & FILL_SPAN else 3 + n
+        spans += 1
+    return spans
+
+def encodeFrame(frame, prev):
+    words = [0]
+    for y, row in enumerate(frame):
+        if prev is None:
+            changed = [(0, len(row))]
+        else:
+            changed = []
+            x = 0
+            w = len(row)
+            while x < w:
+                if row[x] == prev[y][x]:
+                    x += 1
+                    continue
+                s = x
+                e = x + 1
+                gap = 0
+                x += 1
+                while x < w and gap < MERGE_GAP:
+                    if row[x] != prev[y][x]:
+                        e = x + 1
+                        gap = 0
+                    else:
+                        gap += 1
+                    x += 1
+                changed.append((s, e))
+        for s, e in changed:
+            # Keep pixel spans within the 15-bit count
+            while s < e:
+                c = min(e, s + MAX_SPAN)
+                encodeSpan(words, y, s, row[s:c])
+                s = c
+    words[0] = countSpans(words, 1)
+    return words
+
+# look at arguments
+parser = argparse.ArgumentParser(description="Convert images to a TFT_eAnimation C array")
+parser.add_argument("-v", "--verbose", help="debug output", action="store_true")
+parser.add_argument("input", nargs="+", help="input image files in frame order, or an animated GIF")
+parser.add_argument("-o", "--output", help="output file name")
+parser.add_argument("-n", "--name", help="array name")
+parser.add_argument("-p", "--period", type=int, help="frame period in milliseconds")
+args = parser.parse_args()
+
+debug = args.verbose
+
+for name in args.input:
+    if not os.path.exists(name):
+        parser.print_help()
+        print("The input file {} does not exist".format(name))
+        sys.exit(1)
+
+frames, period = loadFrames(args.input)
+
+if args.period is not None:
+    period = args.period
+if period is None:
+    period = 40
+
+height = len(frames[0])
+width = len(frames[0][0])
+
+for i, f in enumerate(frames):
+    if len(f) != height or len(f[0]) != width:
+        print("Frame {} is not {} x {} pixels".format(i, width, height))
+        sys.exit(1)
+
+data = [ANIM_MAGIC, width, height, len(frames), period]
+prev = None
+for i, f in enumerate(frames):
+    words = encodeFrame(f, prev)
+    debugOut("Frame {}: {} spans, {} words".format(i, words[0], len(words)))
+    data += words
+    prev = f
+
+if args.output is None:
+    output = os.path.splitext(os.path.basename(args.input[0]))[0] + ".h"
+else:
+    output = args.output
+
+arrayName = args.name if args.name else os.path.splitext(os.path.basename(output))[0]
+
+with open(output, "w") as out:
+    out.write("// Animation {} x {} pixels, {} frames, {} ms per frame\n".format(width, height, len(frames), period))
+    out.write("// {} bytes, uncompressed {} bytes\n\n".format(len(data) * 2, width * height * len(frames) * 2))
+    out.write("const uint16_t {}[] PROGMEM = {{\n".format(arrayName))
+    for i in range(0, len(data), 16):
+        out.write("  " + ", ".join("0x{:04X}".format(v) for v in data[i:i + 16]) + ",\n")
+    out.write("};\n")
+
+print("Written {} ({} bytes for {} frames)".format(output, len(data) * 2, len(frames)))
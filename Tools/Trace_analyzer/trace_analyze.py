@@ -0,0 +1,300 @@
+'''
+
+    This script analyses a bus trace recorded by the TFT_eTrace class
+    (TFT_TRACE must be defined in the TFT_eSPI setup file).
+
+    The trace is replayed into a virtual panel to find:
+      - bytes sent per frame and the frame time implied by the SPI clock
+      - address windows that were set but not used
+      - column and row commands that repeat the last address sent
+      - pixels written more than once in a frame (overdraw)
+      - pixels filled with the colour they already had (redundant)
+
+    Pixel data sent with pushPixels() or DMA is not in the trace, so
+    those pixels are treated as unknown colours.
+
+    You'll need python 3.6
+
+    usage: python trace_analyze.py capture.trc
+           python trace_analyze.py -c 40 -f capture.trc
+           python trace_analyze.py -p panel.ppm capture.trc
+
+'''
+
+import sys
+import argparse
+import struct
+from array import array
+
+TRACE_VERSION = 1
+
+TRACE_COMMAND = 1
+TRACE_DATA    = 2
+TRACE_WINDOW  = 3
+TRACE_PIXEL   = 4
+TRACE_BLOCK   = 5
+TRACE_PIXELS  = 6
+TRACE_DMA     = 7
+TRACE_READ    = 8
+TRACE_FRAME   = 9
+
+UNKNOWN = -1 # Panel pixel colour is not known
+
+# Bus bytes for each operation, for a display with 8-bit commands
+CASET_BYTES = 5 # Command and 4 address bytes
+PASET_BYTES = 5
+RAMWR_BYTES = 1
+
+class Reader:
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def more(self):
+        return self.pos < len(self.data)
+
+    def u8(self):
+        if self.pos >= len(self.data):
+            raise EOFError
+        v = self.data[self.pos]
+        self.pos += 1
+        return v
+
+    def u16(self):
+        return self.u8() | (self.u8() << 8)
+
+    def var(self):
+        v = 0
+        shift = 0
+        while True:
+            b = self.u8()
+            v |= (b & 0x7F) << shift
+            shift += 7
+            if b < 0x80:
+                return v
+
+class Frame:
+    def __init__(self, number):
+        self.number = number
+        self.bytes = 0          # Bytes sent on the bus
+        self.time = 0           # Recorded time in microseconds
+        self.commands = 0       # Commands sent with writecommand()
+        self.windows = 0        # Address windows set
+        self.wasted = 0         # Windows set but not used
+        self.repeated = 0       # Column/row commands repeating the last address
+        self.pixels = 0         # Pixels written
+        self.overdraw = 0       # Pixels written more than once in the frame
+        self.redundant = 0      # Pixels filled with the colour they already had
+        self.unknown = 0        # Pixels with colours not in the trace
+        self.read = 0           # Pixels read
+
+class Panel:
+    def __init__(self, width, height):
+        self.width = width
+        self.height = height
+        self.color = array('i', [UNKNOWN]) * (width * height)
+        self.stamp = array('i', [0]) * (width * height) # Frame number of the last write
+        self.setWindow(0, 0, width - 1, height - 1)
+
+    def setWindow(self, x0, y0, x1, y1):
+        self.x0, self.y0, self.x1, self.y1 = x0, y0, x1, y1
+        self.cx, self.cy = x0, y0
+
+    def write(self, count, color, frame):
+        # Write count pixels at the cursor, the cursor wraps like the panel RAM pointer
+        if self.x1 < self.x0 or self.y1 < self.y0:
+            return
+        stampValue = frame.number + 1
+        while count > 0:
+            run = min(count, self.x1 - self.cx + 1)
+            # Clip the run to the panel
+            xs = max(self.cx, 0)
+            xe = min(self.cx + run, self.width)
+            if xs < xe and 0 <= self.cy < self.height:
+                a = self.cy * self.width + xs
+                b = self.cy * self.width + xe
+                frame.overdraw += self.stamp[a:b].count(stampValue)
+                self.stamp[a:b] = array('i', [stampValue]) * (b - a)
+                if color == UNKNOWN:
+                    frame.unknown += b - a
+                else:
+                    frame.redundant += self.color[a:b].count(color)
+                self.color[a:b] = array('i', [color]) * (b - a)
+            count -= run
+            self.cx += run
+            if self.cx > self.x1:
+                self.cx = self.x0
+                self.cy += 1
+                if self.cy > self.y1:
+                    self.cy = self.y0
+
+    def savePPM(self, name):
+        with open(name, 'wb') as f:
+            f.write(b'P6 %d %d 255\n' % (self.width, self.height))
+            out = bytearray()
+            for c in self.color:
+                if c == UNKNOWN:
+                    out += b'\xff\x00\xff' # Magenta
+                else:
+                    out += bytes(((c >> 8) & 0xF8, (c >> 3) & 0xFC, (c << 3) & 0xF8))
+            f.write(out)
+
+def analyse(data):
+    r = Reader(data)
+
+    if data[:4] != b'TFTT':
+        raise ValueError("Not a TFT_eSPI trace file")
+    r.pos = 4
+    version = r.u8()
+    if version != TRACE_VERSION:
+        raise ValueError("Trace version %d is not supported" % version)
+    rotation = r.u8()
+    width = r.u16()
+    height = r.u16()
+    clock = r.u16() | (r.u16() << 16)
+
+    panel = Panel(width, height)
+    frames = []
+    frame = Frame(0)
+    lastCol = None
+    lastRow = None
+    windowOpen = False # Window set and not yet used
+
+    def closeWindow():
+        nonlocal windowOpen
+        if windowOpen:
+            frame.wasted += 1
+        windowOpen = False
+
+    def setAddress(flags, x0, y0, x1, y1):
+        nonlocal lastCol, lastRow
+        frame.windows += 1
+        if flags & 1:
+            frame.bytes += CASET_BYTES
+            if lastCol == (x0, x1):
+                frame.repeated += 1
+            lastCol = (x0, x1)
+        if flags & 2:
+            frame.bytes += PASET_BYTES
+            if lastRow == (y0, y1):
+                frame.repeated += 1
+            lastRow = (y0, y1)
+        frame.bytes += RAMWR_BYTES
+        panel.setWindow(x0, y0, x1, y1)
+
+    try:
+        while r.more():
+            kind = r.u8()
+            frame.time += r.var()
+
+            if kind == TRACE_COMMAND:
+                c = r.var()
+                frame.commands += 1
+                frame.bytes += 2 if c > 0xFF else 1
+                # Commands sent directly may move the address
+                lastCol = lastRow = None
+            elif kind == TRACE_DATA:
+                r.u8()
+                frame.bytes += 1
+            elif kind == TRACE_WINDOW:
+                flags = r.u8()
+                x0, y0, x1, y1 = r.var(), r.var(), r.var(), r.var()
+                closeWindow()
+                setAddress(flags, x0, y0, x1, y1)
+                windowOpen = True
+            elif kind == TRACE_PIXEL:
+                flags = r.u8()
+                x, y = r.var(), r.var()
+                color = r.u16()
+                closeWindow()
+                setAddress(flags, x, y, x, y)
+                panel.write(1, color, frame)
+                frame.pixels += 1
+                frame.bytes += 2
+            elif kind == TRACE_BLOCK or kind == TRACE_PIXELS or kind == TRACE_DMA:
+                color = r.u16() if kind == TRACE_BLOCK else UNKNOWN
+                count = r.var()
+                windowOpen = False
+                panel.write(count, color, frame)
+                frame.pixels += count
+                frame.bytes += 2 * count
+            elif kind == TRACE_READ:
+                count = r.var()
+                windowOpen = False
+                frame.read += count
+                frame.bytes += 1 + 3 * count # Dummy byte then 3 bytes per pixel
+            elif kind == TRACE_FRAME:
+                closeWindow()
+                frames.append(frame)
+                frame = Frame(frame.number + 1)
+            else:
+                raise ValueError("Unknown record type %d at offset %d" % (kind, r.pos - 1))
+    except EOFError:
+        print("Warning: trace ends part way through a record")
+
+    closeWindow()
+    if frame.bytes or frame.time:
+        frames.append(frame)
+
+    return (width, height, rotation, clock), frames, panel
+
+def main():
+    parser = argparse.ArgumentParser(description="Analyse a TFT_eSPI bus trace")
+    parser.add_argument("trace", help="trace file recorded by TFT_eTrace")
+    parser.add_argument("-c", "--clock", type=float, help="SPI clock in MHz (default is the clock in the trace)")
+    parser.add_argument("-f", "--frames", action="store_true", help="print the statistics of each frame")
+    parser.add_argument("-p", "--ppm", help="save the final virtual panel as a PPM image (unknown pixels are magenta)")
+    args = parser.parse_args()
+
+    with open(args.trace, 'rb') as f:
+        data = f.read()
+
+    try:
+        (width, height, rotation, clock), frames, panel = analyse(data)
+    except ValueError as e:
+        sys.exit(str(e))
+
+    if args.clock:
+        clock = int(args.clock * 1000000)
+
+    print("Panel %d x %d, rotation %d, SPI clock %.1f MHz" % (width, height, rotation, clock / 1000000))
+    print("%d frames" % len(frames))
+
+    def busTime(nbytes):
+        return nbytes * 8 * 1000 / clock # ms
+
+    if args.frames:
+        print()
+        print("Frame     Bytes  Bus ms  Rec ms  Windows  Wasted  Repeat   Pixels  Overdraw  Redundant  Unknown")
+        for f in frames:
+            print("%5d %9d %7.2f %7.2f %8d %7d %7d %8d %9d %10d %8d" % (f.number, f.bytes, busTime(f.bytes),
+                  f.time / 1000, f.windows, f.wasted, f.repeated, f.pixels, f.overdraw, f.redundant, f.unknown))
+
+    if frames:
+        total = Frame(0)
+        for f in frames:
+            for k in vars(total):
+                if k != 'number':
+                    setattr(total, k, getattr(total, k) + getattr(f, k))
+        n = len(frames)
+        window = total.windows * (CASET_BYTES + PASET_BYTES + RAMWR_BYTES)
+        print()
+        print("Per frame average:")
+        print("  Bytes sent         %10.0f" % (total.bytes / n))
+        print("  Bus time           %10.2f ms at %.1f MHz" % (busTime(total.bytes / n), clock / 1000000))
+        print("  Recorded time      %10.2f ms" % (total.time / n / 1000))
+        print("  Windows            %10.1f (up to %.0f command bytes)" % (total.windows / n, window / n))
+        print("  Unused windows     %10.1f" % (total.wasted / n))
+        print("  Repeated addresses %10.1f" % (total.repeated / n))
+        print("  Pixels written     %10.0f" % (total.pixels / n))
+        print("  Overdraw pixels    %10.0f (%.1f%%)" % (total.overdraw / n, 100 * total.overdraw / max(total.pixels, 1)))
+        print("  Redundant pixels   %10.0f (%.1f%%)" % (total.redundant / n, 100 * total.redundant / max(total.pixels, 1)))
+        print("  Unknown colours    %10.0f" % (total.unknown / n))
+        if total.read:
+            print("  Pixels read        %10.0f" % (total.read / n))
+
+    if args.ppm:
+        panel.savePPM(args.ppm)
+
+if __name__ == "__main__":
+    main()
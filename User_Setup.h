@@ -387,3 +387,9 @@
 // so changing it here has no effect
 
 // #define SUPPORT_TRANSACTIONS
+
+// Uncomment the following #define to compile the trace points that allow the commands
+// and pixel data sent to the TFT to be recorded by the TFT_eTrace class, for offline
+// analysis with the Tools/Trace_analyzer script. Leave it commented out for normal use.
+
+// #define TFT_TRACE
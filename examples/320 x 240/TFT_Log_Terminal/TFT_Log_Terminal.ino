@@ -0,0 +1,55 @@
+/*
+  Sketch to show the TFT_eTerminal class used as a log console.
+
+  Example for library:
+  https://github.com/Bodmer/TFT_eSPI
+
+  Messages received on the Serial port, plus a count every second,
+  are printed in a scrolling terminal below a fixed title bar.
+
+  With ILI9341, ST7789 and ST7796 displays in rotation 0 the
+  display hardware scrolling is used, so scrolling one line only
+  needs the old top line to be cleared. With other displays the
+  text is scrolled in a Sprite and the Sprite is pushed to the
+  screen.
+*/
+
+#include <TFT_eSPI.h>
+
+TFT_eSPI      tft = TFT_eSPI();
+TFT_eTerminal term(&tft);
+
+#define TITLE_HEIGHT 16
+
+void setup() {
+  Serial.begin(115200);
+
+  tft.init();
+  tft.setRotation(0); // Hardware scrolling needs rotation 0
+  tft.fillScreen(TFT_BLACK);
+
+  tft.fillRect(0, 0, tft.width(), TITLE_HEIGHT, TFT_BLUE);
+  tft.setTextColor(TFT_WHITE, TFT_BLUE);
+  tft.drawCentreString("Log terminal", tft.width() / 2, 0, 2);
+
+  // Terminal below the title, using font 2 and an 8 bit Sprite if needed
+  term.setTextColor(TFT_GREEN, TFT_BLACK);
+  if (!term.begin(TITLE_HEIGHT, 0, 2, 8)) Serial.println("Terminal not started");
+
+  term.print("Hardware scrolling: ");
+  term.println(term.hardwareScroll() ? "yes" : "no");
+}
+
+void loop() {
+  static uint32_t count = 0;
+  static uint32_t lastTime = 0;
+
+  while (Serial.available()) term.write(Serial.read());
+
+  if (millis() - lastTime >= 1000) {
+    lastTime = millis();
+    term.print("Uptime ");
+    term.print(count++);
+    term.println(" s");
+  }
+}
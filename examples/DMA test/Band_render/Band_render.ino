@@ -0,0 +1,91 @@
+/*
+
+  Sketch to show how the two cores of an ESP32 or RP2040 can share
+  the work of drawing an animated full screen display.
+
+  Example for library:
+  https://github.com/Bodmer/TFT_eSPI
+
+  The screen is rendered as a series of horizontal bands. Each band
+  is drawn in a Sprite by the sketch loop, then queued. The other
+  core sends the band to the TFT (with DMA) while the next band is
+  being drawn, so rendering and transfer run at the same time.
+
+  On the ESP32 the bands are sent by a task created on the other
+  core. On the RP2040 the bands are sent by loop1() on core 1.
+
+  The bands need 2 * SCREEN_WIDTH * BAND_HEIGHT * 2 bytes of RAM.
+
+*/
+
+#include <TFT_eSPI.h>
+
+TFT_eSPI        tft = TFT_eSPI();
+TFT_eBandRender bands(&tft);
+
+#define BAND_HEIGHT 40 // Band height in pixels
+
+// Used for fps measuring
+uint32_t frames = 0;
+uint32_t startMillis = 0;
+
+void setup()
+{
+  Serial.begin(115200);
+
+  tft.init();
+  tft.setRotation(0);
+  tft.fillScreen(TFT_BLACK);
+  tft.initDMA();
+
+  if (!bands.begin(tft.width(), BAND_HEIGHT)) {
+    Serial.println("Band Sprites could not be created");
+    while(1) yield();
+  }
+
+  if (!bands.worker()) Serial.println("Bands are sent by the rendering core");
+
+  startMillis = millis();
+}
+
+void loop()
+{
+  static uint16_t phase = 0;
+
+  for (int32_t y = 0; y < tft.height(); y += BAND_HEIGHT) {
+
+    // Waits if the band is still being sent
+    TFT_eSprite *band = bands.getBand(0, y);
+
+    // Draw in the band, coordinates are relative to the band
+    for (int32_t by = 0; by < BAND_HEIGHT; by++) {
+      uint8_t  c = (y + by + phase) & 0xFF;
+      band->drawFastHLine(0, by, tft.width(), tft.color565(c, 255 - c, (c * 2) & 0xFF));
+    }
+
+    int32_t cx = tft.width() / 2 + (tft.width() / 3) * sin(phase * 0.05);
+    int32_t cy = tft.height() / 2 - y;
+    band->fillSmoothCircle(cx, cy, 50, TFT_WHITE);
+
+    bands.pushBand();
+  }
+
+  phase++;
+
+  // Print the frame rate every 100 frames
+  if (++frames == 100) {
+    bands.flush(); // The TFT bus must be released before the sketch uses the TFT
+    Serial.print((frames * 1000.0) / (millis() - startMillis));
+    Serial.println(" fps");
+    frames = 0;
+    startMillis = millis();
+  }
+}
+
+#if defined (ARDUINO_ARCH_RP2040)
+// Core 1 sends the bands to the TFT
+void loop1()
+{
+  bands.service();
+}
+#endif
@@ -0,0 +1,60 @@
+/*
+
+  Sketch to show how an animation stored as a keyframe followed
+  by delta frames is played on the TFT and in a Sprite.
+
+  Example for library:
+  https://github.com/Bodmer/TFT_eSPI
+
+  Only the pixels that change between frames are stored, so the
+  animation needs much less FLASH than a full image per frame and
+  less data is sent to the display for each frame.
+
+  The orbit.h animation array was created from a sequence of images
+  with the Tools/Create_animation/animation2array.py script.
+
+*/
+
+#include <TFT_eSPI.h>                 // Include the graphics library
+
+#include "orbit.h"                    // Animation array
+
+TFT_eSPI       tft = TFT_eSPI();      // Declare object "tft"
+
+TFT_eSprite    spr = TFT_eSprite(&tft);
+
+TFT_eAnimation anim1(&tft);           // Drawn directly to the TFT
+TFT_eAnimation anim2(&tft);           // Drawn into a Sprite
+
+void setup()
+{
+  Serial.begin(115200);
+
+  tft.init();
+  tft.fillScreen(TFT_BLACK);
+
+  if (!anim1.setAnimation(orbit)) Serial.println("Animation data not valid");
+  anim1.setPosition(10, 10);
+  anim1.start();
+
+  // The second copy runs at half speed in a Sprite with a label
+  anim2.setAnimation(orbit);
+  spr.createSprite(anim2.width(), anim2.height() + 20);
+  spr.fillSprite(TFT_BLACK);
+  spr.setTextColor(TFT_WHITE, TFT_BLACK);
+  anim2.setTarget(&spr);
+  anim2.setPosition(0, 20);
+  anim2.setFramePeriod(100);
+  anim2.start();
+}
+
+void loop(void)
+{
+  anim1.update();
+
+  if (anim2.update())
+  {
+    spr.drawNumber(anim2.frame(), 0, 0, 2);
+    spr.pushSprite(80, 10);
+  }
+}
@@ -0,0 +1,97 @@
+// Animation 48 x 48 pixels, 12 frames, 50 ms per frame
+// 2922 bytes, uncompressed 55296 bytes
+
+const uint16_t orbit[] PROGMEM = {
+  0x4E41, 0x0030, 0x0030, 0x000C, 0x0032, 0x005C, 0x0000, 0x0000, 0x8030, 0x0000, 0x0001, 0x0000, 0x8030, 0x0000, 0x0002, 0x0000,
+  0x8030, 0x0000, 0x0003, 0x0000, 0x8030, 0x0000, 0x0004, 0x0000, 0x8030, 0x0000, 0x0005, 0x0000, 0x8030, 0x0000, 0x0006, 0x0000,
+  0x8030, 0x0000, 0x0007, 0x0000, 0x8030, 0x0000, 0x0008, 0x0000, 0x8030, 0x0000, 0x0009, 0x0000, 0x8030, 0x0000, 0x000A, 0x0000,
+  0x8030, 0x0000, 0x000B, 0x0000, 0x8030, 0x0000, 0x000C, 0x0000, 0x8030, 0x0000, 0x000D, 0x0000, 0x8030, 0x0000, 0x000E, 0x0000,
+  0x8030, 0x0000, 0x000F, 0x0000, 0x8030, 0x0000, 0x0010, 0x0000, 0x8030, 0x0000, 0x0011, 0x0000, 0x8030, 0x0000, 0x0012, 0x0000,
+  0x8026, 0x0000, 0x0012, 0x0026, 0x0001, 0xFE40, 0x0012, 0x0027, 0x8009, 0x0000, 0x0013, 0x0000, 0x8023, 0x0000, 0x0013, 0x0023,
+  0x8007, 0xFE40, 0x0013, 0x002A, 0x8006, 0x0000, 0x0014, 0x0000, 0x8018, 0x0000, 0x0014, 0x0018, 0x0001, 0x03DF, 0x0014, 0x0019,
+  0x8009, 0x0000, 0x0014, 0x0022, 0x8009, 0xFE40, 0x0014, 0x002B, 0x8005, 0x0000, 0x0015, 0x0000, 0x8016, 0x0000, 0x0015, 0x0016,
+  0x8005, 0x03DF, 0x0015, 0x001B, 0x8006, 0x0000, 0x0015, 0x0021, 0x800B, 0xFE40, 0x0015, 0x002C, 0x8004, 0x0000, 0x0016, 0x0000,
+  0x8015, 0x0000, 0x0016, 0x0015, 0x8007, 0x03DF, 0x0016, 0x001C, 0x8005, 0x0000, 0x0016, 0x0021, 0x800B, 0xFE40, 0x0016, 0x002C,
+  0x8004, 0x0000, 0x0017, 0x0000, 0x8015, 0x0000, 0x0017, 0x0015, 0x8007, 0x03DF, 0x0017, 0x001C, 0x8005, 0x0000, 0x0017, 0x0021,
+  0x800B, 0xFE40, 0x0017, 0x002C, 0x8004, 0x0000, 0x0018, 0x0000, 0x8014, 0x0000, 0x0018, 0x0014, 0x8009, 0x03DF, 0x0018, 0x001D,
+  0x0003, 0x0000, 0x0000, 0x0000, 0x0018, 0x0020, 0x800D, 0xFE40, 0x0018, 0x002D, 0x0003, 0x0000, 0x0000, 0x0000, 0x0019, 0x0000,
+  0x8015, 0x0000, 0x0019, 0x0015, 0x8007, 0x03DF, 0x0019, 0x001C, 0x8005, 0x0000, 0x0019, 0x0021, 0x800B, 0xFE40, 0x0019, 0x002C,
+  0x8004, 0x0000, 0x001A, 0x0000, 0x8015, 0x0000, 0x001A, 0x0015, 0x8007, 0x03DF, 0x001A, 0x001C, 0x8005, 0x0000, 0x001A, 0x0021,
+  0x800B, 0xFE40, 0x001A, 0x002C, 0x8004, 0x0000, 0x001B, 0x0000, 0x8016, 0x0000, 0x001B, 0x0016, 0x8005, 0x03DF, 0x001B, 0x001B,
+  0x8006, 0x0000, 0x001B, 0x0021, 0x800B, 0xFE40, 0x001B, 0x002C, 0x8004, 0x0000, 0x001C, 0x0000, 0x8018, 0x0000, 0x001C, 0x0018,
+  0x0001, 0x03DF, 0x001C, 0x0019, 0x8009, 0x0000, 0x001C, 0x0022, 0x8009, 0xFE40, 0x001C, 0x002B, 0x8005, 0x0000, 0x001D, 0x0000,
+  0x8023, 0x0000, 0x001D, 0x0023, 0x8007, 0xFE40, 0x001D, 0x002A, 0x8006, 0x0000, 0x001E, 0x0000, 0x8026, 0x0000, 0x001E, 0x0026,
+  0x0001, 0xFE40, 0x001E, 0x0027, 0x8009, 0x0000, 0x001F, 0x0000, 0x8030, 0x0000, 0x0020, 0x0000, 0x8030, 0x0000, 0x0021, 0x0000,
+  0x8030, 0x0000, 0x0022, 0x0000, 0x8030, 0x0000, 0x0023, 0x0000, 0x8030, 0x0000, 0x0024, 0x0000, 0x8030, 0x0000, 0x0025, 0x0000,
+  0x8030, 0x0000, 0x0026, 0x0000, 0x8030, 0x0000, 0x0027, 0x0000, 0x8030, 0x0000, 0x0028, 0x0000, 0x8030, 0x0000, 0x0029, 0x0000,
+  0x8030, 0x0000, 0x002A, 0x0000, 0x8030, 0x0000, 0x002B, 0x0000, 0x8030, 0x0000, 0x002C, 0x0000, 0x8030, 0x0000, 0x002D, 0x0000,
+  0x8030, 0x0000, 0x002E, 0x0000, 0x8030, 0x0000, 0x002F, 0x0000, 0x8030, 0x0000, 0x0015, 0x0012, 0x0026, 0x0001, 0x0000, 0x0013,
+  0x0023, 0x8007, 0x0000, 0x0014, 0x0022, 0x8009, 0x0000, 0x0015, 0x0021, 0x800B, 0x0000, 0x0016, 0x0021, 0x800B, 0x0000, 0x0017,
+  0x0021, 0x800B, 0x0000, 0x0018, 0x0020, 0x800D, 0x0000, 0x0019, 0x0021, 0x800B, 0x0000, 0x001A, 0x0028, 0x8004, 0x0000, 0x001B,
+  0x0020, 0x0001, 0xFE40, 0x001B, 0x0029, 0x0003, 0x0000, 0x0000, 0x0000, 0x001C, 0x001F, 0x0003, 0xFE40, 0xFE40, 0xFE40, 0x001C,
+  0x002A, 0x0001, 0x0000, 0x001D, 0x001F, 0x8004, 0xFE40, 0x001E, 0x001F, 0x800C, 0xFE40, 0x001F, 0x001F, 0x800C, 0xFE40, 0x0020,
+  0x001F, 0x800C, 0xFE40, 0x0021, 0x001F, 0x800B, 0xFE40, 0x0022, 0x001F, 0x800B, 0xFE40, 0x0023, 0x0020, 0x8009, 0xFE40, 0x0024,
+  0x0021, 0x8007, 0xFE40, 0x0017, 0x001A, 0x0021, 0x8007, 0x0000, 0x001B, 0x0020, 0x8009, 0x0000, 0x001C, 0x001F, 0x800B, 0x0000,
+  0x001D, 0x001F, 0x800B, 0x0000, 0x001E, 0x001F, 0x800C, 0x0000, 0x001F, 0x001C, 0x0003, 0xFE40, 0xFE40, 0xFE40, 0x001F, 0x0023,
+  0x8008, 0x0000, 0x0020, 0x001B, 0x8004, 0xFE40, 0x0020, 0x0024, 0x8007, 0x0000, 0x0021, 0x001A, 0x8005, 0xFE40, 0x0021, 0x0025,
+  0x8005, 0x0000, 0x0022, 0x001A, 0x8005, 0xFE40, 0x0022, 0x0025, 0x8005, 0x0000, 0x0023, 0x001A, 0x8006, 0xFE40, 0x0023, 0x0025,
+  0x8004, 0x0000, 0x0024, 0x001A, 0x8007, 0xFE40, 0x0024, 0x0025, 0x0003, 0x0000, 0x0000, 0x0000, 0x0025, 0x001A, 0x800B, 0xFE40,
+  0x0026, 0x001A, 0x800B, 0xFE40, 0x0027, 0x001A, 0x800B, 0xFE40, 0x0028, 0x001B, 0x8009, 0xFE40, 0x0029, 0x001C, 0x8007, 0xFE40,
+  0x002A, 0x001E, 0x0003, 0xFE40, 0xFE40, 0xFE40, 0x0019, 0x001F, 0x001C, 0x8007, 0x0000, 0x0020, 0x0018, 0x0001, 0xFE40, 0x0020,
+  0x0019, 0x800B, 0x0000, 0x0021, 0x0015, 0x8007, 0xFE40, 0x0021, 0x001C, 0x8009, 0x0000, 0x0022, 0x0014, 0x8009, 0xFE40, 0x0022,
+  0x001D, 0x8008, 0x0000, 0x0023, 0x0013, 0x8007, 0xFE40, 0x0023, 0x001E, 0x8007, 0x0000, 0x0024, 0x0013, 0x8007, 0xFE40, 0x0024,
+  0x001E, 0x8007, 0x0000, 0x0025, 0x0013, 0x8007, 0xFE40, 0x0025, 0x001E, 0x8007, 0x0000, 0x0026, 0x0012, 0x8008, 0xFE40, 0x0026,
+  0x001F, 0x8006, 0x0000, 0x0027, 0x0013, 0x8007, 0xFE40, 0x0027, 0x001E, 0x8007, 0x0000, 0x0028, 0x0013, 0x800B, 0xFE40, 0x0028,
+  0x001E, 0x8006, 0x0000, 0x0029, 0x0013, 0x800B, 0xFE40, 0x0029, 0x001E, 0x8005, 0x0000, 0x002A, 0x0014, 0x8009, 0xFE40, 0x002A,
+  0x001D, 0x8004, 0x0000, 0x002B, 0x0015, 0x8007, 0xFE40, 0x002C, 0x0018, 0x0001, 0xFE40, 0x0019, 0x001F, 0x000E, 0x8007, 0xFE40,
+  0x0020, 0x000D, 0x8009, 0xFE40, 0x0020, 0x0016, 0x0003, 0x0000, 0x0000, 0x0000, 0x0021, 0x000C, 0x800B, 0xFE40, 0x0021, 0x0017,
+  0x8005, 0x0000, 0x0022, 0x000C, 0x800B, 0xFE40, 0x0022, 0x0017, 0x8006, 0x0000, 0x0023, 0x000C, 0x8007, 0xFE40, 0x0023, 0x0017,
+  0x8007, 0x0000, 0x0024, 0x000C, 0x8007, 0xFE40, 0x0024, 0x0017, 0x8007, 0x0000, 0x0025, 0x000C, 0x8007, 0xFE40, 0x0025, 0x0017,
+  0x8007, 0x0000, 0x0026, 0x000C, 0x8006, 0xFE40, 0x0026, 0x0017, 0x8008, 0x0000, 0x0027, 0x000C, 0x8007, 0xFE40, 0x0027, 0x0017,
+  0x8007, 0x0000, 0x0028, 0x000D, 0x8009, 0xFE40, 0x0028, 0x0016, 0x8008, 0x0000, 0x0029, 0x000E, 0x8007, 0xFE40, 0x0029, 0x0015,
+  0x8009, 0x0000, 0x002A, 0x0010, 0x0003, 0xFE40, 0xFE40, 0xFE40, 0x002A, 0x0013, 0x800A, 0x0000, 0x002B, 0x0015, 0x8007, 0x0000,
+  0x002C, 0x0018, 0x0001, 0x0000, 0x0017, 0x001A, 0x0009, 0x8007, 0xFE40, 0x001B, 0x0008, 0x8009, 0xFE40, 0x001C, 0x0007, 0x800B,
+  0xFE40, 0x001D, 0x0007, 0x800B, 0xFE40, 0x001E, 0x0006, 0x800C, 0xFE40, 0x001F, 0x0006, 0x8008, 0xFE40, 0x001F, 0x0012, 0x0003,
+  0x0000, 0x0000, 0x0000, 0x0020, 0x0006, 0x8007, 0xFE40, 0x0020, 0x0012, 0x8004, 0x0000, 0x0021, 0x0007, 0x8005, 0xFE40, 0x0021,
+  0x0012, 0x8005, 0x0000, 0x0022, 0x0007, 0x8005, 0xFE40, 0x0022, 0x0012, 0x8005, 0x0000, 0x0023, 0x0008, 0x8004, 0xFE40, 0x0023,
+  0x0011, 0x8006, 0x0000, 0x0024, 0x0009, 0x0003, 0xFE40, 0xFE40, 0xFE40, 0x0024, 0x0010, 0x8007, 0x0000, 0x0025, 0x000C, 0x800B,
+  0x0000, 0x0026, 0x000C, 0x800B, 0x0000, 0x0027, 0x000C, 0x800B, 0x0000, 0x0028, 0x000D, 0x8009, 0x0000, 0x0029, 0x000E, 0x8007,
+  0x0000, 0x002A, 0x0010, 0x0003, 0x0000, 0x0000, 0x0000, 0x0017, 0x0012, 0x000A, 0x0001, 0xFE40, 0x0013, 0x0007, 0x8007, 0xFE40,
+  0x0014, 0x0006, 0x8009, 0xFE40, 0x0015, 0x0005, 0x800B, 0xFE40, 0x0016, 0x0005, 0x800B, 0xFE40, 0x0017, 0x0005, 0x800B, 0xFE40,
+  0x0018, 0x0004, 0x800D, 0xFE40, 0x0019, 0x0005, 0x800B, 0xFE40, 0x001A, 0x0005, 0x8004, 0xFE40, 0x001B, 0x0005, 0x0003, 0xFE40,
+  0xFE40, 0xFE40, 0x001B, 0x0010, 0x0001, 0x0000, 0x001C, 0x0006, 0x0001, 0xFE40, 0x001C, 0x000F, 0x0003, 0x0000, 0x0000, 0x0000,
+  0x001D, 0x000E, 0x8004, 0x0000, 0x001E, 0x0006, 0x8004, 0x0000, 0x001E, 0x000A, 0x0001, 0xFE40, 0x001E, 0x000B, 0x8007, 0x0000,
+  0x001F, 0x0006, 0x800C, 0x0000, 0x0020, 0x0006, 0x800C, 0x0000, 0x0021, 0x0007, 0x800B, 0x0000, 0x0022, 0x0007, 0x800B, 0x0000,
+  0x0023, 0x0008, 0x8009, 0x0000, 0x0024, 0x0009, 0x8007, 0x0000, 0x0015, 0x000C, 0x0009, 0x8007, 0xFE40, 0x000D, 0x0008, 0x8009,
+  0xFE40, 0x000E, 0x0007, 0x800B, 0xFE40, 0x000F, 0x0007, 0x800B, 0xFE40, 0x0010, 0x0006, 0x800C, 0xFE40, 0x0011, 0x0006, 0x800C,
+  0xFE40, 0x0012, 0x0006, 0x800C, 0xFE40, 0x0013, 0x000E, 0x8004, 0xFE40, 0x0014, 0x0006, 0x0001, 0x0000, 0x0014, 0x000F, 0x0003,
+  0xFE40, 0xFE40, 0xFE40, 0x0015, 0x0005, 0x0003, 0x0000, 0x0000, 0x0000, 0x0015, 0x0010, 0x0001, 0xFE40, 0x0016, 0x0005, 0x8004,
+  0x0000, 0x0017, 0x0005, 0x800B, 0x0000, 0x0018, 0x0004, 0x800D, 0x0000, 0x0019, 0x0005, 0x800B, 0x0000, 0x001A, 0x0005, 0x800B,
+  0x0000, 0x001B, 0x0005, 0x800B, 0x0000, 0x001C, 0x0006, 0x8009, 0x0000, 0x001D, 0x0007, 0x8007, 0x0000, 0x001E, 0x000A, 0x0001,
+  0x0000, 0x0017, 0x0006, 0x0010, 0x0003, 0xFE40, 0xFE40, 0xFE40, 0x0007, 0x000E, 0x8007, 0xFE40, 0x0008, 0x000D, 0x8009, 0xFE40,
+  0x0009, 0x000C, 0x800B, 0xFE40, 0x000A, 0x000C, 0x800B, 0xFE40, 0x000B, 0x000C, 0x800B, 0xFE40, 0x000C, 0x0009, 0x0003, 0x0000,
+  0x0000, 0x0000, 0x000C, 0x0010, 0x8007, 0xFE40, 0x000D, 0x0008, 0x8004, 0x0000, 0x000D, 0x0011, 0x8006, 0xFE40, 0x000E, 0x0007,
+  0x8005, 0x0000, 0x000E, 0x0012, 0x8005, 0xFE40, 0x000F, 0x0007, 0x8005, 0x0000, 0x000F, 0x0012, 0x8005, 0xFE40, 0x0010, 0x0006,
+  0x8007, 0x0000, 0x0010, 0x0012, 0x8004, 0xFE40, 0x0011, 0x0006, 0x8008, 0x0000, 0x0011, 0x0012, 0x0003, 0xFE40, 0xFE40, 0xFE40,
+  0x0012, 0x0006, 0x800C, 0x0000, 0x0013, 0x0007, 0x800B, 0x0000, 0x0014, 0x0007, 0x800B, 0x0000, 0x0015, 0x0008, 0x8009, 0x0000,
+  0x0016, 0x0009, 0x8007, 0x0000, 0x0019, 0x0004, 0x0018, 0x0001, 0xFE40, 0x0005, 0x0015, 0x8007, 0xFE40, 0x0006, 0x0010, 0x8004,
+  0x0000, 0x0006, 0x0014, 0x8009, 0xFE40, 0x0007, 0x000E, 0x8005, 0x0000, 0x0007, 0x0013, 0x800B, 0xFE40, 0x0008, 0x000D, 0x8006,
+  0x0000, 0x0008, 0x0013, 0x800B, 0xFE40, 0x0009, 0x000C, 0x8007, 0x0000, 0x0009, 0x0017, 0x8007, 0xFE40, 0x000A, 0x000C, 0x8006,
+  0x0000, 0x000A, 0x0017, 0x8007, 0xFE40, 0x000B, 0x000C, 0x8007, 0x0000, 0x000B, 0x0017, 0x8007, 0xFE40, 0x000C, 0x000C, 0x8007,
+  0x0000, 0x000C, 0x0017, 0x8007, 0xFE40, 0x000D, 0x000C, 0x8007, 0x0000, 0x000D, 0x0017, 0x8007, 0xFE40, 0x000E, 0x000C, 0x8008,
+  0x0000, 0x000E, 0x0014, 0x8009, 0xFE40, 0x000F, 0x000C, 0x8009, 0x0000, 0x000F, 0x0015, 0x8007, 0xFE40, 0x0010, 0x000D, 0x800B,
+  0x0000, 0x0010, 0x0018, 0x0001, 0xFE40, 0x0011, 0x000E, 0x8007, 0x0000, 0x0019, 0x0004, 0x0018, 0x0001, 0x0000, 0x0005, 0x0015,
+  0x8007, 0x0000, 0x0006, 0x0014, 0x800A, 0x0000, 0x0006, 0x001E, 0x0003, 0xFE40, 0xFE40, 0xFE40, 0x0007, 0x0013, 0x8009, 0x0000,
+  0x0007, 0x001C, 0x8007, 0xFE40, 0x0008, 0x0013, 0x8008, 0x0000, 0x0008, 0x001B, 0x8009, 0xFE40, 0x0009, 0x0013, 0x8007, 0x0000,
+  0x0009, 0x001E, 0x8007, 0xFE40, 0x000A, 0x0012, 0x8008, 0x0000, 0x000A, 0x001E, 0x8007, 0xFE40, 0x000B, 0x0013, 0x8007, 0x0000,
+  0x000B, 0x001E, 0x8007, 0xFE40, 0x000C, 0x0013, 0x8007, 0x0000, 0x000C, 0x001E, 0x8007, 0xFE40, 0x000D, 0x0013, 0x8007, 0x0000,
+  0x000D, 0x001E, 0x8007, 0xFE40, 0x000E, 0x0014, 0x8006, 0x0000, 0x000E, 0x001A, 0x800B, 0xFE40, 0x000F, 0x0015, 0x8005, 0x0000,
+  0x000F, 0x001A, 0x800B, 0xFE40, 0x0010, 0x0018, 0x0003, 0x0000, 0x0000, 0x0000, 0x0010, 0x001B, 0x8009, 0xFE40, 0x0011, 0x001C,
+  0x8007, 0xFE40, 0x0017, 0x0006, 0x001E, 0x0003, 0x0000, 0x0000, 0x0000, 0x0007, 0x001C, 0x8007, 0x0000, 0x0008, 0x001B, 0x8009,
+  0x0000, 0x0009, 0x001A, 0x800B, 0x0000, 0x000A, 0x001A, 0x800B, 0x0000, 0x000B, 0x001A, 0x800B, 0x0000, 0x000C, 0x001A, 0x8007,
+  0x0000, 0x000C, 0x0025, 0x0003, 0xFE40, 0xFE40, 0xFE40, 0x000D, 0x001A, 0x8006, 0x0000, 0x000D, 0x0025, 0x8004, 0xFE40, 0x000E,
+  0x001A, 0x8005, 0x0000, 0x000E, 0x0025, 0x8005, 0xFE40, 0x000F, 0x001A, 0x8005, 0x0000, 0x000F, 0x0025, 0x8005, 0xFE40, 0x0010,
+  0x001B, 0x8004, 0x0000, 0x0010, 0x0024, 0x8007, 0xFE40, 0x0011, 0x001C, 0x0003, 0x0000, 0x0000, 0x0000, 0x0011, 0x0023, 0x8008,
+  0xFE40, 0x0012, 0x001F, 0x800C, 0xFE40, 0x0013, 0x001F, 0x800B, 0xFE40, 0x0014, 0x001F, 0x800B, 0xFE40, 0x0015, 0x0020, 0x8009,
+  0xFE40, 0x0016, 0x0021, 0x8007, 0xFE40,
+};
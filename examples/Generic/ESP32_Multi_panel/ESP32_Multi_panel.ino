@@ -0,0 +1,110 @@
+/*
+
+  Sketch to show how the TFT_eMulti class updates three displays on
+  one SPI bus with DMA, for example three 240 x 240 GC9A01 round
+  displays on an ESP32.
+
+  Example for library:
+  https://github.com/Bodmer/TFT_eSPI
+
+  Each display has a Sprite that is rendered by the CPU while the
+  frames of the other displays are being sent. The frames are sent
+  in chunks taken from each display in turn, so all the displays
+  are updated at the same rate.
+
+  TFT_CS must NOT be defined in the setup file, the chip select pin
+  of each display is given to addPanel(). All displays must be the
+  same type and share the MOSI, SCLK, DC and RST lines.
+
+*/
+
+#include <TFT_eSPI.h>
+
+TFT_eSPI   tft = TFT_eSPI();
+TFT_eMulti multi = TFT_eMulti(&tft);
+
+#define PANELS 3
+
+// Chip select pins of the displays
+const int8_t csPin[PANELS] = { 15, 21, 22 };
+
+// Sprite size, the Sprites are centred on the displays
+#define SPR_W 160
+#define SPR_H 160
+
+TFT_eSprite spr[PANELS] = { TFT_eSprite(&tft), TFT_eSprite(&tft), TFT_eSprite(&tft) };
+uint16_t*   sprPtr[PANELS];
+
+uint32_t frames = 0;
+uint32_t startMillis = 0;
+
+void setup()
+{
+  Serial.begin(115200);
+
+  // Initialise all the displays together
+  for (int i = 0; i < PANELS; i++) {
+    pinMode(csPin[i], OUTPUT);
+    digitalWrite(csPin[i], LOW);
+  }
+
+  tft.init();
+  tft.fillScreen(TFT_BLACK);
+
+  for (int i = 0; i < PANELS; i++) digitalWrite(csPin[i], HIGH);
+
+  tft.initDMA();
+
+  if (!multi.begin()) {
+    Serial.println("SPI device could not be added");
+    while(1) yield();
+  }
+
+  for (int i = 0; i < PANELS; i++) {
+    multi.addPanel(csPin[i]);
+    sprPtr[i] = (uint16_t*)spr[i].createSprite(SPR_W, SPR_H);
+
+    // Frames must be in internal RAM, a Sprite that did not fit is placed in PSRAM
+    if (sprPtr[i] == nullptr || !esp_ptr_dma_capable(sprPtr[i])) {
+      Serial.println("Sprite is not in DMA capable memory");
+      while(1) yield();
+    }
+  }
+
+  startMillis = millis();
+}
+
+void loop()
+{
+  static uint16_t angle = 0;
+
+  for (int p = 0; p < PANELS; p++) {
+    // The Sprite can be drawn when its last frame has been sent
+    if (multi.busy(p)) continue;
+
+    int16_t a = angle + p * 120;
+    int16_t x = SPR_W / 2 + 60 * cos(a * DEG_TO_RAD);
+    int16_t y = SPR_H / 2 + 60 * sin(a * DEG_TO_RAD);
+
+    spr[p].fillSprite(TFT_BLACK);
+    spr[p].drawSmoothCircle(SPR_W / 2, SPR_H / 2, 70, TFT_DARKGREY, TFT_BLACK);
+    spr[p].fillSmoothCircle(x, y, 12, p == 0 ? TFT_RED : p == 1 ? TFT_GREEN : TFT_BLUE, TFT_BLACK);
+
+    // The window is the same for every frame, so only the RAM write command is resent
+    multi.pushFrame(p, (tft.width() - SPR_W) / 2, (tft.height() - SPR_H) / 2, SPR_W, SPR_H, sprPtr[p]);
+
+    if (p == PANELS - 1) {
+      angle += 3;
+      frames++;
+    }
+  }
+
+  // Keep the SPI driver queue full
+  multi.update();
+
+  if (millis() - startMillis >= 5000) {
+    Serial.printf("%0.1f fps per display\n", frames * 1000.0 / (millis() - startMillis));
+    frames = 0;
+    startMillis = millis();
+  }
+}
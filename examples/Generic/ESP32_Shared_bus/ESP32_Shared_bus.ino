@@ -0,0 +1,117 @@
+/*
+
+  Sketch to show how tasks on an ESP32 can share one SPI bus between
+  the TFT, the XPT2046 touch controller and an SD card.
+
+  Example for library:
+  https://github.com/Bodmer/TFT_eSPI
+
+  The loop draws a moving bar graph, a second task polls the touch
+  controller and a third task appends the touch points to a file on
+  the SD card. Each device is used between acquire() and release()
+  calls so transfers from different tasks are never mixed.
+
+  The TFT and touch functions acquire the bus themselves once the
+  arbiter is attached with tft.setBus(). With deferred release the
+  drawing loop keeps the bus between graphics calls until another
+  task asks for it.
+
+  TOUCH_CS and SD card chip select must be set up for the board.
+
+*/
+
+#include <SPI.h>
+#include <FS.h>
+#include <SD.h>
+
+#include <TFT_eSPI.h>
+
+TFT_eSPI tft = TFT_eSPI();
+TFT_eBus bus;
+
+#define SD_CS 5 // SD card chip select pin
+
+QueueHandle_t touchQueue;
+
+typedef struct { uint16_t x, y; } point_t;
+
+// Poll the touch controller every 20ms
+void touchTask(void *param)
+{
+  point_t p;
+
+  while (1) {
+    // getTouch() acquires the bus for BUS_TOUCH
+    if (tft.getTouch(&p.x, &p.y)) xQueueSend(touchQueue, &p, 0);
+    vTaskDelay(pdMS_TO_TICKS(20));
+  }
+}
+
+// Log touch points to the SD card
+void logTask(void *param)
+{
+  point_t p;
+
+  while (1) {
+    xQueueReceive(touchQueue, &p, portMAX_DELAY);
+
+    bus.acquire(BUS_SD);
+    File file = SD.open("/touch.txt", FILE_APPEND);
+    if (file) {
+      file.printf("%u,%u\n", p.x, p.y);
+      file.close();
+    }
+    bus.release(BUS_SD);
+  }
+}
+
+void setup()
+{
+  Serial.begin(115200);
+
+  if (!bus.begin()) {
+    Serial.println("Bus mutex could not be created");
+    while(1) yield();
+  }
+
+  // Keep the bus between graphics calls while no other task needs it
+  bus.setDeferredRelease(true);
+
+  // Touch is read at a higher priority than the drawing loop
+  bus.setPriority(BUS_TOUCH, 3);
+
+  tft.init();
+  tft.setRotation(1);
+  tft.fillScreen(TFT_BLACK);
+  tft.setBus(&bus);
+
+  bus.acquire(BUS_SD);
+  if (!SD.begin(SD_CS, tft.getSPIinstance())) Serial.println("SD card mount failed");
+  bus.release(BUS_SD);
+
+  touchQueue = xQueueCreate(16, sizeof(point_t));
+
+  xTaskCreate(touchTask, "touch", 2048, nullptr, 2, nullptr);
+  xTaskCreate(logTask,   "log",   4096, nullptr, 1, nullptr);
+}
+
+void loop()
+{
+  static uint16_t phase = 0;
+
+  // A batch of graphics calls only locks the bus once
+  bus.acquire(BUS_TFT);
+  for (int i = 0; i < 16; i++) {
+    int h = 40 + 30 * sin((phase + i * 20) * 0.0174533);
+    int x = 10 + i * (tft.width() - 20) / 16;
+    tft.fillRect(x, 0, 12, tft.height() - h, TFT_BLACK);
+    tft.fillRect(x, tft.height() - h, 12, h, TFT_GREEN);
+  }
+  bus.release(BUS_TFT);
+
+  // Let the other tasks in before waiting
+  tft.releaseBus();
+
+  phase += 5;
+  delay(10);
+}
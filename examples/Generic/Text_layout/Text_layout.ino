@@ -0,0 +1,65 @@
+/*
+  Example showing the TFT_eTextLayout class.
+
+  A string is decoded once by layoutString() into a run of glyphs,
+  the run holds the glyph positions and the string width. The run
+  is then drawn by drawLayout() using the text datum and padding
+  settings.
+
+  If the string, font and text size do not change then calling
+  layoutString() again does not decode the string, so a label that
+  is redrawn often only costs the drawing time.
+
+  Example for library:
+  https://github.com/Bodmer/TFT_eSPI
+*/
+
+#include <TFT_eSPI.h>
+
+TFT_eSPI tft = TFT_eSPI();
+
+TFT_eTextLayout label;   // Layout with an allocated glyph buffer
+
+layoutGlyph buffer[16];  // Glyph buffer provided by the sketch
+TFT_eTextLayout value(buffer, 16);
+
+void setup() {
+  Serial.begin(115200);
+
+  tft.init();
+  tft.setRotation(1);
+  tft.fillScreen(TFT_BLACK);
+
+  // Buffer for strings of up to 32 characters
+  label.createLayout(32);
+
+  // Opaque strings are drawn in a Sprite strip and sent to the TFT in one
+  // block, so the value below does not flicker when it changes
+  tft.setTextStrip(true);
+}
+
+void loop() {
+  static uint32_t count = 0;
+
+  tft.setTextColor(TFT_YELLOW, TFT_BLACK);
+  tft.setTextDatum(MC_DATUM);
+  tft.setTextPadding(0);
+
+  // The label is only decoded the first time
+  tft.layoutString(&label, "Centred label", 4);
+  tft.drawLayout(&label, tft.width() / 2, 40);
+
+  // Glyph positions and width are available before drawing
+  tft.drawFastHLine((tft.width() - label.width()) / 2, 40 + label.height() / 2, label.width(), TFT_RED);
+
+  // A changing value, the padding width blanks the old value
+  char str[12];
+  ltoa(count++, str, 10);
+
+  tft.setTextColor(TFT_WHITE, TFT_BLACK);
+  tft.setTextPadding(tft.textWidth("8888888", 7));
+  tft.layoutString(&value, str, 7);
+  tft.drawLayout(&value, tft.width() / 2, tft.height() / 2 + 20);
+
+  delay(100);
+}
@@ -0,0 +1,66 @@
+/*
+  This sketch keeps two Smooth fonts loaded at the same time using TFT_eFont handles.
+
+  Each font is loaded once and moved into a handle with storeFont(). A font is then
+  selected with loadFont(&handle), which does not parse the font or allocate memory,
+  so a screen can mix font sizes without the cost of reloading the fonts.
+
+  The same handle can be used by the TFT and by Sprites.
+*/
+//  The fonts are stored in arrays within the sketch tabs.
+
+//  A processing sketch to create new fonts can be found in the Tools folder of TFT_eSPI
+//  https://github.com/Bodmer/TFT_eSPI/tree/master/Tools/Create_Smooth_Font/Create_font
+
+#include "NotoSansBold15.h"
+#include "NotoSansBold36.h"
+
+#include <SPI.h>
+#include <TFT_eSPI.h>       // Hardware-specific library
+
+TFT_eSPI    tft = TFT_eSPI();
+TFT_eSprite spr = TFT_eSprite(&tft);
+
+TFT_eFont smallFont;
+TFT_eFont largeFont;
+
+void setup(void) {
+  Serial.begin(115200);
+
+  tft.begin();
+  tft.setRotation(1);
+  tft.fillScreen(TFT_BLACK);
+
+  // Load each font once and keep it in a handle
+  tft.loadFont(NotoSansBold15);
+  tft.storeFont(&smallFont);
+
+  tft.loadFont(NotoSansBold36);
+  tft.storeFont(&largeFont);
+
+  spr.createSprite(120, 40);
+}
+
+void loop() {
+  static uint32_t count = 0;
+
+  tft.setTextColor(TFT_WHITE, TFT_BLACK, true);
+
+  tft.loadFont(&smallFont);
+  tft.drawString("Counter", 10, 10);
+
+  tft.loadFont(&largeFont);
+  tft.drawString("Smooth", 10, 40);
+
+  // The Sprite uses the same font data
+  spr.loadFont(&largeFont);
+  spr.fillSprite(TFT_NAVY);
+  spr.setTextColor(TFT_YELLOW, TFT_NAVY);
+  spr.drawNumber(count++, 4, 2);
+  spr.pushSprite(10, 90);
+
+  tft.loadFont(&smallFont);
+  tft.drawString("Two fonts, no reloading", 10, 140);
+
+  delay(100);
+}
@@ -0,0 +1,75 @@
+/*
+
+  Sketch to show how many small images can be kept in one
+  Sprite "atlas" (sometimes called a sprite sheet) and then
+  rendered to the screen or into another Sprite.
+
+  Example for library:
+  https://github.com/Bodmer/TFT_eSPI
+
+  Each Sprite has a memory overhead and each separate heap
+  allocation is rounded up and adds to fragmentation. An atlas
+  uses one Sprite for all the images plus a small table giving
+  the position of each image within the Sprite.
+
+  Images can be drawn into free space in the atlas at runtime
+  (as here) or a complete sprite sheet can be loaded with
+  getSprite()->pushImage() and the positions defined with
+  setEntry() or setEntries().
+
+*/
+
+#include <TFT_eSPI.h>                 // Include the graphics library (this includes the sprite functions)
+
+TFT_eSPI          tft   = TFT_eSPI(); // Declare object "tft"
+
+TFT_eSprite_Atlas atlas(&tft);        // Atlas holding the icons
+
+TFT_eSprite       panel(&tft);        // Sprite the icons are composed into
+
+#define ICONS 8
+int16_t icon[ICONS];                  // Atlas entry index for each icon
+
+void setup()
+{
+  Serial.begin(115200);
+
+  tft.init();
+  tft.fillScreen(TFT_BLACK);
+
+  // 8 bits per pixel halves the RAM needed, a 4 bit palette Sprite halves it again
+  if (atlas.createAtlas(128, 64, ICONS, 8) == nullptr) Serial.println("Atlas not created");
+
+  // Draw icons of different sizes into free space in the atlas
+  TFT_eSprite* sheet = atlas.getSprite();
+  for (uint8_t i = 0; i < ICONS; i++)
+  {
+    int16_t size = 16 + (i & 3) * 4;
+    icon[i] = atlas.reserveEntry(size, size);
+    if (icon[i] < 0) continue;
+
+    atlasRect r;
+    atlas.getEntry(icon[i], &r);
+    // TFT_MAGENTA is used as the transparent colour
+    sheet->fillRect(r.x, r.y, r.w, r.h, TFT_MAGENTA);
+    sheet->fillCircle(r.x + r.w / 2, r.y + r.h / 2, r.w / 2 - 1, TFT_RED + i * 0x0421);
+  }
+
+  panel.createSprite(120, 40);
+}
+
+void loop(void)
+{
+  // Render the icons directly to the screen with a transparent background
+  for (uint8_t i = 0; i < ICONS; i++)
+  {
+    atlas.pushEntry(icon[i], random(tft.width() - 32), random(tft.height() - 32), TFT_MAGENTA);
+  }
+
+  // Compose a row of icons in a Sprite then push it to the screen
+  panel.fillSprite(TFT_DARKGREY);
+  for (uint8_t i = 0; i < 4; i++) atlas.pushEntry(&panel, icon[i], 4 + i * 28, 6, TFT_MAGENTA);
+  panel.pushSprite(0, 0);
+
+  delay(500);
+}
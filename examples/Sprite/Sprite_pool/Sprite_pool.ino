@@ -0,0 +1,73 @@
+/*
+
+  Sketch to show how Sprites can be allocated from a memory pool.
+
+  Example for library:
+  https://github.com/Bodmer/TFT_eSPI
+
+  A user interface that creates and deletes many short lived
+  Sprites each time the screen changes will fragment the heap,
+  eventually createSprite() can fail even though there is enough
+  free RAM in total. A TFT_eSprite_Pool reserves one block of RAM
+  at startup and Sprites bound to the pool take their memory from
+  that block, so the heap is not affected.
+
+  The pool can be reset when a new screen is drawn, this releases
+  all the Sprite memory in one step.
+
+  On an ESP32 with PSRAM the pool can be placed in PSRAM by
+  calling pool.begin(size, true).
+
+*/
+
+#include <TFT_eSPI.h>                 // Include the graphics library (this includes the sprite functions)
+
+TFT_eSPI    tft = TFT_eSPI();         // Declare object "tft"
+
+TFT_eSprite_Pool pool;                // Declare a Sprite memory pool
+
+#define POOL_SIZE  32768              // Bytes reserved for the pool
+#define ICONS 12                      // Number of Sprites created for each screen
+
+void setup()
+{
+  Serial.begin(115200);
+
+  tft.init();
+  tft.fillScreen(TFT_BLACK);
+
+  if (!pool.begin(POOL_SIZE)) Serial.println("Pool memory could not be reserved");
+}
+
+void loop(void)
+{
+  TFT_eSprite spr[ICONS] = {
+    TFT_eSprite(&tft), TFT_eSprite(&tft), TFT_eSprite(&tft), TFT_eSprite(&tft),
+    TFT_eSprite(&tft), TFT_eSprite(&tft), TFT_eSprite(&tft), TFT_eSprite(&tft),
+    TFT_eSprite(&tft), TFT_eSprite(&tft), TFT_eSprite(&tft), TFT_eSprite(&tft)
+  };
+
+  // Start a new screen, all pool memory becomes available again
+  pool.reset();
+  tft.fillScreen(TFT_BLACK);
+
+  for (uint8_t i = 0; i < ICONS; i++)
+  {
+    int16_t size = random(20, 48);
+
+    spr[i].setPool(&pool);         // Must be set before createSprite()
+    if (spr[i].createSprite(size, size) == nullptr) continue;
+
+    spr[i].fillSprite(random(0x10000));
+    spr[i].drawRect(0, 0, size, size, TFT_WHITE);
+    spr[i].pushSprite(random(tft.width() - size), random(tft.height() - size));
+  }
+
+  // Report pool usage
+  poolStats stats = pool.getStats();
+  Serial.printf("Pool used %u of %u bytes, %u Sprites, peak %u, failed %u\n",
+                stats.used, stats.capacity, stats.blocks, stats.peak, stats.fails);
+
+  // Sprites are deleted when they go out of scope
+  delay(1000);
+}
@@ -0,0 +1,71 @@
+/*
+
+  Sketch to show how a screen size Sprite can be split into
+  independently drawn panels using Sprite views.
+
+  Example for library:
+  https://github.com/Bodmer/TFT_eSPI
+
+  A view is a Sprite that uses a rectangular area of another
+  Sprite's memory. No extra RAM is needed and nothing is copied,
+  the graphics drawn in a view appear in the full size Sprite.
+  Each view has its own coordinates, clipping, cursor and text
+  settings so panel drawing code does not need to know where the
+  panel is on the screen.
+
+*/
+
+#include <TFT_eSPI.h>                 // Include the graphics library (this includes the sprite functions)
+
+TFT_eSPI    tft    = TFT_eSPI();      // Declare object "tft"
+
+TFT_eSprite screen = TFT_eSprite(&tft); // Full screen frame buffer
+
+TFT_eSprite header = TFT_eSprite(&tft); // Views of areas of the frame buffer
+TFT_eSprite graph  = TFT_eSprite(&tft);
+TFT_eSprite status = TFT_eSprite(&tft);
+
+void setup()
+{
+  Serial.begin(115200);
+
+  tft.init();
+  tft.setRotation(1);
+
+  // 8 bit colour is used so a 320 x 240 frame buffer fits in RAM
+  screen.setColorDepth(8);
+  if (screen.createSprite(tft.width(), tft.height()) == nullptr)
+  {
+    Serial.println("Not enough RAM for frame buffer");
+    while(1) delay(1000);
+  }
+
+  int16_t w = screen.width();
+  int16_t h = screen.height();
+
+  header.createView(&screen, 0,  0, w, 30);
+  graph.createView (&screen, 0, 30, w, h - 60);
+  status.createView(&screen, 0, h - 30, w, 30);
+}
+
+void loop(void)
+{
+  static uint32_t count = 0;
+
+  header.fillSprite(TFT_NAVY);
+  header.setTextColor(TFT_WHITE);
+  header.drawString("Sprite views", 4, 4, 4);
+
+  // Lines drawn outside the graph panel are clipped to the panel
+  graph.fillSprite(TFT_BLACK);
+  for (int i = 0; i < 20; i++)
+    graph.drawLine(random(-50, graph.width() + 50), random(-50, graph.height() + 50),
+                   random(-50, graph.width() + 50), random(-50, graph.height() + 50), random(0x10000));
+
+  status.fillSprite(TFT_DARKGREY);
+  status.setTextColor(TFT_YELLOW);
+  status.drawNumber(count++, 4, 4, 4);
+
+  // One push updates the whole screen
+  screen.pushSprite(0, 0);
+}
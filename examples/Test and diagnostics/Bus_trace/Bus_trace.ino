@@ -0,0 +1,90 @@
+/*
+
+  Sketch to record the commands and pixel data sent to the TFT, so the
+  drawing code can be analysed on a PC with Tools/Trace_analyzer.
+
+  Example for library:
+  https://github.com/Bodmer/TFT_eSPI
+
+  TFT_TRACE must be defined in the setup file.
+
+  Ten frames of a simple display update are recorded to a file in
+  SPIFFS. The file is then sent to the serial port as hex, paste the
+  hex into a file and convert it back to binary on the PC, e.g.:
+
+    xxd -r -p capture.hex capture.trc
+    python trace_analyze.py -f capture.trc
+
+*/
+
+#include <FS.h>
+#ifdef ESP32
+  #include <SPIFFS.h>
+#endif
+
+#include <TFT_eSPI.h>
+
+#ifndef TFT_TRACE
+  #error "TFT_TRACE must be defined in the setup file"
+#endif
+
+TFT_eSPI   tft = TFT_eSPI();
+TFT_eTrace trace(&tft);
+
+#define FRAMES 10
+
+void drawFrame(int n)
+{
+  // A typical clear and redraw update
+  tft.fillRect(0, 0, tft.width(), 40, TFT_NAVY);
+  tft.setTextColor(TFT_WHITE, TFT_NAVY);
+  tft.drawString("Frame " + String(n), 10, 10, 4);
+
+  tft.fillRect(0, 40, tft.width(), 100, TFT_BLACK);
+  tft.fillRect(10, 50, n * (tft.width() - 20) / FRAMES, 20, TFT_GREEN);
+  for (int i = 0; i < 20; i++) tft.drawPixel(10 + i * 5, 90, TFT_YELLOW);
+}
+
+void setup()
+{
+  Serial.begin(115200);
+
+  if (!SPIFFS.begin(true)) {
+    Serial.println("SPIFFS could not be mounted");
+    while(1) yield();
+  }
+
+  tft.init();
+  tft.fillScreen(TFT_BLACK);
+
+  File file = SPIFFS.open("/capture.trc", "w");
+
+  // A 2 kbyte buffer is written to the file when full or at the end of a frame
+  if (!trace.begin(file, 2048)) {
+    Serial.println("Trace buffer could not be allocated");
+    while(1) yield();
+  }
+
+  for (int n = 1; n <= FRAMES; n++) {
+    drawFrame(n);
+    trace.frame();
+  }
+
+  Serial.printf("Trace is %u bytes\n", trace.size());
+  trace.end();
+  file.close();
+
+  // Send the trace as hex
+  file = SPIFFS.open("/capture.trc", "r");
+  int count = 0;
+  while (file.available()) {
+    Serial.printf("%02X", file.read());
+    if (++count % 32 == 0) Serial.println();
+  }
+  Serial.println();
+  file.close();
+}
+
+void loop()
+{
+}
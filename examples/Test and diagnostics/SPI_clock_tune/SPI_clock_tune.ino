@@ -0,0 +1,66 @@
+/*
+
+  Sketch to find the fastest reliable SPI clocks for a display and
+  keep the result in non-volatile memory (ESP32 Preferences).
+
+  Example for library:
+  https://github.com/Bodmer/TFT_eSPI
+
+  The clocks are tuned at the first boot, later boots load the saved
+  clocks. Ground the TUNE_PIN at boot to tune again. TFT_MISO must be
+  connected so the test patterns can be read back.
+
+*/
+
+#include <Preferences.h>
+#include <TFT_eSPI.h>
+
+TFT_eSPI    tft = TFT_eSPI();
+Preferences prefs;
+
+#define TUNE_PIN 0 // Boot button on many boards
+
+void setup()
+{
+  Serial.begin(115200);
+  pinMode(TUNE_PIN, INPUT_PULLUP);
+
+  tft.init();
+
+  prefs.begin("tft", false);
+
+  uint32_t writeFreq = prefs.getUInt("write", 0);
+  uint32_t readFreq  = prefs.getUInt("read", 0);
+
+  if (writeFreq == 0 || digitalRead(TUNE_PIN) == LOW) {
+    Serial.println("Tuning SPI clocks...");
+
+    // Stop at 80MHz and keep a 20% margin
+    if (tft.tuneSPIFrequency(80000000, 20)) {
+      prefs.putUInt("write", tft.getSPIWriteFrequency());
+      prefs.putUInt("read",  tft.getSPIReadFrequency());
+    }
+    else Serial.println("Pixels could not be read back, check TFT_MISO");
+  }
+  else tft.setSPIFrequency(writeFreq, readFreq);
+
+  prefs.end();
+
+  Serial.printf("Write clock %u Hz, read clock %u Hz\n", tft.getSPIWriteFrequency(), tft.getSPIReadFrequency());
+
+  tft.fillScreen(TFT_BLACK);
+  tft.setTextColor(TFT_WHITE, TFT_BLACK);
+  tft.drawString("Write " + String(tft.getSPIWriteFrequency() / 1000000.0, 1) + " MHz", 10, 10, 4);
+  tft.drawString("Read  " + String(tft.getSPIReadFrequency()  / 1000000.0, 1) + " MHz", 10, 40, 4);
+}
+
+void loop()
+{
+  // Time a full screen fill at the tuned clock
+  uint32_t t = micros();
+  tft.fillRect(0, 100, tft.width(), tft.height() - 100, random(0x10000));
+  t = micros() - t;
+
+  tft.drawString(String(t) + " us fill   ", 10, 70, 2);
+  delay(500);
+}